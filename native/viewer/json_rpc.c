@@ -132,6 +132,7 @@ char *rpc_cmd_load_scene(arena_t *tmp, jsi_obj *args)
 	ufbx_load_opts opts = {
 		.target_axes = ufbx_axes_right_handed_y_up,
 		.target_unit_meters = 1.0f,
+		.thread_opts.num_threads = SIZE_MAX,
 	};
 	ufbx_error error;
 	ufbx_scene *fbx_scene = ufbx_load_memory(data, size, &opts, &error);
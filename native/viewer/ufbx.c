@@ -1,6 +1,12 @@
 #ifndef UFBX_UFBX_C_INCLUDED
 #define UFBX_UFBX_C_INCLUDED
 
+// Strict standard modes (eg. `-std=c99`) hide the POSIX interfaces used for memory
+// mapping, clocks and directory listing, request them before any system header.
+#if !defined(UFBX_STANDARD_C) && !defined(_POSIX_C_SOURCE) && defined(__STRICT_ANSI__) && defined(__unix__) && !defined(__APPLE__)
+	#define _POSIX_C_SOURCE 200809L
+#endif
+
 #if defined(UFBX_HEADER_PATH)
 	#include UFBX_HEADER_PATH
 #else
@@ -21,6 +27,11 @@
 //   UFBX_LITTLE_ENDIAN=0/1    Explicitly define little/big endian architecture
 //   UFBX_PATH_SEPARATOR=''    Specify default platform path separator
 //   UFBX_NO_SSE               Do not try to include SSE
+//   UFBX_NO_PTHREADS          Do not use POSIX threads for `ufbx_thread_opts.num_threads`
+//   UFBX_USE_PTHREADS         Forcibly enable the built-in POSIX thread pool
+//   UFBX_NO_MMAP              Do not use `mmap()` for `ufbx_load_opts.map_main_file`
+//   UFBX_NO_CLOCK             Do not use `clock_gettime()` for `ufbx_load_opts.collect_load_stats`
+//   UFBX_NO_DIRENT            Do not use `<dirent.h>` to evict entries from `ufbx_load_opts.cache_dir`
 
 // Dependencies:
 //   UFBX_NO_MALLOC              Disable default malloc/realloc/free
@@ -52,14 +63,24 @@
 #define UFBXI_MAX_NODE_DEPTH 32
 #define UFBXI_MAX_XML_DEPTH 32
 #define UFBXI_MAX_SKIP_SIZE 0x40000000
-#define UFBXI_MAP_MAX_SCAN 32
+#define UFBXI_MAP_MAX_SCAN 4
+#define UFBXI_LAZY_STREAM_BATCH_BYTES 0x1000000
 #define UFBXI_KD_FAST_DEPTH 6
 #define UFBXI_HUGE_MAX_SCAN 16
 #define UFBXI_MIN_FILE_FORMAT_LOOKAHEAD 32
 #define UFBXI_FACE_GROUP_HASH_BITS 8
 #define UFBXI_MIN_THREADED_DEFLATE_BYTES 256
 #define UFBXI_MIN_THREADED_ASCII_VALUES 64
+#define UFBXI_ASCII_ARRAY_TASK_VALUES 32768
+#define UFBXI_OBJ_VERTEX_TASK_LINES 4096
+#define UFBXI_CONNECTION_TASK_SIZE 16384
+#define UFBXI_MIN_RADIX_SORT_SIZE 256
+#define UFBXI_FINALIZE_TASK_WORK 65536
+#define UFBXI_FINALIZE_ITEM_WORK 1024
+#define UFBXI_FINALIZE_TOPO_BATCH 0x100000
 #define UFBXI_GEOMETRY_CACHE_BUFFER_SIZE 512
+#define UFBXI_CACHE_READER_CHANNELS 16
+#define UFBXI_MAX_POOL_THREADS 256
 
 #ifndef UFBXI_MAX_NURBS_ORDER
 #define UFBXI_MAX_NURBS_ORDER 128
@@ -216,6 +237,11 @@
 	#if !defined(UFBX_NO_MALLOC) && !defined(UFBX_EXTERNAL_MALLOC)
 		#include <stdlib.h>
 	#endif
+	#if !defined(UFBX_NO_PTHREADS) && !defined(UFBX_USE_PTHREADS) && !defined(UFBX_STANDARD_C)
+		#if (defined(__unix__) || defined(__APPLE__)) && (!defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__))
+			#define UFBX_USE_PTHREADS
+		#endif
+	#endif
 #else
 	#if !defined(UFBX_EXTERNAL_MATH) && !defined(UFBX_NO_EXTERNAL_MATH)
 		#define UFBX_EXTERNAL_MATH
@@ -231,6 +257,50 @@
 	#endif
 #endif
 
+#if defined(UFBX_USE_PTHREADS) && !defined(UFBX_NO_PTHREADS)
+	#define UFBXI_HAS_PTHREADS 1
+	#include <pthread.h>
+	#include <unistd.h>
+#else
+	#define UFBXI_HAS_PTHREADS 0
+#endif
+
+#if !defined(UFBX_NO_MMAP) && !defined(UFBX_STANDARD_C) && !defined(UFBX_NO_LIBC) && !defined(UFBX_NO_STDIO) && !defined(UFBX_EXTERNAL_STDIO)
+	#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__) && (defined(__APPLE__) || (defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L))
+		#define UFBXI_HAS_MMAP 1
+		#include <sys/mman.h>
+		#include <sys/stat.h>
+		#include <fcntl.h>
+		#include <unistd.h>
+	#endif
+#endif
+#if !defined(UFBXI_HAS_MMAP)
+	#define UFBXI_HAS_MMAP 0
+#endif
+
+#if !defined(UFBX_NO_CLOCK) && !defined(UFBX_STANDARD_C) && !defined(UFBX_NO_LIBC)
+	#if (defined(__unix__) || defined(__APPLE__)) && (defined(__APPLE__) || (defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 199309L))
+		#define UFBXI_HAS_CLOCK 1
+		#include <time.h>
+	#endif
+#endif
+#if !defined(UFBXI_HAS_CLOCK)
+	#define UFBXI_HAS_CLOCK 0
+#endif
+
+#if !defined(UFBX_NO_DIRENT) && !defined(UFBX_STANDARD_C) && !defined(UFBX_NO_LIBC) && !defined(UFBX_NO_STDIO) && !defined(UFBX_EXTERNAL_STDIO)
+	#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__) && (defined(__APPLE__) || (defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200112L))
+		#define UFBXI_HAS_DIRENT 1
+		#include <dirent.h>
+		#include <sys/stat.h>
+		#include <unistd.h>
+		#include <utime.h>
+	#endif
+#endif
+#if !defined(UFBXI_HAS_DIRENT)
+	#define UFBXI_HAS_DIRENT 0
+#endif
+
 #if defined(UFBX_EXTERNAL_STRING) && !defined(UFBX_STRING_PREFIX)
 	#define UFBX_STRING_PREFIX ufbx_
 #endif
@@ -894,6 +964,16 @@ ufbx_static_assert(source_header_version, UFBX_SOURCE_VERSION/1000u == UFBX_HEAD
 	#define ufbxi_copy_16_bytes(dst, src) memcpy((dst), (src), 16)
 #endif
 
+#if defined(UFBXI_HAS_UNALIGNED)
+	#define ufbxi_copy_8_bytes(dst, src) do { \
+		ufbxi_unaligned ufbxi_unaligned_u64 *mi_dst = (ufbxi_unaligned ufbxi_unaligned_u64 *)(dst); \
+		const ufbxi_unaligned ufbxi_unaligned_u64 *mi_src = (const ufbxi_unaligned ufbxi_unaligned_u64 *)src; \
+		mi_dst[0] = mi_src[0]; \
+	} while (0)
+#else
+	#define ufbxi_copy_8_bytes(dst, src) memcpy((dst), (src), 8)
+#endif
+
 
 // -- Large fast integer
 
@@ -966,6 +1046,35 @@ ufbx_static_assert(source_header_version, UFBX_SOURCE_VERSION/1000u == UFBX_HEAD
 	}
 #endif
 
+// -- Wide multiplication
+
+#if !defined(UFBX_STANDARD_C) && defined(_MSC_VER) && defined(_M_X64)
+	ufbxi_extern_c unsigned __int64 _umul128(unsigned __int64 _Multiplier, unsigned __int64 _Multiplicand, unsigned __int64 *_HighProduct);
+	static ufbxi_forceinline ufbxi_unused uint64_t ufbxi_mul64_wide(uint64_t a, uint64_t b, uint64_t *p_hi) {
+		unsigned __int64 hi;
+		uint64_t lo = (uint64_t)_umul128((unsigned __int64)a, (unsigned __int64)b, &hi);
+		*p_hi = (uint64_t)hi;
+		return lo;
+	}
+#elif !defined(UFBX_STANDARD_C) && (defined(__GNUC__) || defined(__clang__)) && defined(__SIZEOF_INT128__)
+	__extension__ typedef unsigned __int128 ufbxi_uint128;
+	static ufbxi_forceinline ufbxi_unused uint64_t ufbxi_mul64_wide(uint64_t a, uint64_t b, uint64_t *p_hi) {
+		ufbxi_uint128 r = (ufbxi_uint128)a * (ufbxi_uint128)b;
+		*p_hi = (uint64_t)(r >> 64u);
+		return (uint64_t)r;
+	}
+#else
+	static ufbxi_noinline ufbxi_unused uint64_t ufbxi_mul64_wide(uint64_t a, uint64_t b, uint64_t *p_hi) {
+		uint64_t a_lo = (uint32_t)a, a_hi = a >> 32u;
+		uint64_t b_lo = (uint32_t)b, b_hi = b >> 32u;
+		uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi;
+		uint64_t hl = a_hi * b_lo, hh = a_hi * b_hi;
+		uint64_t mid = (ll >> 32u) + (uint32_t)lh + (uint32_t)hl;
+		*p_hi = hh + (lh >> 32u) + (hl >> 32u) + (mid >> 32u);
+		return (mid << 32u) | (uint32_t)ll;
+	}
+#endif
+
 // -- Bit conversion
 
 #if defined(__cplusplus)
@@ -1002,13 +1111,19 @@ ufbx_static_assert(source_header_version, UFBX_SOURCE_VERSION/1000u == UFBX_HEAD
 	#define UFBXI_MAX_SKIP_SIZE 128
 
 	#undef UFBXI_MAP_MAX_SCAN
-	#define UFBXI_MAP_MAX_SCAN 2
+	#define UFBXI_MAP_MAX_SCAN 1
+
+	#undef UFBXI_LAZY_STREAM_BATCH_BYTES
+	#define UFBXI_LAZY_STREAM_BATCH_BYTES 1024
 
 	#undef UFBXI_KD_FAST_DEPTH
 	#define UFBXI_KD_FAST_DEPTH 2
 
 	#undef UFBXI_FACE_GROUP_HASH_BITS
 	#define UFBXI_FACE_GROUP_HASH_BITS 2
+
+	#undef UFBXI_MIN_RADIX_SORT_SIZE
+	#define UFBXI_MIN_RADIX_SORT_SIZE 2
 #endif
 
 #if defined(UFBX_REGRESSION) || defined(UFBX_EXTENSIVE_THREADING)
@@ -1017,6 +1132,21 @@ ufbx_static_assert(source_header_version, UFBX_SOURCE_VERSION/1000u == UFBX_HEAD
 
 	#undef UFBXI_MIN_THREADED_ASCII_VALUES
 	#define UFBXI_MIN_THREADED_ASCII_VALUES 2
+
+	#undef UFBXI_ASCII_ARRAY_TASK_VALUES
+	#define UFBXI_ASCII_ARRAY_TASK_VALUES 4
+
+	#undef UFBXI_OBJ_VERTEX_TASK_LINES
+	#define UFBXI_OBJ_VERTEX_TASK_LINES 2
+
+	#undef UFBXI_CONNECTION_TASK_SIZE
+	#define UFBXI_CONNECTION_TASK_SIZE 4
+
+	#undef UFBXI_FINALIZE_TASK_WORK
+	#define UFBXI_FINALIZE_TASK_WORK 4
+
+	#undef UFBXI_FINALIZE_TOPO_BATCH
+	#define UFBXI_FINALIZE_TOPO_BATCH 16
 #endif
 
 #if defined(UFBX_REGRESSION)
@@ -1290,6 +1420,55 @@ static ufbxi_noinline void ufbxi_stable_sort(size_t stride, size_t linear_size,
 	if (dst != data) memcpy((void*)data, dst, size * stride);
 }
 
+// Key and index pair for `ufbxi_radix_sort_u64()`, the index is usually used to
+// permute the actual data after sorting.
+typedef struct {
+	uint64_t key;
+	uint32_t index;
+} ufbxi_radix_u64;
+
+// Stable LSD radix sort of `data[size]` by `key` 8 bits at a time.
+// Histograms for all the digits are gathered in a single pass and digits that are
+// equal for all the keys are skipped, so eg. 32-bit element IDs shifted to the top
+// of the key only take as many passes as the IDs need.
+// `tmp` must be a memory buffer with at least the same size as `data`
+static ufbxi_noinline void ufbxi_radix_sort_u64(ufbxi_radix_u64 *data, ufbxi_radix_u64 *tmp, size_t size)
+{
+	if (size <= 1) return;
+
+	size_t counts[8][256];
+	memset(counts, 0, sizeof(counts));
+
+	ufbxi_radix_u64 *src = data, *dst = tmp;
+	for (size_t i = 0; i < size; i++) {
+		uint64_t key = src[i].key;
+		for (uint32_t d = 0; d < 8; d++) {
+			counts[d][(key >> (d * 8u)) & 0xff]++;
+		}
+	}
+
+	for (uint32_t d = 0; d < 8; d++) {
+		size_t *count = counts[d];
+		uint32_t shift = d * 8u;
+		if (count[(src[0].key >> shift) & 0xff] == size) continue;
+
+		size_t offset = 0;
+		for (size_t i = 0; i < 256; i++) {
+			size_t num = count[i];
+			count[i] = offset;
+			offset += num;
+		}
+
+		for (size_t i = 0; i < size; i++) {
+			dst[count[(src[i].key >> shift) & 0xff]++] = src[i];
+		}
+
+		ufbxi_radix_u64 *swap = src; src = dst; dst = swap;
+	}
+
+	if (src != data) memcpy(data, src, size * sizeof(ufbxi_radix_u64));
+}
+
 static ufbxi_forceinline void ufbxi_swap(void *a, void *b, size_t size)
 {
 #if UFBXI_HAS_ALIASING && !defined(__CHERI__) // CHERI needs to copy pointer metadata tag bits..
@@ -1379,6 +1558,79 @@ static const double ufbxi_pow10_tab_f64[] = {
 	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
 };
 
+#define UFBXI_POW5_128_MIN_EXP -64
+#define UFBXI_POW5_128_MAX_EXP 64
+
+// 5^q for `q` in `[UFBXI_POW5_128_MIN_EXP, UFBXI_POW5_128_MAX_EXP]` normalized so that the top bit
+// is set and truncated to 128 bits, stored as `{ hi, lo }` pairs. Negative powers are rounded up.
+static const uint64_t ufbxi_pow5_128_tab[] = {
+	UINT64_C(0xa87fea27a539e9a5), UINT64_C(0x3f2398d747b36224), UINT64_C(0xd29fe4b18e88640e), UINT64_C(0x8eec7f0d19a03aad),
+	UINT64_C(0x83a3eeeef9153e89), UINT64_C(0x1953cf68300424ac), UINT64_C(0xa48ceaaab75a8e2b), UINT64_C(0x5fa8c3423c052dd7),
+	UINT64_C(0xcdb02555653131b6), UINT64_C(0x3792f412cb06794d), UINT64_C(0x808e17555f3ebf11), UINT64_C(0xe2bbd88bbee40bd0),
+	UINT64_C(0xa0b19d2ab70e6ed6), UINT64_C(0x5b6aceaeae9d0ec4), UINT64_C(0xc8de047564d20a8b), UINT64_C(0xf245825a5a445275),
+	UINT64_C(0xfb158592be068d2e), UINT64_C(0xeed6e2f0f0d56712), UINT64_C(0x9ced737bb6c4183d), UINT64_C(0x55464dd69685606b),
+	UINT64_C(0xc428d05aa4751e4c), UINT64_C(0xaa97e14c3c26b886), UINT64_C(0xf53304714d9265df), UINT64_C(0xd53dd99f4b3066a8),
+	UINT64_C(0x993fe2c6d07b7fab), UINT64_C(0xe546a8038efe4029), UINT64_C(0xbf8fdb78849a5f96), UINT64_C(0xde98520472bdd033),
+	UINT64_C(0xef73d256a5c0f77c), UINT64_C(0x963e66858f6d4440), UINT64_C(0x95a8637627989aad), UINT64_C(0xdde7001379a44aa8),
+	UINT64_C(0xbb127c53b17ec159), UINT64_C(0x5560c018580d5d52), UINT64_C(0xe9d71b689dde71af), UINT64_C(0xaab8f01e6e10b4a6),
+	UINT64_C(0x9226712162ab070d), UINT64_C(0xcab3961304ca70e8), UINT64_C(0xb6b00d69bb55c8d1), UINT64_C(0x3d607b97c5fd0d22),
+	UINT64_C(0xe45c10c42a2b3b05), UINT64_C(0x8cb89a7db77c506a), UINT64_C(0x8eb98a7a9a5b04e3), UINT64_C(0x77f3608e92adb242),
+	UINT64_C(0xb267ed1940f1c61c), UINT64_C(0x55f038b237591ed3), UINT64_C(0xdf01e85f912e37a3), UINT64_C(0x6b6c46dec52f6688),
+	UINT64_C(0x8b61313bbabce2c6), UINT64_C(0x2323ac4b3b3da015), UINT64_C(0xae397d8aa96c1b77), UINT64_C(0xabec975e0a0d081a),
+	UINT64_C(0xd9c7dced53c72255), UINT64_C(0x96e7bd358c904a21), UINT64_C(0x881cea14545c7575), UINT64_C(0x7e50d64177da2e54),
+	UINT64_C(0xaa242499697392d2), UINT64_C(0xdde50bd1d5d0b9e9), UINT64_C(0xd4ad2dbfc3d07787), UINT64_C(0x955e4ec64b44e864),
+	UINT64_C(0x84ec3c97da624ab4), UINT64_C(0xbd5af13bef0b113e), UINT64_C(0xa6274bbdd0fadd61), UINT64_C(0xecb1ad8aeacdd58e),
+	UINT64_C(0xcfb11ead453994ba), UINT64_C(0x67de18eda5814af2), UINT64_C(0x81ceb32c4b43fcf4), UINT64_C(0x80eacf948770ced7),
+	UINT64_C(0xa2425ff75e14fc31), UINT64_C(0xa1258379a94d028d), UINT64_C(0xcad2f7f5359a3b3e), UINT64_C(0x096ee45813a04330),
+	UINT64_C(0xfd87b5f28300ca0d), UINT64_C(0x8bca9d6e188853fc), UINT64_C(0x9e74d1b791e07e48), UINT64_C(0x775ea264cf55347e),
+	UINT64_C(0xc612062576589dda), UINT64_C(0x95364afe032a819e), UINT64_C(0xf79687aed3eec551), UINT64_C(0x3a83ddbd83f52205),
+	UINT64_C(0x9abe14cd44753b52), UINT64_C(0xc4926a9672793543), UINT64_C(0xc16d9a0095928a27), UINT64_C(0x75b7053c0f178294),
+	UINT64_C(0xf1c90080baf72cb1), UINT64_C(0x5324c68b12dd6339), UINT64_C(0x971da05074da7bee), UINT64_C(0xd3f6fc16ebca5e04),
+	UINT64_C(0xbce5086492111aea), UINT64_C(0x88f4bb1ca6bcf585), UINT64_C(0xec1e4a7db69561a5), UINT64_C(0x2b31e9e3d06c32e6),
+	UINT64_C(0x9392ee8e921d5d07), UINT64_C(0x3aff322e62439fd0), UINT64_C(0xb877aa3236a4b449), UINT64_C(0x09befeb9fad487c3),
+	UINT64_C(0xe69594bec44de15b), UINT64_C(0x4c2ebe687989a9b4), UINT64_C(0x901d7cf73ab0acd9), UINT64_C(0x0f9d37014bf60a11),
+	UINT64_C(0xb424dc35095cd80f), UINT64_C(0x538484c19ef38c95), UINT64_C(0xe12e13424bb40e13), UINT64_C(0x2865a5f206b06fba),
+	UINT64_C(0x8cbccc096f5088cb), UINT64_C(0xf93f87b7442e45d4), UINT64_C(0xafebff0bcb24aafe), UINT64_C(0xf78f69a51539d749),
+	UINT64_C(0xdbe6fecebdedd5be), UINT64_C(0xb573440e5a884d1c), UINT64_C(0x89705f4136b4a597), UINT64_C(0x31680a88f8953031),
+	UINT64_C(0xabcc77118461cefc), UINT64_C(0xfdc20d2b36ba7c3e), UINT64_C(0xd6bf94d5e57a42bc), UINT64_C(0x3d32907604691b4d),
+	UINT64_C(0x8637bd05af6c69b5), UINT64_C(0xa63f9a49c2c1b110), UINT64_C(0xa7c5ac471b478423), UINT64_C(0x0fcf80dc33721d54),
+	UINT64_C(0xd1b71758e219652b), UINT64_C(0xd3c36113404ea4a9), UINT64_C(0x83126e978d4fdf3b), UINT64_C(0x645a1cac083126ea),
+	UINT64_C(0xa3d70a3d70a3d70a), UINT64_C(0x3d70a3d70a3d70a4), UINT64_C(0xcccccccccccccccc), UINT64_C(0xcccccccccccccccd),
+	UINT64_C(0x8000000000000000), UINT64_C(0x0000000000000000), UINT64_C(0xa000000000000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xc800000000000000), UINT64_C(0x0000000000000000), UINT64_C(0xfa00000000000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0x9c40000000000000), UINT64_C(0x0000000000000000), UINT64_C(0xc350000000000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xf424000000000000), UINT64_C(0x0000000000000000), UINT64_C(0x9896800000000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xbebc200000000000), UINT64_C(0x0000000000000000), UINT64_C(0xee6b280000000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0x9502f90000000000), UINT64_C(0x0000000000000000), UINT64_C(0xba43b74000000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xe8d4a51000000000), UINT64_C(0x0000000000000000), UINT64_C(0x9184e72a00000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xb5e620f480000000), UINT64_C(0x0000000000000000), UINT64_C(0xe35fa931a0000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0x8e1bc9bf04000000), UINT64_C(0x0000000000000000), UINT64_C(0xb1a2bc2ec5000000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xde0b6b3a76400000), UINT64_C(0x0000000000000000), UINT64_C(0x8ac7230489e80000), UINT64_C(0x0000000000000000),
+	UINT64_C(0xad78ebc5ac620000), UINT64_C(0x0000000000000000), UINT64_C(0xd8d726b7177a8000), UINT64_C(0x0000000000000000),
+	UINT64_C(0x878678326eac9000), UINT64_C(0x0000000000000000), UINT64_C(0xa968163f0a57b400), UINT64_C(0x0000000000000000),
+	UINT64_C(0xd3c21bcecceda100), UINT64_C(0x0000000000000000), UINT64_C(0x84595161401484a0), UINT64_C(0x0000000000000000),
+	UINT64_C(0xa56fa5b99019a5c8), UINT64_C(0x0000000000000000), UINT64_C(0xcecb8f27f4200f3a), UINT64_C(0x0000000000000000),
+	UINT64_C(0x813f3978f8940984), UINT64_C(0x4000000000000000), UINT64_C(0xa18f07d736b90be5), UINT64_C(0x5000000000000000),
+	UINT64_C(0xc9f2c9cd04674ede), UINT64_C(0xa400000000000000), UINT64_C(0xfc6f7c4045812296), UINT64_C(0x4d00000000000000),
+	UINT64_C(0x9dc5ada82b70b59d), UINT64_C(0xf020000000000000), UINT64_C(0xc5371912364ce305), UINT64_C(0x6c28000000000000),
+	UINT64_C(0xf684df56c3e01bc6), UINT64_C(0xc732000000000000), UINT64_C(0x9a130b963a6c115c), UINT64_C(0x3c7f400000000000),
+	UINT64_C(0xc097ce7bc90715b3), UINT64_C(0x4b9f100000000000), UINT64_C(0xf0bdc21abb48db20), UINT64_C(0x1e86d40000000000),
+	UINT64_C(0x96769950b50d88f4), UINT64_C(0x1314448000000000), UINT64_C(0xbc143fa4e250eb31), UINT64_C(0x17d955a000000000),
+	UINT64_C(0xeb194f8e1ae525fd), UINT64_C(0x5dcfab0800000000), UINT64_C(0x92efd1b8d0cf37be), UINT64_C(0x5aa1cae500000000),
+	UINT64_C(0xb7abc627050305ad), UINT64_C(0xf14a3d9e40000000), UINT64_C(0xe596b7b0c643c719), UINT64_C(0x6d9ccd05d0000000),
+	UINT64_C(0x8f7e32ce7bea5c6f), UINT64_C(0xe4820023a2000000), UINT64_C(0xb35dbf821ae4f38b), UINT64_C(0xdda2802c8a800000),
+	UINT64_C(0xe0352f62a19e306e), UINT64_C(0xd50b2037ad200000), UINT64_C(0x8c213d9da502de45), UINT64_C(0x4526f422cc340000),
+	UINT64_C(0xaf298d050e4395d6), UINT64_C(0x9670b12b7f410000), UINT64_C(0xdaf3f04651d47b4c), UINT64_C(0x3c0cdd765f114000),
+	UINT64_C(0x88d8762bf324cd0f), UINT64_C(0xa5880a69fb6ac800), UINT64_C(0xab0e93b6efee0053), UINT64_C(0x8eea0d047a457a00),
+	UINT64_C(0xd5d238a4abe98068), UINT64_C(0x72a4904598d6d880), UINT64_C(0x85a36366eb71f041), UINT64_C(0x47a6da2b7f864750),
+	UINT64_C(0xa70c3c40a64e6c51), UINT64_C(0x999090b65f67d924), UINT64_C(0xd0cf4b50cfe20765), UINT64_C(0xfff4b4e3f741cf6d),
+	UINT64_C(0x82818f1281ed449f), UINT64_C(0xbff8f10e7a8921a4), UINT64_C(0xa321f2d7226895c7), UINT64_C(0xaff72d52192b6a0d),
+	UINT64_C(0xcbea6f8ceb02bb39), UINT64_C(0x9bf4f8a69f764490), UINT64_C(0xfee50b7025c36a08), UINT64_C(0x02f236d04753d5b4),
+	UINT64_C(0x9f4f2726179a2245), UINT64_C(0x01d762422c946590), UINT64_C(0xc722f0ef9d80aad6), UINT64_C(0x424d3ad2b7b97ef5),
+	UINT64_C(0xf8ebad2b84e0d58b), UINT64_C(0xd2e0898765a7deb2), UINT64_C(0x9b934c3b330c8577), UINT64_C(0x63cc55f49f88eb2f),
+	UINT64_C(0xc2781f49ffcfa6d5), UINT64_C(0x3cbf6b71c76b25fb),
+};
+
 static ufbxi_noinline void ufbxi_bigint_mad(ufbxi_bigint *bigint, ufbxi_bigint_accum multiplicand, ufbxi_bigint_accum addend)
 {
 	ufbxi_dev_assert((multiplicand | addend) >> (UFBXI_BIGINT_ACCUM_BITS - 1) == 0);
@@ -1598,6 +1850,63 @@ static ufbxi_noinline bool ufbxi_parse_inf_nan(double *p_result, const char *str
 	return true;
 }
 
+// Eisel-Lemire: Compute the correctly rounded bits of `digits * 10^dec_exponent` using a 128-bit
+// approximation of the power of five. Returns `false` if the result is out of the range of the
+// table, subnormal or infinite, in which case the caller needs to fall back to the bigint path.
+static ufbxi_forceinline bool ufbxi_parse_double_eisel_lemire(uint64_t *p_bits, uint64_t digits, int32_t dec_exponent, uint32_t flags)
+{
+	if (digits == 0 || dec_exponent < UFBXI_POW5_128_MIN_EXP || dec_exponent > UFBXI_POW5_128_MAX_EXP) return false;
+
+	uint32_t explicit_bits = 52;
+	int32_t max_exponent = 1023, min_round_even = -4, max_round_even = 23;
+	if (flags & UFBXI_PARSE_DOUBLE_AS_BINARY32) {
+		explicit_bits = 23;
+		max_exponent = 127;
+		min_round_even = -17;
+		max_round_even = 10;
+	}
+
+	uint32_t lz = ufbxi_lzcnt64(digits);
+	uint64_t w = digits << lz;
+
+	const uint64_t *pow5 = ufbxi_pow5_128_tab + (size_t)(dec_exponent - UFBXI_POW5_128_MIN_EXP) * 2;
+	uint64_t hi, lo = ufbxi_mul64_wide(w, pow5[0], &hi);
+
+	// Refine with the lower half of the power if the bits beyond the rounding precision are all set
+	uint64_t precision_mask = UINT64_MAX >> (explicit_bits + 3);
+	if ((hi & precision_mask) == precision_mask) {
+		uint64_t lo_hi;
+		ufbxi_mul64_wide(w, pow5[1], &lo_hi);
+		lo += lo_hi;
+		if (lo_hi > lo) hi++;
+	}
+
+	uint32_t upper_bit = (uint32_t)(hi >> 63u);
+	uint32_t shift = upper_bit + 64 - explicit_bits - 3;
+	uint64_t mantissa = hi >> shift;
+	// floor(log2(10^q)) = floor(q * log2(10)), biased to avoid shifting negative values
+	int32_t log2_pow10 = (int32_t)(((uint32_t)(217706 * dec_exponent + (256 << 16))) >> 16u) - 256;
+	int32_t power2 = log2_pow10 + 63 + (int32_t)upper_bit - (int32_t)lz + max_exponent;
+	if (power2 <= 0) return false;
+
+	// Exact halfway cases can only happen for small exponents, round those to even
+	if (lo <= 1 && dec_exponent >= min_round_even && dec_exponent <= max_round_even && (mantissa & 3) == 1) {
+		if ((mantissa << shift) == hi) mantissa &= ~(uint64_t)1;
+	}
+
+	mantissa += mantissa & 1;
+	mantissa >>= 1;
+	if (mantissa >= (uint64_t)2 << explicit_bits) {
+		mantissa = (uint64_t)1 << explicit_bits;
+		power2++;
+	}
+	if (power2 >= max_exponent * 2 + 1) return false;
+
+	mantissa &= ~((uint64_t)1 << explicit_bits);
+	*p_bits = mantissa | (uint64_t)power2 << explicit_bits;
+	return true;
+}
+
 static ufbxi_noinline double ufbxi_parse_double(const char *str, size_t max_length, char **p_end, uint32_t flags)
 {
 	const uint32_t max_limbs = 14;
@@ -1685,6 +1994,21 @@ static ufbxi_noinline double ufbxi_parse_double(const char *str, size_t max_leng
 	}
 
 	if (big_mantissa.length == 0) {
+		uint64_t bits;
+		if (ufbxi_parse_double_eisel_lemire(&bits, digits, dec_exponent, flags)) {
+			if (flags & UFBXI_PARSE_DOUBLE_AS_BINARY32) {
+				uint32_t bits_lo = (uint32_t)bits | (negative ? 0x80000000u : 0u);
+				float result;
+				ufbxi_bit_cast(float, result, uint32_t, bits_lo);
+				return result;
+			} else {
+				bits |= negative ? UINT64_C(0x8000000000000000) : 0u;
+				double result;
+				ufbxi_bit_cast(double, result, uint64_t, bits);
+				return result;
+			}
+		}
+
 		big_mantissa.limbs[0] = (ufbxi_bigint_limb)digits;
 		big_mantissa.limbs[1] = (ufbxi_bigint_limb)(digits >> 32u);
 		big_mantissa.length = (digits >> 32u) ? 2 : digits ? 1 : 0;
@@ -3071,6 +3395,33 @@ ufbxi_inflate_block_fast(ufbxi_deflate_context *dc, ufbxi_trees *trees)
 				length -= 16;
 				ufbxi_copy_16_bytes(dst, src);
 			}
+		} else if (distance >= 8 && dst_space >= 8) {
+			// Overlapping match, eg. repeated `vec3` values: 8 byte chunks only read
+			// data that has already been written.
+			do {
+				ufbxi_copy_8_bytes(dst, src);
+				src += 8;
+				dst += 8;
+			} while (dst < end);
+		} else if ((distance == 1 || distance == 2 || distance == 4) && dst_space >= 8) {
+			// Short repeating pattern that evenly divides 8 bytes: Broadcast
+			// it to a 64-bit word and write it in 8 byte chunks.
+			uint64_t pattern;
+			if (distance == 1) {
+				pattern = (uint64_t)(uint8_t)src[0] * UINT64_C(0x0101010101010101);
+			} else if (distance == 2) {
+				uint16_t v; // ufbxi_uninit
+				memcpy(&v, src, 2);
+				pattern = (uint64_t)v * UINT64_C(0x0001000100010001);
+			} else {
+				uint32_t v; // ufbxi_uninit
+				memcpy(&v, src, 4);
+				pattern = (uint64_t)v * UINT64_C(0x0000000100000001);
+			}
+			do {
+				ufbxi_copy_8_bytes(dst, &pattern);
+				dst += 8;
+			} while (dst < end);
 		} else {
 			while (dst != end) {
 				*dst++ = *src++;
@@ -3603,6 +3954,8 @@ static ufbxi_noinline void ufbxi_fix_error_type(ufbx_error *error, const char *d
 		error->type = UFBX_ERROR_UNSAFE_OPTIONS;
 	} else if (!strcmp(desc, "Duplicate override")) {
 		error->type = UFBX_ERROR_DUPLICATE_OVERRIDE;
+	} else if (!strcmp(desc, "Snapshot mismatch")) {
+		error->type = UFBX_ERROR_SNAPSHOT_MISMATCH;
 	}
 	error->description.data = desc;
 	error->description.length = strlen(desc);
@@ -3632,9 +3985,44 @@ static ufbxi_forceinline size_t ufbxi_size_align_mask(size_t size)
 	return ((size ^ (size - 1)) >> 1) & (UFBX_MAXIMUM_ALIGNMENT - 1);
 }
 
+// Memory limit shared between allocators of concurrent loads, see `ufbx_load_files()`.
+typedef struct {
+#if UFBXI_HAS_PTHREADS
+	pthread_mutex_t mutex;
+#endif
+	size_t used;
+	size_t limit;
+} ufbxi_memory_budget;
+
+static ufbxi_noinline bool ufbxi_budget_reserve(ufbxi_memory_budget *budget, size_t size)
+{
+#if UFBXI_HAS_PTHREADS
+	pthread_mutex_lock(&budget->mutex);
+#endif
+	bool ok = size <= budget->limit - budget->used;
+	if (ok) budget->used += size;
+#if UFBXI_HAS_PTHREADS
+	pthread_mutex_unlock(&budget->mutex);
+#endif
+	return ok;
+}
+
+static ufbxi_noinline void ufbxi_budget_release(ufbxi_memory_budget *budget, size_t size)
+{
+#if UFBXI_HAS_PTHREADS
+	pthread_mutex_lock(&budget->mutex);
+#endif
+	ufbx_assert(size <= budget->used);
+	budget->used -= size;
+#if UFBXI_HAS_PTHREADS
+	pthread_mutex_unlock(&budget->mutex);
+#endif
+}
+
 typedef struct {
 	ufbx_error *error;
 	size_t current_size;
+	size_t peak_size;
 	size_t max_size;
 	size_t num_allocs;
 	size_t max_allocs;
@@ -3642,6 +4030,7 @@ typedef struct {
 	size_t chunk_max;
 	ufbx_allocator_opts ator;
 	const char *name;
+	ufbxi_memory_budget *budget; // < Optional shared limit charged in addition to `max_size`
 } ufbxi_allocator;
 
 static ufbxi_forceinline bool ufbxi_does_overflow(size_t total, size_t a, size_t b)
@@ -3672,6 +4061,11 @@ static ufbxi_noinline void *ufbxi_alloc_size(ufbxi_allocator *ator, size_t size,
 		ufbxi_fmt_err_info(ator->error, "%s", ator->name);
 		return NULL;
 	}
+	if (ator->budget && !ufbxi_budget_reserve(ator->budget, total)) {
+		ufbxi_report_err_msg(ator->error, "ufbxi_budget_reserve(ator->budget, total)", "Memory limit exceeded");
+		ufbxi_fmt_err_info(ator->error, "%s", ator->name);
+		return NULL;
+	}
 	ator->num_allocs++;
 
 	void *ptr;
@@ -3684,6 +4078,7 @@ static ufbxi_noinline void *ufbxi_alloc_size(ufbxi_allocator *ator, size_t size,
 	}
 
 	if (!ptr) {
+		if (ator->budget) ufbxi_budget_release(ator->budget, total);
 		ufbxi_report_err_msg(ator->error, "ptr", "Out of memory");
 		ufbxi_fmt_err_info(ator->error, "%s", ator->name);
 		return NULL;
@@ -3691,6 +4086,7 @@ static ufbxi_noinline void *ufbxi_alloc_size(ufbxi_allocator *ator, size_t size,
 	ufbx_assert(ufbxi_is_aligned_mask(ptr, ufbxi_size_align_mask(total)));
 
 	ator->current_size += total;
+	if (ator->current_size > ator->peak_size) ator->peak_size = ator->current_size;
 
 	return ptr;
 }
@@ -3714,6 +4110,9 @@ static ufbxi_noinline void *ufbxi_realloc_size(ufbxi_allocator *ator, size_t siz
 	ufbxi_check_return_err(ator->error, total <= SIZE_MAX / 2, NULL); // Make sure it's always safe to double allocations
 	ufbxi_check_return_err_msg(ator->error, total <= ator->max_size - ator->current_size, NULL, "Memory limit exceeded");
 	ufbxi_check_return_err_msg(ator->error, ator->num_allocs < ator->max_allocs, NULL, "Allocation limit exceeded");
+	if (ator->budget && total > old_total) {
+		ufbxi_check_return_err_msg(ator->error, ufbxi_budget_reserve(ator->budget, total - old_total), NULL, "Memory limit exceeded");
+	}
 	ator->num_allocs++;
 
 	void *ptr;
@@ -3730,11 +4129,20 @@ static ufbxi_noinline void *ufbxi_realloc_size(ufbxi_allocator *ator, size_t siz
 		ptr = ufbx_realloc(old_ptr, old_total, total);
 	}
 
+	if (ator->budget) {
+		if (!ptr && total > old_total) {
+			ufbxi_budget_release(ator->budget, total - old_total);
+		} else if (ptr && total < old_total) {
+			ufbxi_budget_release(ator->budget, old_total - total);
+		}
+	}
+
 	ufbxi_check_return_err_msg(ator->error, ptr, NULL, "Out of memory");
 	ufbx_assert(ufbxi_is_aligned_mask(ptr, ufbxi_size_align_mask(total)));
 
 	ator->current_size += total;
 	ator->current_size -= old_total;
+	if (ator->current_size > ator->peak_size) ator->peak_size = ator->current_size;
 
 	return ptr;
 }
@@ -3752,6 +4160,7 @@ static ufbxi_noinline void ufbxi_free_size(ufbxi_allocator *ator, size_t size, v
 	ufbx_assert(total <= ator->current_size);
 
 	ator->current_size -= total;
+	if (ator->budget) ufbxi_budget_release(ator->budget, total);
 
 	if (ator->ator.allocator.alloc_fn || ator->ator.allocator.realloc_fn) {
 		// Don't call default free() if there is an user-provided `alloc_fn()`
@@ -3813,6 +4222,10 @@ static ufbxi_noinline void ufbxi_free_ator(ufbxi_allocator *ator)
 #define UFBXI_BAKED_ANIM_IMP_MAGIC 0x4b414255
 #define UFBXI_REFCOUNT_IMP_MAGIC 0x46455255
 #define UFBXI_BUF_CHUNK_IMP_MAGIC 0x46554255
+#define UFBXI_PROBE_IMP_MAGIC 0x42525055
+#define UFBXI_PACKED_MESH_IMP_MAGIC 0x4b435055
+#define UFBXI_LOADER_MAGIC 0x52444c55
+#define UFBXI_CACHE_READER_MAGIC 0x44524355
 
 // -- Memory buffer
 //
@@ -4355,7 +4768,23 @@ static ufbxi_noinline void ufbxi_buf_clear(ufbxi_buf *buf)
 
 // -- Hash map
 //
+// Open addressing hash table probing groups of `UFBXI_MAP_GROUP_SLOTS` slots at a time.
+// Every slot has a control byte that is either `UFBXI_MAP_EMPTY` or the top 7 bits of the
+// hash of the item, so a whole group can be filtered using a single 16-byte SIMD comparison.
+// Groups are probed in triangular order which visits every group for power of two sizes.
+// The items are stored densely in insertion order in `items[]`, slots store the index
+// of the item next to the control bytes so that each group fits in one cache line and a
+// lookup usually touches a single line of the table before the item itself. The 7-bit tag
+// rejects all but 1/128 of non-matching slots. Full 32-bit hashes are kept on the side in
+// `hashes[]` as they are only needed when growing.
+//
+// Probing is limited to `UFBXI_MAP_MAX_SCAN` groups, items that don't fit are stored in an
+// AA tree ordered by `cmp_fn`. Hashes of keys from the file are predictable so a malicious
+// file can make all of them collide, this keeps the worst case at O(log n) per operation.
+//
 // The actual element comparison is left to the user of `ufbxi_map`, see usage below.
+// `ufbxi_map_find_uint64()` and `ufbxi_map_find_string()` are specialized for the common
+// `uint64_t` and `ufbx_string` keys and compare inline instead of calling `cmp_fn`.
 //
 // NOTES:
 //   ufbxi_map_insert() does not support duplicate values, use find first if duplicates are possible!
@@ -4371,13 +4800,29 @@ struct ufbxi_aa_node {
 	uint32_t index;
 };
 
+#define UFBXI_MAP_GROUP_SLOTS 12
+#define UFBXI_MAP_GROUP_LOAD 9
+#define UFBXI_MAP_SLOT_MASK 0xfffu
+#define UFBXI_MAP_EMPTY 0x80
+
+// Control bytes past `UFBXI_MAP_GROUP_SLOTS` are always `UFBXI_MAP_EMPTY` and never
+// reported as they are outside of `UFBXI_MAP_SLOT_MASK`.
+typedef struct {
+	uint8_t ctrl[16];                        // < `UFBXI_MAP_EMPTY` or `hash >> 25` per slot
+	uint32_t index[UFBXI_MAP_GROUP_SLOTS];   // < Index into `items[]`, valid if not empty
+} ufbxi_map_group;
+
+ufbx_static_assert(map_group_size, sizeof(ufbxi_map_group) == 64);
+
 typedef struct {
 	ufbxi_allocator *ator;
+	char *data;
 	size_t data_size;
 
 	void *items;
-	uint64_t *entries;
-	uint32_t mask;
+	ufbxi_map_group *groups;
+	uint32_t *hashes; // < Full hash per item in `items[]`
+	uint32_t mask;    // < Number of groups minus one
 
 	uint32_t capacity;
 	uint32_t size;
@@ -4390,6 +4835,47 @@ typedef struct {
 
 } ufbxi_map;
 
+// Bitmask of control bytes in the 16 bytes starting at `ctrl` equal to `tag`.
+// The scalar fallback may report false positives for slots next to a real match,
+// these are filtered out by comparing the keys.
+#if UFBXI_HAS_SSE
+
+static ufbxi_forceinline uint32_t ufbxi_map_match_tag(const uint8_t *ctrl, uint8_t tag)
+{
+	__m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)tag)));
+}
+
+static ufbxi_forceinline uint32_t ufbxi_map_match_empty(const uint8_t *ctrl)
+{
+	return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+}
+
+#else
+
+// Gather the top bits of each byte in `v` into an 8-bit mask.
+static ufbxi_forceinline uint32_t ufbxi_map_byte_mask(uint64_t v)
+{
+	return (uint32_t)((((v >> 7u) & UINT64_C(0x0101010101010101)) * UINT64_C(0x0102040810204080)) >> 56u);
+}
+
+static ufbxi_forceinline uint32_t ufbxi_map_match_tag(const uint8_t *ctrl, uint8_t tag)
+{
+	const uint64_t lo = UINT64_C(0x0101010101010101), hi = UINT64_C(0x8080808080808080);
+	uint64_t a = ufbxi_read_u64(ctrl) ^ (lo * tag);
+	uint64_t b = ufbxi_read_u64(ctrl + 8) ^ (lo * tag);
+	a = (a - lo) & ~a & hi;
+	b = (b - lo) & ~b & hi;
+	return ufbxi_map_byte_mask(a) | ufbxi_map_byte_mask(b) << 8u;
+}
+
+static ufbxi_forceinline uint32_t ufbxi_map_match_empty(const uint8_t *ctrl)
+{
+	return ufbxi_map_byte_mask(ufbxi_read_u64(ctrl)) | ufbxi_map_byte_mask(ufbxi_read_u64(ctrl + 8)) << 8u;
+}
+
+#endif
+
 static ufbxi_noinline void ufbxi_map_init(ufbxi_map *map, ufbxi_allocator *ator, ufbxi_cmp_fn *cmp_fn, void *cmp_user)
 {
 	map->ator = ator;
@@ -4414,6 +4900,9 @@ static ufbxi_noinline void ufbxi_map_init(ufbxi_map *map, ufbxi_allocator *ator,
 #else
 	map->aa_buf.ator = ator;
 #endif
+	// The AA tree is rebuilt from scratch when growing
+	map->aa_buf.unordered = true;
+	map->aa_buf.clearable = true;
 	map->cmp_fn = cmp_fn;
 	map->cmp_user = cmp_user;
 }
@@ -4425,10 +4914,13 @@ static ufbxi_noinline void ufbxi_map_free(ufbxi_map *map)
 #endif
 
 	ufbxi_buf_free(&map->aa_buf);
-	ufbxi_free(map->ator, char, map->entries, map->data_size);
-	map->entries = NULL;
+	ufbxi_free(map->ator, char, map->data, map->data_size);
+	map->data = NULL;
+	map->groups = NULL;
+	map->hashes = NULL;
 	map->items = NULL;
 	map->aa_root = NULL;
+	map->data_size = 0;
 	map->mask = map->capacity = map->size = 0;
 
 #if defined(UFBX_REGRESSION)
@@ -4440,26 +4932,18 @@ static ufbxi_noinline void ufbxi_map_free(ufbxi_map *map)
 }
 
 // Recursion limit: log2(2^64 / sizeof(ufbxi_aa_node))
-static ufbxi_noinline ufbxi_aa_node *ufbxi_aa_tree_insert(ufbxi_map *map, ufbxi_aa_node *node, const void *value, uint32_t index, size_t item_size)
-	ufbxi_recursive_function(ufbxi_aa_node *, ufbxi_aa_tree_insert, (map, node, value, index, item_size), 59,
-		(ufbxi_map *map, ufbxi_aa_node *node, const void *value, uint32_t index, size_t item_size))
+static ufbxi_noinline ufbxi_aa_node *ufbxi_aa_tree_insert(ufbxi_map *map, ufbxi_aa_node *node, ufbxi_aa_node *new_node, const void *value, size_t item_size)
+	ufbxi_recursive_function(ufbxi_aa_node *, ufbxi_aa_tree_insert, (map, node, new_node, value, item_size), 59,
+		(ufbxi_map *map, ufbxi_aa_node *node, ufbxi_aa_node *new_node, const void *value, size_t item_size))
 {
-	if (!node) {
-		ufbxi_aa_node *new_node = ufbxi_push(&map->aa_buf, ufbxi_aa_node, 1);
-		if (!new_node) return NULL;
-		new_node->left = NULL;
-		new_node->right = NULL;
-		new_node->level = 1;
-		new_node->index = index;
-		return new_node;
-	}
+	if (!node) return new_node;
 
 	void *entry = (char*)map->items + node->index * item_size;
 	int cmp = map->cmp_fn(map->cmp_user, value, entry);
 	if (cmp < 0) {
-		node->left = ufbxi_aa_tree_insert(map, node->left, value, index, item_size);
-	} else if (cmp >= 0) {
-		node->right = ufbxi_aa_tree_insert(map, node->right, value, index, item_size);
+		node->left = ufbxi_aa_tree_insert(map, node->left, new_node, value, item_size);
+	} else {
+		node->right = ufbxi_aa_tree_insert(map, node->right, new_node, value, item_size);
 	}
 
 	if (node->left && node->left->level == node->level) {
@@ -4480,7 +4964,7 @@ static ufbxi_noinline ufbxi_aa_node *ufbxi_aa_tree_insert(ufbxi_map *map, ufbxi_
 	return node;
 }
 
-static ufbxi_noinline void *ufbxi_aa_tree_find(ufbxi_map *map, const void *value, size_t item_size)
+static ufbxi_noinline void *ufbxi_aa_tree_find(const ufbxi_map *map, const void *value, size_t item_size)
 {
 	ufbxi_aa_node *node = map->aa_root;
 	while (node) {
@@ -4497,79 +4981,97 @@ static ufbxi_noinline void *ufbxi_aa_tree_find(ufbxi_map *map, const void *value
 	return NULL;
 }
 
+// Place item `index` in the first empty slot of the probe sequence, there are no deletions
+// so lookups will find the item before reaching an empty slot. If the first
+// `UFBXI_MAP_MAX_SCAN` groups are full the item is inserted to the AA tree instead.
+static ufbxi_noinline bool ufbxi_map_place(ufbxi_map *map, size_t item_size, uint32_t hash, uint32_t index, const void *value)
+{
+	uint32_t mask = map->mask;
+	uint32_t pos = hash & mask, stride = 0;
+	for (;;) {
+		uint32_t empty = ufbxi_map_match_empty(map->groups[pos].ctrl) & UFBXI_MAP_SLOT_MASK;
+		if (empty) {
+			uint32_t slot = 31u - ufbxi_lzcnt32(empty & (0u - empty));
+			map->groups[pos].ctrl[slot] = (uint8_t)(hash >> 25u);
+			map->groups[pos].index[slot] = index;
+			return true;
+		}
+
+		stride += 1;
+		if (stride >= UFBXI_MAP_MAX_SCAN) break;
+		pos = (pos + stride) & mask;
+	}
+
+	ufbxi_aa_node *node = ufbxi_push(&map->aa_buf, ufbxi_aa_node, 1);
+	ufbxi_check_return_err(map->ator->error, node, false);
+	node->left = NULL;
+	node->right = NULL;
+	node->level = 1;
+	node->index = index;
+	map->aa_root = ufbxi_aa_tree_insert(map, map->aa_root, node, value, item_size);
+	return true;
+}
+
 static ufbxi_noinline bool ufbxi_map_grow_size_imp(ufbxi_map *map, size_t item_size, size_t min_size)
 {
 	ufbx_assert(min_size > 0);
-	const double load_factor = 0.7;
 
-	// Find the lowest power of two size that fits `min_size` within `load_factor`
-	size_t num_entries = map->mask + 1;
-	size_t new_size = (size_t)((double)num_entries * load_factor);
+	// Find the lowest power of two group count that fits `min_size` with a load factor of 3/4
+	size_t num_groups = map->groups ? (size_t)map->mask + 1 : 1;
+	size_t new_size = num_groups * UFBXI_MAP_GROUP_LOAD;
 	if (min_size < map->capacity + 1) min_size = map->capacity + 1;
 	while (new_size < min_size) {
-		num_entries *= 2;
-		new_size = (size_t)((double)num_entries * load_factor);
+		ufbxi_check_return_err(map->ator->error, num_groups <= UINT32_MAX / UFBXI_MAP_GROUP_SLOTS / 2, false);
+		num_groups *= 2;
+		new_size = num_groups * UFBXI_MAP_GROUP_LOAD;
 	}
 
 	// Check for overflow
-	ufbxi_check_return_err(map->ator->error, SIZE_MAX / num_entries > sizeof(uint64_t), false);
-	size_t alloc_size = num_entries * sizeof(uint64_t);
+	ufbxi_check_return_err(map->ator->error, SIZE_MAX / num_groups > sizeof(ufbxi_map_group), false);
+	size_t groups_size = num_groups * sizeof(ufbxi_map_group);
+	size_t table_size = groups_size + sizeof(ufbxi_map_group);
 
-	// Allocate a combined entry/item memory block
-	ufbxi_check_return_err(map->ator->error, (SIZE_MAX - alloc_size) / new_size > item_size, false);
-	size_t data_size = alloc_size + new_size * item_size;
+	// Allocate a combined group/item/hash memory block, padded so that
+	// the groups can be aligned to cache lines.
+	size_t entry_size = item_size + sizeof(uint32_t);
+	ufbxi_check_return_err(map->ator->error, (SIZE_MAX - table_size - sizeof(uint32_t)) / new_size > entry_size, false);
+	size_t hashes_offset = ufbxi_align_to_mask(table_size + new_size * item_size, sizeof(uint32_t) - 1);
+	size_t data_size = hashes_offset + new_size * sizeof(uint32_t);
 
 	char *data = ufbxi_alloc(map->ator, char, data_size);
 	ufbxi_check_return_err(map->ator->error, data, false);
 
-	// Copy the previous user items over
-	uint64_t *old_entries = map->entries;
-	uint64_t *new_entries = (uint64_t*)data;
-	void *new_items = data + alloc_size;
+	ufbxi_map_group *new_groups = (ufbxi_map_group*)(data + ufbxi_align_to_mask((size_t)data, sizeof(ufbxi_map_group) - 1) - (size_t)data);
+	void *new_items = data + table_size;
+	uint32_t *new_hashes = (uint32_t*)(data + hashes_offset);
+
+	// Copy the previous user items and their hashes over
 	if (map->size > 0) {
 		memcpy(new_items, map->items, item_size * map->size);
+		memcpy(new_hashes, map->hashes, sizeof(uint32_t) * map->size);
 	}
-
-	// Re-hash the entries
-	uint32_t old_mask = map->mask;
-	uint32_t new_mask = (uint32_t)(num_entries) - 1;
-	memset(new_entries, 0, sizeof(uint64_t) * num_entries);
-	if (old_mask) {
-		for (uint32_t i = 0; i <= old_mask; i++) {
-			uint64_t entry, new_entry = old_entries[i];
-			if (!new_entry) continue;
-
-			// Reconstruct the hash of the old entry at `i`
-			uint32_t old_scan = (uint32_t)(new_entry & old_mask) - 1;
-			uint32_t hash = ((uint32_t)new_entry & ~old_mask) | ((i - old_scan) & old_mask);
-			uint32_t slot = hash & new_mask;
-			new_entry &= ~(uint64_t)new_mask;
-
-			// Scan forward until we find an empty slot, potentially swapping
-			// `new_element` if it has a shorter scan distance (Robin Hood).
-			uint32_t scan = 1;
-			while ((entry = new_entries[slot]) != 0) {
-				uint32_t entry_scan = (uint32_t)(entry & new_mask);
-				if (entry_scan < scan) {
-					new_entries[slot] = new_entry + scan;
-					new_entry = (entry & ~(uint64_t)new_mask);
-					scan = entry_scan;
-				}
-				scan += 1;
-				slot = (slot + 1) & new_mask;
-			}
-			new_entries[slot] = new_entry + scan;
-		}
+	for (size_t i = 0; i < num_groups; i++) {
+		memset(new_groups[i].ctrl, UFBXI_MAP_EMPTY, sizeof(new_groups[i].ctrl));
 	}
 
-	// And finally free the previous allocation
-	ufbxi_free(map->ator, char, (char*)old_entries, map->data_size);
-	map->items = new_items;
+	ufbxi_free(map->ator, char, map->data, map->data_size);
+	map->data = data;
 	map->data_size = data_size;
-	map->entries = new_entries;
-	map->mask = new_mask;
+	map->items = new_items;
+	map->groups = new_groups;
+	map->hashes = new_hashes;
+	map->mask = (uint32_t)(num_groups - 1);
 	map->capacity = (uint32_t)new_size;
 
+	// Re-insert the entries in order, all the items are unique so no comparisons are
+	// needed unless they overflow into the rebuilt AA tree.
+	ufbxi_buf_clear(&map->aa_buf);
+	map->aa_root = NULL;
+	for (uint32_t i = 0; i < map->size; i++) {
+		const void *value = (const char*)new_items + i * item_size;
+		if (!ufbxi_map_place(map, item_size, new_hashes[i], i, value)) return false;
+	}
+
 	return true;
 }
 
@@ -4587,75 +5089,85 @@ static ufbxi_forceinline bool ufbxi_map_grow_size(ufbxi_map *map, size_t size, s
 	return ufbxi_map_grow_size_imp(map, size, min_size);
 }
 
-static ufbxi_noinline void *ufbxi_map_find_size(ufbxi_map *map, size_t size, uint32_t hash, const void *value)
-{
-	uint64_t *entries = map->entries;
-	uint32_t mask = map->mask, scan = 0;
+typedef enum {
+	UFBXI_MAP_KEY_CMP_FN,
+	UFBXI_MAP_KEY_UINT64,
+	UFBXI_MAP_KEY_STRING,
+} ufbxi_map_key;
 
-	uint32_t ref = hash & ~mask;
-	if (!mask || scan == UINT32_MAX) return 0;
+// Generic lookup, `key` is a compile time constant so every variant gets its own copy.
+static ufbxi_forceinline void *ufbxi_map_find_imp(ufbxi_map *map, size_t size, uint32_t hash, const void *value, ufbxi_map_key key)
+{
+	if (!map->groups) return NULL;
 
-	// Scan entries until we find an exact match of the hash or until we hit
-	// an element that has lower scan distance than our search (Robin Hood).
-	// The encoding guarantees that zero slots also terminate with the same test.
+	uint32_t mask = map->mask;
+	uint8_t tag = (uint8_t)(hash >> 25u);
+	uint32_t pos = hash & mask, stride = 0;
 	for (;;) {
-		uint64_t entry = entries[(hash + scan) & mask];
-		scan += 1;
-		if ((uint32_t)entry == ref + scan) {
-			uint32_t index = (uint32_t)(entry >> 32u);
-			void *data = (char*)map->items + size * index;
-			int cmp = map->cmp_fn(map->cmp_user, value, data);
-			if (cmp == 0) return data;
-		} else if ((entry & mask) < scan) {
-			if (map->aa_root) {
-				return ufbxi_aa_tree_find(map, value, size);
+		const ufbxi_map_group *group = &map->groups[pos];
+		uint32_t match = ufbxi_map_match_tag(group->ctrl, tag) & UFBXI_MAP_SLOT_MASK;
+		while (match) {
+			uint32_t bit = 31u - ufbxi_lzcnt32(match);
+			match &= ~(1u << bit);
+
+			void *data = (char*)map->items + size * (size_t)group->index[bit];
+			if (key == UFBXI_MAP_KEY_UINT64) {
+				if (*(const uint64_t*)data == *(const uint64_t*)value) return data;
+			} else if (key == UFBXI_MAP_KEY_STRING) {
+				const ufbx_string *a = (const ufbx_string*)value, *b = (const ufbx_string*)data;
+				if (a->length == b->length && !memcmp(a->data, b->data, a->length)) return data;
 			} else {
-				return NULL;
+				if (map->cmp_fn(map->cmp_user, value, data) == 0) return data;
 			}
 		}
+
+		// An empty slot in the group terminates the probe sequence as no item has
+		// been inserted past it.
+		if (ufbxi_map_match_empty(group->ctrl) & UFBXI_MAP_SLOT_MASK) return NULL;
+
+		stride += 1;
+		if (stride >= UFBXI_MAP_MAX_SCAN) break;
+		pos = (pos + stride) & mask;
 	}
+
+	return map->aa_root ? ufbxi_aa_tree_find(map, value, size) : NULL;
 }
 
-static ufbxi_noinline void *ufbxi_map_insert_size(ufbxi_map *map, size_t size, uint32_t hash, const void *value)
+static ufbxi_noinline void *ufbxi_map_find_size(ufbxi_map *map, size_t size, uint32_t hash, const void *value)
 {
-	if (!ufbxi_map_grow_size(map, size, 64)) return NULL;
+	return ufbxi_map_find_imp(map, size, hash, value, UFBXI_MAP_KEY_CMP_FN);
+}
 
-	ufbxi_regression_assert(ufbxi_map_find_size(map, size, hash, value) == NULL);
+// Find an item starting with a `uint64_t` key.
+static ufbxi_noinline void *ufbxi_map_find_uint64_size(ufbxi_map *map, size_t size, uint32_t hash, uint64_t value)
+{
+	return ufbxi_map_find_imp(map, size, hash, &value, UFBXI_MAP_KEY_UINT64);
+}
 
-	uint32_t index = map->size++;
+// Find an item starting with a `ufbx_string` key.
+static ufbxi_noinline void *ufbxi_map_find_string_size(ufbxi_map *map, size_t size, uint32_t hash, const ufbx_string *value)
+{
+	return ufbxi_map_find_imp(map, size, hash, value, UFBXI_MAP_KEY_STRING);
+}
 
-	uint64_t *entries = map->entries;
-	uint32_t mask = map->mask;
+static ufbxi_noinline void *ufbxi_map_insert_size(ufbxi_map *map, size_t size, uint32_t hash, const void *value)
+{
+	if (!ufbxi_map_grow_size(map, size, 64)) return NULL;
 
-	// Scan forward until we find an empty slot, potentially swapping
-	// `new_element` if it has a shorter scan distance (Robin Hood).
-	uint32_t slot = hash & mask;
-	uint64_t entry, new_entry = (uint64_t)index << 32u | (hash & ~mask);
-	uint32_t scan = 1;
-	while ((entry = entries[slot]) != 0) {
-		uint32_t entry_scan = (uint32_t)(entry & mask);
-		if (entry_scan < scan) {
-			entries[slot] = new_entry + scan;
-			new_entry = (entry & ~(uint64_t)mask);
-			scan = entry_scan;
-		}
-		scan += 1;
-		slot = (slot + 1) & mask;
+	ufbxi_regression_assert(ufbxi_map_find_size(map, size, hash, value) == NULL);
 
-		if (scan > UFBXI_MAP_MAX_SCAN) {
-			uint32_t new_index = (uint32_t)(new_entry >> 32u);
-			const void *new_value = new_index == index ? value : (const void*)((char*)map->items + size * new_index);
-			map->aa_root = ufbxi_aa_tree_insert(map, map->aa_root, new_value, new_index, size);
-			return (char*)map->items + size * index;
-		}
-	}
-	entries[slot] = new_entry + scan;
+	uint32_t index = map->size;
+	if (!ufbxi_map_place(map, size, hash, index, value)) return NULL;
+	map->hashes[index] = hash;
+	map->size++;
 
 	return (char*)map->items + size * index;
 }
 
 #define ufbxi_map_grow(map, type, min_size) ufbxi_map_grow_size((map), sizeof(type), (min_size))
 #define ufbxi_map_find(map, type, hash, value) ufbxi_maybe_null((type*)ufbxi_map_find_size((map), sizeof(type), (hash), (value)))
+#define ufbxi_map_find_uint64(map, type, hash, value) ufbxi_maybe_null((type*)ufbxi_map_find_uint64_size((map), sizeof(type), (hash), (value)))
+#define ufbxi_map_find_string(map, type, hash, value) ufbxi_maybe_null((type*)ufbxi_map_find_string_size((map), sizeof(type), (hash), (value)))
 #define ufbxi_map_insert(map, type, hash, value) ufbxi_maybe_null((type*)ufbxi_map_insert_size((map), sizeof(type), (hash), (value)))
 
 static int ufbxi_map_cmp_uint64(void *user, const void *va, const void *vb)
@@ -4902,6 +5414,7 @@ typedef struct {
 	ufbx_error *error;
 	ufbxi_buf buf; // < Buffer for the actual string data
 	ufbxi_map map; // < Map of `ufbxi_string`
+	ufbxi_map *shared; // < Optional immutable map of `ufbxi_string` probed before `map`
 	size_t initial_size; // < Number of initial entries
 	char  *temp_str; // < Temporary string buffer of `temp_cap`
 	size_t temp_cap; // < Capacity of the temporary buffer
@@ -5190,7 +5703,13 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_push_sanitized_string(ufbxi_stri
 
 	ufbx_string ref = { total_data, total_length };
 
-	ufbx_string *entry = ufbxi_map_find(&pool->map, ufbx_string, hash, &ref);
+	ufbx_string *entry = NULL;
+	if (pool->shared) {
+		entry = ufbxi_map_find_string(pool->shared, ufbx_string, hash, &ref);
+	}
+	if (!entry) {
+		entry = ufbxi_map_find_string(&pool->map, ufbx_string, hash, &ref);
+	}
 	if (entry) {
 		sanitized->raw_data = entry->data;
 	} else {
@@ -5235,7 +5754,12 @@ ufbxi_nodiscard static ufbxi_noinline const char *ufbxi_push_string_imp(ufbxi_st
 
 	ufbx_string ref = { str, length };
 
-	ufbx_string *entry = ufbxi_map_find(&pool->map, ufbx_string, hash, &ref);
+	ufbx_string *entry = NULL;
+	if (pool->shared) {
+		entry = ufbxi_map_find_string(pool->shared, ufbx_string, hash, &ref);
+		if (entry) return entry->data;
+	}
+	entry = ufbxi_map_find_string(&pool->map, ufbx_string, hash, &ref);
 	if (entry) return entry->data;
 	entry = ufbxi_map_insert(&pool->map, ufbx_string, hash, &ref);
 	ufbxi_check_return_err(pool->error, entry, NULL);
@@ -5981,6 +6505,7 @@ static ufbxi_noinline ufbx_vec3 ufbxi_slow_normalized_cross3(const ufbx_vec3 *a,
 
 typedef struct ufbxi_task ufbxi_task;
 typedef struct ufbxi_thread_pool ufbxi_thread_pool;
+typedef struct ufbxi_os_thread_pool ufbxi_os_thread_pool;
 
 typedef bool ufbxi_task_fn(ufbxi_task *task);
 
@@ -5992,13 +6517,20 @@ struct ufbxi_task {
 typedef struct {
 	ufbxi_task task;
 	ufbxi_task_fn *fn;
+	double cpu_time;
 } ufbxi_task_imp;
 
+static ufbxi_noinline double ufbxi_read_clock(const ufbx_clock_cb *clock_cb, bool cpu_time);
+
 typedef struct {
-	uint32_t max_index;
-	uint32_t wait_index;
+	uint64_t max_index;
+	uint64_t wait_index;
 } ufbxi_task_group;
 
+// Task indices are tracked as 64-bit integers internally, the 32-bit indices passed
+// to `ufbx_thread_pool_run_fn()` wrap around but still map to the right task as
+// `num_tasks` is always a power of two. `max_tasks <= num_tasks` is the limit of
+// tasks in flight reported to the pool as `ufbx_thread_pool_info.max_concurrent_tasks`.
 struct ufbxi_thread_pool {
 	ufbx_thread_opts opts;
 	ufbxi_allocator *ator;
@@ -6009,45 +6541,379 @@ struct ufbxi_thread_pool {
 	bool failed;
 	const char *error_desc;
 
-	uint32_t start_index;
-	uint32_t execute_index;
-	uint32_t wait_index;
+	uint64_t start_index;
+	uint64_t execute_index;
+	uint64_t wait_index;
 
 	ufbxi_task_group groups[UFBX_THREAD_GROUP_COUNT];
 	uint32_t group;
 
 	uint32_t num_tasks;
+	uint32_t max_tasks;
 	ufbxi_task_imp *tasks;
+
+	ufbxi_os_thread_pool *os_pool;
+
+	// `ufbx_load_opts.collect_load_stats`: CPU time of tasks run on threads other than
+	// `owner` (the loading thread) summed to `task_cpu_time` as the tasks are waited for.
+	bool collect_cpu_time;
+	ufbx_clock_cb clock_cb;
+	double task_cpu_time;
+	#if UFBXI_HAS_PTHREADS
+		pthread_t owner;
+	#endif
 };
 
 static void ufbxi_thread_pool_execute(ufbxi_thread_pool *pool, uint32_t index)
 {
-	ufbxi_task_imp *imp = &pool->tasks[index % pool->num_tasks];
-	if (imp->fn(&imp->task)) {
+	ufbxi_task_imp *imp = &pool->tasks[index & (pool->num_tasks - 1)];
+
+	bool ok;
+	#if UFBXI_HAS_PTHREADS
+	if (pool->collect_cpu_time && !pthread_equal(pthread_self(), pool->owner)) {
+		double begin = ufbxi_read_clock(&pool->clock_cb, true);
+		ok = imp->fn(&imp->task);
+		imp->cpu_time = ufbxi_read_clock(&pool->clock_cb, true) - begin;
+	} else
+	#endif
+	{
+		ok = imp->fn(&imp->task);
+	}
+
+	if (ok) {
 		imp->task.error = NULL;
 	} else if (!imp->task.error) {
 		imp->task.error = "";
 	}
 }
 
-ufbxi_noinline static void ufbxi_thread_pool_update_finished(ufbxi_thread_pool *pool, uint32_t max_index)
+#if UFBXI_HAS_PTHREADS
+
+// Built-in work-stealing thread pool used if `ufbx_thread_opts.num_threads` is set
+// without a user provided `ufbx_thread_opts.pool`.
+//
+// Each worker (and the loading thread) owns a queue containing a range of task
+// indices per group. `ufbxi_os_pool_run()` splits the new tasks evenly between
+// the queues, owners pop tasks from the beginning of their ranges and idle threads
+// steal the upper half of the range of another queue. Waiting for a group also
+// executes and steals tasks of that group.
+
+typedef struct {
+	uint64_t begin;
+	uint64_t end;
+} ufbxi_os_range;
+
+typedef struct {
+	pthread_mutex_t mutex;
+	ufbxi_os_range ranges[UFBX_THREAD_GROUP_COUNT];
+} ufbxi_os_queue;
+
+// Protected by `ufbxi_os_thread_pool.mutex`, workers of a previous instance of the
+// group may still be finishing when the loading thread submits more tasks.
+typedef struct {
+	size_t num_submitted; // < Total number of tasks ever submitted to the group
+	size_t num_done;
+} ufbxi_os_group;
+
+typedef struct {
+	ufbxi_os_thread_pool *os;
+	uint32_t queue;
+	pthread_t thread;
+} ufbxi_os_worker;
+
+struct ufbxi_os_thread_pool {
+	ufbxi_thread_pool *pool;
+
+	pthread_mutex_t mutex;
+	pthread_cond_t work_cond;
+	pthread_cond_t done_cond;
+	uint64_t work_epoch;
+	bool initialized;
+	bool stop;
+
+	ufbxi_os_group groups[UFBX_THREAD_GROUP_COUNT];
+
+	// `num_threads + 1` queues, the last one belongs to the loading thread
+	ufbxi_os_queue *queues;
+	uint32_t num_queues;
+	uint32_t num_queues_initialized;
+
+	ufbxi_os_worker *workers;
+	uint32_t num_threads;
+	uint32_t num_started;
+};
+
+static bool ufbxi_os_pool_pop(ufbxi_os_queue *queue, uint32_t group, uint64_t *p_index)
+{
+	bool found = false;
+	pthread_mutex_lock(&queue->mutex);
+	ufbxi_os_range *range = &queue->ranges[group];
+	if (range->begin < range->end) {
+		*p_index = range->begin++;
+		found = true;
+	}
+	pthread_mutex_unlock(&queue->mutex);
+	return found;
+}
+
+static bool ufbxi_os_pool_steal(ufbxi_os_thread_pool *os, uint32_t self, uint32_t group, uint64_t *p_index)
+{
+	for (uint32_t i = 1; i < os->num_queues; i++) {
+		ufbxi_os_queue *victim = &os->queues[(self + i) % os->num_queues];
+
+		ufbxi_os_range stolen = { 0, 0 };
+		pthread_mutex_lock(&victim->mutex);
+		ufbxi_os_range *range = &victim->ranges[group];
+		if (range->begin < range->end) {
+			uint64_t count = range->end - range->begin;
+			stolen.begin = range->end - (count + 1) / 2;
+			stolen.end = range->end;
+			range->end = stolen.begin;
+		}
+		pthread_mutex_unlock(&victim->mutex);
+		if (stolen.begin == stolen.end) continue;
+
+		// Our own range must be empty for `group` as we either popped it empty or
+		// are waiting for it, and the group cannot be re-run before we finish.
+		*p_index = stolen.begin++;
+		if (stolen.begin < stolen.end) {
+			ufbxi_os_queue *queue = &os->queues[self];
+			pthread_mutex_lock(&queue->mutex);
+			ufbx_assert(queue->ranges[group].begin == queue->ranges[group].end);
+			queue->ranges[group] = stolen;
+			pthread_mutex_unlock(&queue->mutex);
+		}
+		return true;
+	}
+	return false;
+}
+
+static void ufbxi_os_pool_finish(ufbxi_os_thread_pool *os, uint32_t group)
+{
+	ufbxi_os_group *g = &os->groups[group];
+	pthread_mutex_lock(&os->mutex);
+	if (++g->num_done == g->num_submitted) {
+		pthread_cond_broadcast(&os->done_cond);
+	}
+	pthread_mutex_unlock(&os->mutex);
+}
+
+static void *ufbxi_os_pool_thread_entry(void *user)
+{
+	ufbxi_os_worker *worker = (ufbxi_os_worker*)user;
+	ufbxi_os_thread_pool *os = worker->os;
+	uint32_t self = worker->queue;
+
+	for (;;) {
+		pthread_mutex_lock(&os->mutex);
+		uint64_t epoch = os->work_epoch;
+		bool stop = os->stop;
+		pthread_mutex_unlock(&os->mutex);
+		if (stop) break;
+
+		bool found = false;
+		for (uint32_t group = 0; group < UFBX_THREAD_GROUP_COUNT; group++) {
+			uint64_t index = 0;
+			while (ufbxi_os_pool_pop(&os->queues[self], group, &index) || ufbxi_os_pool_steal(os, self, group, &index)) {
+				ufbxi_thread_pool_execute(os->pool, (uint32_t)index);
+				ufbxi_os_pool_finish(os, group);
+				found = true;
+			}
+		}
+		if (found) continue;
+
+		pthread_mutex_lock(&os->mutex);
+		while (!os->stop && os->work_epoch == epoch) {
+			pthread_cond_wait(&os->work_cond, &os->mutex);
+		}
+		pthread_mutex_unlock(&os->mutex);
+	}
+
+	return NULL;
+}
+
+static bool ufbxi_os_pool_init(void *user, ufbx_thread_pool_context ctx, const ufbx_thread_pool_info *info)
+{
+	(void)info;
+	ufbxi_os_thread_pool *os = (ufbxi_os_thread_pool*)user;
+	os->pool = (ufbxi_thread_pool*)ctx;
+
+	if (pthread_mutex_init(&os->mutex, NULL) != 0) return false;
+	if (pthread_cond_init(&os->work_cond, NULL) != 0) {
+		pthread_mutex_destroy(&os->mutex);
+		return false;
+	}
+	if (pthread_cond_init(&os->done_cond, NULL) != 0) {
+		pthread_cond_destroy(&os->work_cond);
+		pthread_mutex_destroy(&os->mutex);
+		return false;
+	}
+	os->initialized = true;
+
+	for (uint32_t i = 0; i < os->num_queues; i++) {
+		if (pthread_mutex_init(&os->queues[i].mutex, NULL) != 0) return false;
+		os->num_queues_initialized++;
+	}
+
+	// If we fail to start some of the threads the remaining ones (or the waiting
+	// thread itself) will steal the work so there is no need to fail here.
+	for (uint32_t i = 0; i < os->num_threads; i++) {
+		ufbxi_os_worker *worker = &os->workers[i];
+		worker->os = os;
+		worker->queue = i;
+		if (pthread_create(&worker->thread, NULL, &ufbxi_os_pool_thread_entry, worker) != 0) break;
+		os->num_started++;
+	}
+
+	return true;
+}
+
+static void ufbxi_os_pool_run(void *user, ufbx_thread_pool_context ctx, uint32_t group, uint32_t start_index, uint32_t count)
+{
+	(void)ctx;
+	ufbxi_os_thread_pool *os = (ufbxi_os_thread_pool*)user;
+
+	// Distribute the tasks only to queues that have an active owner.
+	uint32_t num_owners = os->num_started + 1;
+	uint64_t begin = start_index;
+	uint64_t end = begin + count;
+
+	pthread_mutex_lock(&os->mutex);
+	os->groups[group].num_submitted += count;
+	pthread_mutex_unlock(&os->mutex);
+
+	for (uint32_t i = 0; i < num_owners; i++) {
+		ufbxi_os_queue *queue = i < os->num_started ? &os->queues[i] : &os->queues[os->num_queues - 1];
+		uint64_t chunk_end = begin + (end - begin) / (num_owners - i);
+
+		pthread_mutex_lock(&queue->mutex);
+		ufbx_assert(queue->ranges[group].begin == queue->ranges[group].end);
+		queue->ranges[group].begin = begin;
+		queue->ranges[group].end = chunk_end;
+		pthread_mutex_unlock(&queue->mutex);
+
+		begin = chunk_end;
+	}
+
+	pthread_mutex_lock(&os->mutex);
+	os->work_epoch++;
+	pthread_cond_broadcast(&os->work_cond);
+	pthread_mutex_unlock(&os->mutex);
+}
+
+static void ufbxi_os_pool_wait(void *user, ufbx_thread_pool_context ctx, uint32_t group, uint32_t max_index)
+{
+	(void)ctx;
+	(void)max_index;
+	ufbxi_os_thread_pool *os = (ufbxi_os_thread_pool*)user;
+	ufbxi_os_group *g = &os->groups[group];
+	uint32_t self = os->num_queues - 1;
+
+	uint64_t index = 0;
+	while (ufbxi_os_pool_pop(&os->queues[self], group, &index) || ufbxi_os_pool_steal(os, self, group, &index)) {
+		ufbxi_thread_pool_execute(os->pool, (uint32_t)index);
+		ufbxi_os_pool_finish(os, group);
+	}
+
+	// Nothing left to steal, wait for the tasks in progress
+	pthread_mutex_lock(&os->mutex);
+	while (g->num_done != g->num_submitted) {
+		pthread_cond_wait(&os->done_cond, &os->mutex);
+	}
+	pthread_mutex_unlock(&os->mutex);
+}
+
+static void ufbxi_os_pool_free(void *user, ufbx_thread_pool_context ctx)
+{
+	(void)ctx;
+	ufbxi_os_thread_pool *os = (ufbxi_os_thread_pool*)user;
+	if (!os->initialized) return;
+
+	pthread_mutex_lock(&os->mutex);
+	os->stop = true;
+	pthread_cond_broadcast(&os->work_cond);
+	pthread_mutex_unlock(&os->mutex);
+
+	for (uint32_t i = 0; i < os->num_started; i++) {
+		pthread_join(os->workers[i].thread, NULL);
+	}
+
+	for (uint32_t i = 0; i < os->num_queues_initialized; i++) {
+		pthread_mutex_destroy(&os->queues[i].mutex);
+	}
+	pthread_cond_destroy(&os->done_cond);
+	pthread_cond_destroy(&os->work_cond);
+	pthread_mutex_destroy(&os->mutex);
+}
+
+static size_t ufbxi_os_pool_default_threads(void)
+{
+	long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	return num_cpus > 1 ? (size_t)num_cpus - 1 : 1;
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_os_pool_setup(ufbxi_thread_pool *pool, ufbx_error *error, ufbxi_allocator *ator, ufbx_thread_opts *opts)
+{
+	size_t num_threads = opts->num_threads;
+	if (num_threads == SIZE_MAX) {
+		num_threads = ufbxi_os_pool_default_threads();
+	}
+	num_threads = ufbxi_min_sz(num_threads, UFBXI_MAX_POOL_THREADS);
+
+	ufbxi_os_thread_pool *os = ufbxi_alloc(ator, ufbxi_os_thread_pool, 1);
+	ufbxi_check_err(error, os);
+	memset(os, 0, sizeof(ufbxi_os_thread_pool));
+	pool->os_pool = os;
+
+	os->workers = ufbxi_alloc(ator, ufbxi_os_worker, num_threads);
+	ufbxi_check_err(error, os->workers);
+	os->num_threads = (uint32_t)num_threads;
+
+	os->queues = ufbxi_alloc(ator, ufbxi_os_queue, num_threads + 1);
+	ufbxi_check_err(error, os->queues);
+	memset(os->queues, 0, sizeof(ufbxi_os_queue) * (num_threads + 1));
+	os->num_queues = (uint32_t)num_threads + 1;
+
+	opts->pool.init_fn = &ufbxi_os_pool_init;
+	opts->pool.run_fn = &ufbxi_os_pool_run;
+	opts->pool.wait_fn = &ufbxi_os_pool_wait;
+	opts->pool.free_fn = &ufbxi_os_pool_free;
+	opts->pool.user = os;
+
+	return 1;
+}
+
+static void ufbxi_os_pool_free_memory(ufbxi_thread_pool *pool)
+{
+	ufbxi_os_thread_pool *os = pool->os_pool;
+	if (!os) return;
+	ufbxi_free(pool->ator, ufbxi_os_queue, os->queues, os->num_queues);
+	ufbxi_free(pool->ator, ufbxi_os_worker, os->workers, os->num_threads);
+	ufbxi_free(pool->ator, ufbxi_os_thread_pool, os, 1);
+	pool->os_pool = NULL;
+}
+
+#endif
+
+ufbxi_noinline static void ufbxi_thread_pool_update_finished(ufbxi_thread_pool *pool, uint64_t max_index)
 {
 	while (pool->wait_index < max_index) {
-		ufbxi_task_imp *task = &pool->tasks[pool->wait_index % pool->num_tasks];
+		ufbxi_task_imp *task = &pool->tasks[pool->wait_index & (pool->num_tasks - 1)];
 		if (!pool->failed && task->task.error) {
 			pool->failed = true;
 			pool->error_desc = task->task.error;
 		}
+		pool->task_cpu_time += task->cpu_time;
 		pool->wait_index += 1;
 	}
 }
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_thread_pool_wait_imp(ufbxi_thread_pool *pool, uint32_t group, bool can_fail)
 {
-	uint32_t max_index = pool->groups[group].max_index;
+	uint64_t max_index = pool->groups[group].max_index;
 
 	if (pool->groups[group].wait_index < max_index) {
-		pool->opts.pool.wait_fn(pool->opts.pool.user, (ufbx_thread_pool_context)pool, group, max_index);
+		pool->opts.pool.wait_fn(pool->opts.pool.user, (ufbx_thread_pool_context)pool, group, (uint32_t)max_index);
 		pool->groups[group].wait_index = max_index;
 	}
 	ufbxi_thread_pool_update_finished(pool, max_index);
@@ -6080,24 +6946,42 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_thread_pool_wait_all(ufbxi_threa
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_thread_pool_init(ufbxi_thread_pool *pool, ufbx_error *error, ufbxi_allocator *ator, const ufbx_thread_opts *opts)
 {
-	if (!(opts->pool.run_fn && opts->pool.wait_fn)) return 1;
-	pool->enabled = true;
+	pool->ator = ator;
+	pool->error = error;
+	pool->opts = *opts;
 
-	uint32_t num_tasks = (uint32_t)ufbxi_min_sz(opts->num_tasks, INT32_MAX);
-	if (num_tasks == 0) {
-		num_tasks = 2048;
+	if (!(opts->pool.run_fn && opts->pool.wait_fn)) {
+		#if UFBXI_HAS_PTHREADS
+			if (opts->num_threads == 0) return 1;
+			ufbxi_check_err(error, ufbxi_os_pool_setup(pool, error, ator, &pool->opts));
+		#else
+			return 1;
+		#endif
 	}
 
-	pool->opts = *opts;
+	size_t max_tasks = ufbxi_min_sz(opts->num_tasks, INT32_MAX);
+	if (max_tasks == 0) {
+		max_tasks = 2048;
+	}
+	uint32_t num_tasks = 1;
+	while (num_tasks < max_tasks) {
+		num_tasks *= 2;
+	}
+
+	// The built-in pool uses the whole ring, user pools get exactly what they asked for.
+	if (pool->os_pool) {
+		max_tasks = num_tasks;
+	}
+
+	pool->enabled = true;
 	if (pool->opts.pool.init_fn) {
 		ufbx_thread_pool_info info; // ufbxi_uninit
-		info.max_concurrent_tasks = num_tasks;
+		info.max_concurrent_tasks = (uint32_t)max_tasks;
 		ufbxi_check_err(error, pool->opts.pool.init_fn(pool->opts.pool.user, (ufbx_thread_pool_context)pool, &info));
 	}
-	pool->ator = ator;
-	pool->error = error;
 
 	pool->num_tasks = num_tasks;
+	pool->max_tasks = (uint32_t)max_tasks;
 	pool->tasks = ufbxi_alloc(ator, ufbxi_task_imp, num_tasks);
 	ufbxi_check_err(error, pool->tasks);
 
@@ -6106,34 +6990,38 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_thread_pool_init(ufbxi_thread_po
 
 ufbxi_noinline static void ufbxi_thread_pool_free(ufbxi_thread_pool *pool)
 {
-	if (!pool->enabled) return;
+	if (pool->enabled) {
+		// Wait for all pending tasks
+		for (uint32_t i = 0; i < UFBX_THREAD_GROUP_COUNT; i++) {
+			pool->group = (pool->group + 1) % UFBX_THREAD_GROUP_COUNT;
+			ufbxi_ignore(ufbxi_thread_pool_wait_imp(pool, pool->group, false));
+		}
 
-	// Wait for all pending tasks
-	for (uint32_t i = 0; i < UFBX_THREAD_GROUP_COUNT; i++) {
-		pool->group = (pool->group + 1) % UFBX_THREAD_GROUP_COUNT;
-		ufbxi_ignore(ufbxi_thread_pool_wait_imp(pool, pool->group, false));
-	}
+		if (pool->opts.pool.free_fn) {
+			pool->opts.pool.free_fn(pool->opts.pool.user, (ufbx_thread_pool_context)pool);
+		}
 
-	if (pool->opts.pool.free_fn) {
-		pool->opts.pool.free_fn(pool->opts.pool.user, (ufbx_thread_pool_context)pool);
+		ufbxi_free(pool->ator, ufbxi_task_imp, pool->tasks, pool->num_tasks);
 	}
 
-	ufbxi_free(pool->ator, ufbxi_task_imp, pool->tasks, pool->num_tasks);
+	#if UFBXI_HAS_PTHREADS
+		ufbxi_os_pool_free_memory(pool);
+	#endif
 }
 
 ufbxi_nodiscard ufbxi_noinline static uint32_t ufbxi_thread_pool_available_tasks(ufbxi_thread_pool *pool)
 {
-	return pool->num_tasks - (pool->start_index - pool->wait_index);
+	return pool->max_tasks - (uint32_t)(pool->start_index - pool->wait_index);
 }
 
 ufbxi_noinline static void ufbxi_thread_pool_flush_group(ufbxi_thread_pool *pool)
 {
 	uint32_t group = pool->group;
-	uint32_t start_index = pool->execute_index;
-	uint32_t count = pool->start_index - start_index;
+	uint64_t start_index = pool->execute_index;
+	uint32_t count = (uint32_t)(pool->start_index - start_index);
 	if (count > 0) {
 		if (pool->opts.pool.run_fn) {
-			pool->opts.pool.run_fn(pool->opts.pool.user, (ufbx_thread_pool_context)pool, group, start_index, count);
+			pool->opts.pool.run_fn(pool->opts.pool.user, (ufbx_thread_pool_context)pool, group, (uint32_t)start_index, count);
 		}
 		pool->groups[group].max_index = start_index + count;
 		pool->execute_index = start_index + count;
@@ -6141,25 +7029,42 @@ ufbxi_noinline static void ufbxi_thread_pool_flush_group(ufbxi_thread_pool *pool
 	pool->group = (group + 1) % UFBX_THREAD_GROUP_COUNT;
 }
 
-ufbxi_nodiscard ufbxi_noinline static ufbxi_task *ufbxi_thread_pool_create_task(ufbxi_thread_pool *pool, ufbxi_task_fn *fn)
+// Make room for new tasks if the task ring is full without blocking.
+// The ring can be grown only if we own the thread pool and there are no submitted
+// tasks that may still be running, otherwise the caller runs the task serially.
+// User pools are limited to `max_tasks`.
+ufbxi_noinline static bool ufbxi_thread_pool_make_room(ufbxi_thread_pool *pool)
 {
-	uint32_t index = pool->start_index;
-	if (index - pool->wait_index >= pool->num_tasks) {
-		if (index - pool->wait_index >= pool->num_tasks) {
-			// No space left
-			return NULL;
-		}
-	} else if (index == INT32_MAX) {
-		// TODO: Expand to 64 bits if possible?
-		return NULL;
+	if (!pool->os_pool || pool->num_tasks >= (UINT32_C(1) << 30)) return false;
+	if (pool->execute_index != pool->wait_index) return false;
+
+	// No tasks have been submitted since the last wait so the pending tasks in
+	// `[execute_index, start_index)` are only referenced by us.
+	uint32_t num_tasks = pool->num_tasks * 2;
+	ufbxi_task_imp *tasks = ufbxi_alloc(pool->ator, ufbxi_task_imp, num_tasks);
+	if (!tasks) return false;
+	for (uint64_t index = pool->execute_index; index < pool->start_index; index++) {
+		tasks[index & (num_tasks - 1)] = pool->tasks[index & (pool->num_tasks - 1)];
 	}
+	ufbxi_free(pool->ator, ufbxi_task_imp, pool->tasks, pool->num_tasks);
+	pool->tasks = tasks;
+	pool->num_tasks = num_tasks;
+	pool->max_tasks = num_tasks;
+	return true;
+}
 
-	ufbxi_task_imp *imp = &pool->tasks[index % pool->num_tasks];
-	if (index < pool->num_tasks) {
-		memset(imp, 0, sizeof(ufbxi_task_imp));
+ufbxi_nodiscard ufbxi_noinline static ufbxi_task *ufbxi_thread_pool_create_task(ufbxi_thread_pool *pool, ufbxi_task_fn *fn)
+{
+	if (pool->start_index - pool->wait_index >= pool->max_tasks) {
+		// No space left, run serially
+		if (!ufbxi_thread_pool_make_room(pool)) return NULL;
 	}
 
+	ufbxi_task_imp *imp = &pool->tasks[pool->start_index & (pool->num_tasks - 1)];
+	imp->task.data = NULL;
+	imp->task.error = NULL;
 	imp->fn = fn;
+	imp->cpu_time = 0.0;
 
 	return &imp->task;
 }
@@ -6167,8 +7072,8 @@ ufbxi_nodiscard ufbxi_noinline static ufbxi_task *ufbxi_thread_pool_create_task(
 static void ufbxi_thread_pool_run_task(ufbxi_thread_pool *pool, ufbxi_task *task)
 {
 	(void)task;
-	uint32_t index = pool->start_index;
-	ufbx_assert(task == &pool->tasks[index % pool->num_tasks].task);
+	uint64_t index = pool->start_index;
+	ufbx_assert(task == &pool->tasks[index & (pool->num_tasks - 1)].task);
 	pool->start_index = index + 1;
 }
 
@@ -6198,6 +7103,7 @@ struct ufbxi_node {
 	const char *name;      // < Name of the node (pooled, compare with == to ufbxi_* strings)
 	uint32_t num_children; // < Number of child nodes
 	uint8_t name_len;      // < Length of `name` in bytes
+	uint8_t filter;        // < `ufbx_element_filter_result` of the containing object
 
 	// If `value_type_mask == UFBXI_PROP_ARRAY` then the node is an array
 	// (`array` field is valid) otherwise the node has N values in `vals`
@@ -6231,12 +7137,31 @@ static ufbxi_noinline void ufbxi_retain_ref(ufbxi_refcount *refcount);
 
 #define ufbxi_get_imp(type, ptr) ((type*)((char*)ptr - sizeof(ufbxi_refcount)))
 
+// Mesh with content deferred by `ufbx_load_opts.lazy_geometry`, `index` is the
+// ordinal of the object among the deferred objects in the file and `size` the
+// distance in bytes from its start to the next deferred mesh (or end of input).
+typedef struct {
+	uint32_t element_id;
+	uint32_t index;
+	uint64_t size;
+} ufbxi_lazy_mesh;
+
 typedef struct {
 	ufbxi_refcount refcount;
 	ufbx_scene scene;
 	uint32_t magic;
 
 	ufbxi_buf string_buf;
+
+	// Retained for `ufbx_load_mesh_geometry()`, sorted by `element_id`
+	ufbxi_lazy_mesh *lazy_meshes;
+	size_t num_lazy_meshes;
+	const char *lazy_data;
+	size_t lazy_size;
+	ufbx_load_opts lazy_opts;
+
+	// Compared when loading snapshots, see `ufbx_load_scene_snapshot()`
+	uint64_t opts_hash;
 } ufbxi_scene_imp;
 
 ufbx_static_assert(scene_imp_offset, offsetof(ufbxi_scene_imp, scene) == sizeof(ufbxi_refcount));
@@ -6249,6 +7174,21 @@ typedef struct {
 
 ufbx_static_assert(mesh_imp_offset, offsetof(ufbxi_mesh_imp, mesh) == sizeof(ufbxi_refcount));
 
+typedef struct {
+	ufbxi_refcount refcount;
+	ufbx_probe_info info;
+	uint32_t magic;
+
+	ufbxi_buf string_buf;
+} ufbxi_probe_imp;
+
+ufbx_static_assert(probe_imp_offset, offsetof(ufbxi_probe_imp, info) == sizeof(ufbxi_refcount));
+
+typedef struct {
+	ufbx_probe_anim_stack stack;
+	bool has_props;
+} ufbxi_probe_stack;
+
 typedef struct {
 	// Semantic string data and length eg. for a string token
 	// this string doesn't include the quotes.
@@ -6398,6 +7338,15 @@ typedef struct {
 	size_t num_left;
 } ufbxi_obj_fast_indices;
 
+// Vertex line whose values are parsed in a task, `src` spans from the first
+// to the last value token.
+typedef struct {
+	ufbx_real *dst;
+	const char *src;
+	uint32_t src_length;
+	uint32_t num_values;
+} ufbxi_obj_vertex_line;
+
 // Temporary pointer to a `ufbx_anim_stack` by name used to patch start/stop
 // time from "Takes" if necessary.
 typedef struct {
@@ -6434,6 +7383,12 @@ typedef struct {
 	ufbxi_buf tmp_meshes;
 	ufbxi_buf tmp_props;
 
+	// Threaded vertex parsing, lines are batched to `tmp_vertex_lines` and parsed in
+	// tasks, the source and task data are stored in `ufbxi_context.tmp_thread_parse[]`.
+	bool defer_vertices;
+	ufbxi_buf tmp_vertex_lines;
+	uint32_t num_group_vertex_tasks;
+
 	ufbxi_map group_map;
 
 	size_t read_progress;
@@ -6489,6 +7444,10 @@ typedef struct {
 
 	// IO
 	uint64_t data_offset;
+
+	// `ufbx_element_filter_result` of the object currently being parsed
+	uint8_t parse_filter;
+	bool filter_objects;
 	ufbx_read_fn *read_fn;
 	ufbx_skip_fn *skip_fn;
 	void *read_user;
@@ -6546,6 +7505,12 @@ typedef struct {
 	ufbxi_buf tmp_element_id;
 	ufbxi_buf tmp_ascii_spans;
 	ufbxi_buf tmp_thread_parse[UFBX_THREAD_GROUP_COUNT];
+	ufbxi_buf tmp_probe_node_names;
+	ufbxi_buf tmp_probe_mesh_names;
+	ufbxi_buf tmp_probe_material_names;
+	ufbxi_buf tmp_probe_stacks;
+	ufbxi_buf tmp_lazy_meshes;
+	ufbxi_buf tmp_lazy_offsets;
 	size_t tmp_element_byte_offset;
 
 	ufbxi_template *templates;
@@ -6584,6 +7549,14 @@ typedef struct {
 	uint64_t latest_progress_bytes;
 	size_t progress_interval;
 
+	// `ufbx_load_opts.collect_load_stats`: Time since `stats_wall/cpu_time` is accumulated
+	// to `stats_phase` when switching phases, see `ufbxi_enter_phase()`.
+	bool collect_stats;
+	ufbx_load_phase stats_phase;
+	double stats_wall_time;
+	double stats_cpu_time;
+	ufbx_load_stats stats;
+
 	// Extra data on the side of elements
 	void **element_extra_arr;
 	size_t element_extra_cap;
@@ -6611,6 +7584,38 @@ typedef struct {
 	ufbx_scene scene;
 	ufbxi_scene_imp *scene_imp;
 
+	// Hash of the user options, see `ufbxi_hash_load_opts()`
+	uint64_t opts_hash;
+
+	// `ufbx_probe_*()`: Only summarize the object headers to `probe_info`
+	bool probe;
+	ufbx_probe_info probe_info;
+	ufbxi_probe_imp *probe_imp;
+
+	// `ufbx_load_opts.lazy_geometry`: Objects are counted in `ufbxi_filter_object()`,
+	// when reloading with `lazy_reload` only the objects in `[lazy_target, lazy_target_end)`
+	// are loaded. The input offset of each deferred object is pushed to `tmp_lazy_offsets`.
+	bool lazy_geometry;
+	bool lazy_reload;
+	const char *lazy_data;
+	size_t lazy_size;
+	uint32_t lazy_target;
+	uint32_t lazy_target_end;
+	uint32_t lazy_filter_count;
+	uint32_t lazy_read_count;
+	uint32_t lazy_index;
+
+	// `ufbx_load_begin()`: `read_fn` returns only data fed so far, running out of data
+	// is not EOF while `feeding`. Complete top-level nodes are parsed in `ufbxi_feed_parse()`
+	// with the current node `feed_top_index` collecting `feed_num_children` on `tmp_stack`.
+	bool feeding;
+	bool feed_initialized;
+	bool feed_parse_begun;
+	bool feed_parsed_to_end;
+	uint64_t feed_size;
+	size_t feed_top_index;
+	uint32_t feed_num_children;
+
 	ufbx_inflate_retain *inflate_retain;
 
 	// Per-mesh consecutive indices used by `ufbxi_flip_winding()`.
@@ -6642,6 +7647,25 @@ typedef struct {
 	const char *load_filename;
 	size_t load_filename_len;
 
+	// Shared state of a batch load, see `ufbx_load_files()`
+	ufbxi_memory_budget *memory_budget;
+	ufbxi_map *shared_strings;
+
+	// Memory mapped main file, see `ufbx_load_opts.map_main_file`
+	const void *map_data;
+	size_t map_size;
+
+	// `UFBXI_ARRAY_FLAG_BORROW` or zero for each class of arrays that may reference
+	// the input buffer directly, see `ufbx_load_opts.borrow_input_arrays`.
+	uint8_t borrow_data;     // < Read-only data: UVs, colors, weights, etc.
+	uint8_t borrow_indices;  // < Vertex attribute indices, modified when flipping winding
+	uint8_t borrow_geometry; // < Positions, modified by geometry scale/transform/mirroring
+	uint8_t borrow_normals;  // < Normals/tangents, additionally modified by normalization
+
+	// `UFBXI_ARRAY_FLAG_RESULT` for vertex attribute values, or `UFBXI_ARRAY_FLAG_TMP_BUF` if
+	// they are converted to `float` before returning, see `ufbx_load_opts.float_geometry`.
+	uint8_t vertex_values;
+
 	bool parse_threaded;
 	ufbxi_thread_pool thread_pool;
 
@@ -6711,6 +7735,77 @@ ufbxi_unused ufbxi_nodiscard static ufbxi_forceinline int ufbxi_progress(ufbxi_c
 	return ufbxi_report_progress(uc);
 }
 
+// -- Load statistics
+
+static ufbxi_noinline double ufbxi_read_clock(const ufbx_clock_cb *clock_cb, bool cpu_time)
+{
+	if (clock_cb->fn) {
+		return clock_cb->fn(clock_cb->user, cpu_time);
+	}
+
+#if UFBXI_HAS_CLOCK
+	#if defined(CLOCK_THREAD_CPUTIME_ID)
+		clockid_t cpu_clock = CLOCK_THREAD_CPUTIME_ID;
+	#else
+		clockid_t cpu_clock = CLOCK_PROCESS_CPUTIME_ID;
+	#endif
+	struct timespec ts; // ufbxi_uninit
+	if (clock_gettime(cpu_time ? cpu_clock : CLOCK_MONOTONIC, &ts) == 0) {
+		return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+	}
+#endif
+
+	return 0.0;
+}
+
+// CPU time includes tasks finished on other threads, see `ufbxi_thread_pool.task_cpu_time`.
+static ufbxi_forceinline double ufbxi_clock(ufbxi_context *uc, bool cpu_time)
+{
+	double time = ufbxi_read_clock(&uc->opts.clock_cb, cpu_time);
+	if (cpu_time) time += uc->thread_pool.task_cpu_time;
+	return time;
+}
+
+// Add the time since the last update to the current phase
+static ufbxi_noinline void ufbxi_update_phase_time(ufbxi_context *uc)
+{
+	double wall_time = ufbxi_clock(uc, false);
+	double cpu_time = ufbxi_clock(uc, true);
+
+	ufbx_load_phase_stats *stats = &uc->stats.phases[uc->stats_phase];
+	stats->wall_time += wall_time - uc->stats_wall_time;
+	stats->cpu_time += cpu_time - uc->stats_cpu_time;
+
+	uc->stats_wall_time = wall_time;
+	uc->stats_cpu_time = cpu_time;
+}
+
+static ufbxi_noinline void ufbxi_switch_phase(ufbxi_context *uc, ufbx_load_phase phase, bool enter)
+{
+	ufbxi_update_phase_time(uc);
+	uc->stats_phase = phase;
+	if (enter) {
+		uc->stats.phases[phase].count++;
+	}
+}
+
+// Attribute time to `phase` until `ufbxi_leave_phase()` is called with the returned phase.
+static ufbxi_forceinline ufbx_load_phase ufbxi_enter_phase(ufbxi_context *uc, ufbx_load_phase phase)
+{
+	ufbx_load_phase prev = uc->stats_phase;
+	if (uc->collect_stats && phase != prev) {
+		ufbxi_switch_phase(uc, phase, true);
+	}
+	return prev;
+}
+
+static ufbxi_forceinline void ufbxi_leave_phase(ufbxi_context *uc, ufbx_load_phase prev)
+{
+	if (uc->collect_stats && prev != uc->stats_phase) {
+		ufbxi_switch_phase(uc, prev, false);
+	}
+}
+
 // -- IO
 
 static ufbxi_noinline const char *ufbxi_refill(ufbxi_context *uc, size_t size, bool require_size)
@@ -6754,17 +7849,22 @@ static ufbxi_noinline const char *ufbxi_refill(ufbxi_context *uc, size_t size, b
 
 	// Fill the rest of the buffer with user data
 	size_t data_capacity = uc->read_buffer_size;
+	ufbx_load_phase prev_phase = ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_IO);
 	while (data_size < data_capacity) {
 		size_t to_read = data_capacity - data_size;
 		size_t read_result = uc->read_fn(uc->read_user, uc->read_buffer + data_size, to_read);
 		ufbxi_check_return_msg(read_result != SIZE_MAX, NULL, "IO error");
 		ufbxi_check_return(read_result <= to_read, NULL);
 		data_size += read_result;
+		uc->stats.bytes_read += read_result;
 		if (read_result == 0) {
+			// More data may be fed later, see `ufbx_load_feed()`
+			if (uc->feeding) break;
 			uc->eof = true;
 			break;
 		}
 	}
+	ufbxi_leave_phase(uc, prev_phase);
 
 	if (require_size) {
 		if (uc->data_offset == 0) {
@@ -6859,6 +7959,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_skip_bytes(ufbxi_context *uc, ui
 			uc->data_size = 0;
 
 			uc->data_offset += size;
+			ufbx_load_phase prev_phase = ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_IO);
 			while (size >= UFBXI_MAX_SKIP_SIZE) {
 				size -= UFBXI_MAX_SKIP_SIZE;
 				ufbxi_check_msg(uc->skip_fn(uc->read_user, UFBXI_MAX_SKIP_SIZE - 1), "Truncated file");
@@ -6875,6 +7976,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_skip_bytes(ufbxi_context *uc, ui
 			if (size > 0) {
 				ufbxi_check_msg(uc->skip_fn(uc->read_user, (size_t)size), "Truncated file");
 			}
+			ufbxi_leave_phase(uc, prev_phase);
 
 		} else {
 			uc->data += (size_t)size;
@@ -6917,6 +8019,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_read_to(ufbxi_context *uc, void
 		uc->data_size = 0;
 		ufbxi_check(uc->read_fn);
 
+		ufbx_load_phase prev_phase = ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_IO);
 		while (size > 0) {
 			size_t read_result = uc->read_fn(uc->read_user, ptr, size);
 			ufbxi_check_msg(read_result != SIZE_MAX, "IO error");
@@ -6925,7 +8028,9 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_read_to(ufbxi_context *uc, void
 			ptr += read_result;
 			size -= read_result;
 			uc->data_offset += read_result;
+			uc->stats.bytes_read += read_result;
 		}
+		ufbxi_leave_phase(uc, prev_phase);
 	}
 
 	ufbxi_check(ufbxi_resume_progress(uc));
@@ -6992,7 +8097,7 @@ static ufbxi_noinline void ufbxi_end_file_context(ufbxi_file_context *fc, ufbx_e
 
 #if !defined(UFBX_NO_STDIO) && !defined(UFBX_EXTERNAL_STDIO)
 
-static ufbxi_noinline FILE *ufbxi_fopen(ufbxi_file_context *fc, const char *path, size_t path_len, bool null_terminated)
+static ufbxi_noinline FILE *ufbxi_fopen(ufbxi_file_context *fc, const char *path, size_t path_len, bool null_terminated, bool write)
 {
 	FILE *file = NULL;
 #if !defined(UFBX_STANDARD_C) && defined(_WIN32)
@@ -7037,9 +8142,9 @@ static ufbxi_noinline FILE *ufbxi_fopen(ufbxi_file_context *fc, const char *path
 	wpath[wlen] = 0;
 
 	#if UFBXI_MSC_VER >= 1400
-		if (_wfopen_s(&file, wpath, L"rb") != 0) file = NULL;
+		if (_wfopen_s(&file, wpath, write ? L"wb" : L"rb") != 0) file = NULL;
 	#else
-		file = _wfopen(wpath, L"rb");
+		file = _wfopen(wpath, write ? L"wb" : L"rb");
 	#endif
 	if (wpath != wpath_buf) {
 		ufbxi_free(&fc->ator, wchar_t, wpath, path_len + 1);
@@ -7058,14 +8163,18 @@ static ufbxi_noinline FILE *ufbxi_fopen(ufbxi_file_context *fc, const char *path
 		memcpy(copy, path, path_len);
 		copy[path_len] = '\0';
 	}
-	file = fopen(copy, "rb");
+	file = fopen(copy, write ? "wb" : "rb");
 	if (!null_terminated && copy != copy_buf) {
 		ufbxi_free(&fc->ator, char, copy, path_len + 1);
 	}
 #endif
 	if (!file) {
 		ufbxi_set_err_info(&fc->error, path, path_len);
-		ufbxi_report_err_msg(&fc->error, "file", "File not found");
+		if (write) {
+			ufbxi_report_err_msg(&fc->error, "file", "IO error");
+		} else {
+			ufbxi_report_err_msg(&fc->error, "file", "File not found");
+		}
 	}
 	return file;
 }
@@ -7140,12 +8249,67 @@ static ufbxi_noinline void ufbxi_stdio_init(ufbx_stream *stream, void *file, boo
 
 static ufbxi_noinline bool ufbxi_stdio_open(ufbxi_file_context *fc, ufbx_stream *stream, const char *path, size_t path_len, bool null_terminated)
 {
-	FILE *file = ufbxi_fopen(fc, path, path_len, null_terminated);
+	FILE *file = ufbxi_fopen(fc, path, path_len, null_terminated, false);
 	if (!file) return false;
 	ufbxi_stdio_init(stream, file, true);
 	return true;
 }
 
+#if UFBXI_HAS_MMAP
+
+// Map a whole file to memory for reading, returns `false` if the file cannot be
+// mapped in which case the caller should fall back to normal file IO.
+static ufbxi_noinline bool ufbxi_mmap_open(ufbxi_allocator *ator, const char *path, size_t path_len, bool null_terminated, const void **p_data, size_t *p_size)
+{
+	char copy_buf[256], *copy = NULL; // ufbxi_uninit
+	if (null_terminated) {
+		copy = (char*)path;
+	} else {
+		if (path_len < ufbxi_arraycount(copy_buf) - 1) {
+			copy = copy_buf;
+		} else {
+			copy = ufbxi_alloc(ator, char, path_len + 1);
+			if (!copy) return false;
+		}
+		memcpy(copy, path, path_len);
+		copy[path_len] = '\0';
+	}
+	int fd = open(copy, O_RDONLY);
+	if (!null_terminated && copy != copy_buf) {
+		ufbxi_free(ator, char, copy, path_len + 1);
+	}
+	if (fd < 0) return false;
+
+	bool ok = false;
+	struct stat st; // ufbxi_uninit
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && (uint64_t)st.st_size <= SIZE_MAX) {
+		size_t size = (size_t)st.st_size;
+		void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED) {
+			// Hint that we're going to read the file front to back, this is only
+			// advisory so ignore the result.
+			#if defined(MADV_SEQUENTIAL)
+				ufbxi_ignore(madvise(data, size, MADV_SEQUENTIAL));
+			#elif defined(POSIX_MADV_SEQUENTIAL)
+				ufbxi_ignore(posix_madvise(data, size, POSIX_MADV_SEQUENTIAL));
+			#endif
+			*p_data = data;
+			*p_size = size;
+			ok = true;
+		}
+	}
+	close(fd);
+
+	return ok;
+}
+
+static ufbxi_noinline void ufbxi_mmap_close(const void *data, size_t size)
+{
+	munmap((void*)data, size);
+}
+
+#endif
+
 #elif defined(UFBX_EXTERNAL_STDIO)
 
 static ufbxi_noinline void ufbxi_stdio_init(ufbx_stream *stream, void *file, bool close)
@@ -7972,6 +9136,7 @@ typedef enum {
 	UFBXI_ARRAY_FLAG_TMP_BUF      = 0x2, // < Allocate the array from the long-term temporary buffer
 	UFBXI_ARRAY_FLAG_PAD_BEGIN    = 0x4, // < Pad the begin of the array with 4 zero elements to guard from invalid -1 index accesses
 	UFBXI_ARRAY_FLAG_ACCURATE_F32 = 0x8, // < Must be parsed as bit-accurate 32-bit floats
+	UFBXI_ARRAY_FLAG_BORROW       = 0x10, // < May reference the input buffer directly, see `ufbx_load_opts.borrow_input_arrays`
 } ufbxi_array_flags;
 
 typedef struct {
@@ -8093,6 +9258,12 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 {
 	info->flags = 0;
 
+	// Objects filtered by `ufbx_load_opts.element_filter_cb` ignore all content
+	bool filtered = uc->parse_filter != UFBX_ELEMENT_FILTER_LOAD;
+	bool ignore_geometry = uc->opts.ignore_geometry || filtered;
+	bool ignore_animation = uc->opts.ignore_animation || filtered;
+	bool ignore_embedded = uc->opts.ignore_embedded || filtered;
+
 	// Retain all arrays if user wants the DOM representation
 	if (uc->opts.retain_dom) {
 		info->flags |= UFBXI_ARRAY_FLAG_RESULT;
@@ -8103,7 +9274,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 	case UFBXI_PARSE_THUMBNAIL:
 		if (name == ufbxi_ImageData) {
 			info->type = 'c';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_data);
 			return true;
 		}
 		break;
@@ -8111,62 +9282,62 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 	case UFBXI_PARSE_GEOMETRY:
 	case UFBXI_PARSE_MODEL:
 		if (name == ufbxi_Vertices) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(uc->vertex_values | UFBXI_ARRAY_FLAG_PAD_BEGIN | uc->borrow_geometry);
 			return true;
 		} else if (name == ufbxi_PolygonVertexIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = ignore_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_Edges) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = ignore_geometry ? '-' : 'i';
 			return true;
 		} else if (name == ufbxi_Indexes) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = ignore_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_Points) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_geometry);
 			return true;
 		} else if (name == ufbxi_KnotVector) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_data);
 			return true;
 		} else if (name == ufbxi_KnotVectorU) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_data);
 			return true;
 		} else if (name == ufbxi_KnotVectorV) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_data);
 			return true;
 		} else if (name == ufbxi_PointsIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = ignore_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_Normals) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(uc->vertex_values | UFBXI_ARRAY_FLAG_PAD_BEGIN | uc->borrow_normals);
 			return true;
 		}
 		break;
 
 	case UFBXI_PARSE_LEGACY_MODEL:
 		if (name == ufbxi_Vertices) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(uc->vertex_values | UFBXI_ARRAY_FLAG_PAD_BEGIN | uc->borrow_geometry);
 			return true;
 		} else if (name == ufbxi_Normals) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(uc->vertex_values | UFBXI_ARRAY_FLAG_PAD_BEGIN | uc->borrow_normals);
 			return true;
 		} else if (name == ufbxi_Materials) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = ignore_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_PolygonVertexIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = ignore_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_Children) {
@@ -8177,25 +9348,25 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_ANIMATION_CURVE:
 		if (name == ufbxi_KeyTime) {
-			info->type = uc->opts.ignore_animation ? '-' : 'l';
+			info->type = ignore_animation ? '-' : 'l';
 			return true;
 		} else if (name == ufbxi_KeyValueFloat) {
-			info->type = uc->opts.ignore_animation ? '-' : 'r';
+			info->type = ignore_animation ? '-' : 'r';
 			return true;
 		} else if (name == ufbxi_KeyAttrFlags) {
-			info->type = uc->opts.ignore_animation ? '-' : 'i';
+			info->type = ignore_animation ? '-' : 'i';
 			return true;
 		} else if (name == ufbxi_KeyAttrDataFloat) {
 			// The float data in a keyframe attribute array is represented as integers
 			// in versions >= 7200 as some of the elements aren't actually floats (!)
 			info->type = uc->from_ascii && uc->version >= 7200 ? 'i' : 'f';
-			if (uc->opts.ignore_animation) info->type = '-';
+			if (ignore_animation) info->type = '-';
 			if (uc->from_ascii && uc->version < 7200) {
 				info->flags |= UFBXI_ARRAY_FLAG_ACCURATE_F32;
 			}
 			return true;
 		} else if (name == ufbxi_KeyAttrRefCount) {
-			info->type = uc->opts.ignore_animation ? '-' : 'i';
+			info->type = ignore_animation ? '-' : 'i';
 			return true;
 		}
 		break;
@@ -8209,7 +9380,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_VIDEO:
 		if (name == ufbxi_Content) {
-			info->type = uc->opts.ignore_embedded ? '-' : 'C';
+			info->type = ignore_embedded ? '-' : 'C';
 			return true;
 		}
 		break;
@@ -8244,12 +9415,12 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_NORMAL:
 		if (name == ufbxi_Normals) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(uc->vertex_values | UFBXI_ARRAY_FLAG_PAD_BEGIN | uc->borrow_normals);
 			return true;
 		} else if (name == ufbxi_NormalsIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'i';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_indices);
 			return true;
 		} else if (name == ufbxi_NormalsW) {
 			info->type = uc->retain_vertex_w ? 'r' : '-';
@@ -8260,12 +9431,12 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_BINORMAL:
 		if (name == ufbxi_Binormals) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(uc->vertex_values | UFBXI_ARRAY_FLAG_PAD_BEGIN | uc->borrow_normals);
 			return true;
 		} else if (name == ufbxi_BinormalsIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'i';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_indices);
 			return true;
 		} else if (name == ufbxi_BinormalsW) {
 			info->type = uc->retain_vertex_w ? 'r' : '-';
@@ -8276,12 +9447,12 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_TANGENT:
 		if (name == ufbxi_Tangents) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(uc->vertex_values | UFBXI_ARRAY_FLAG_PAD_BEGIN | uc->borrow_normals);
 			return true;
 		} else if (name == ufbxi_TangentsIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'i';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_indices);
 			return true;
 		} else if (name == ufbxi_TangentsW) {
 			info->type = uc->retain_vertex_w ? 'r' : '-';
@@ -8292,51 +9463,51 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_UV:
 		if (name == ufbxi_UV) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(uc->vertex_values | UFBXI_ARRAY_FLAG_PAD_BEGIN | uc->borrow_data);
 			return true;
 		} else if (name == ufbxi_UVIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'i';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_indices);
 			return true;
 		}
 		break;
 
 	case UFBXI_PARSE_LAYER_ELEMENT_COLOR:
 		if (name == ufbxi_Colors) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(uc->vertex_values | UFBXI_ARRAY_FLAG_PAD_BEGIN | uc->borrow_data);
 			return true;
 		} else if (name == ufbxi_ColorIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'i';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_indices);
 			return true;
 		}
 		break;
 
 	case UFBXI_PARSE_LAYER_ELEMENT_VERTEX_CREASE:
 		if (name == ufbxi_VertexCrease) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN | uc->borrow_data);
 			return true;
 		} else if (name == ufbxi_VertexCreaseIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'i';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_indices);
 			return true;
 		}
 		break;
 
 	case UFBXI_PARSE_LAYER_ELEMENT_EDGE_CREASE:
 		if (name == ufbxi_EdgeCrease) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_data);
 			return true;
 		}
 		break;
 
 	case UFBXI_PARSE_LAYER_ELEMENT_SMOOTHING:
 		if (name == ufbxi_Smoothing) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'b';
+			info->type = ignore_geometry ? '-' : 'b';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -8344,7 +9515,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_VISIBILITY:
 		if (name == ufbxi_Visibility) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'b';
+			info->type = ignore_geometry ? '-' : 'b';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -8352,7 +9523,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_POLYGON_GROUP:
 		if (name == ufbxi_PolygonGroup) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = ignore_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -8360,7 +9531,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_HOLE:
 		if (name == ufbxi_Hole) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'b';
+			info->type = ignore_geometry ? '-' : 'b';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -8368,7 +9539,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_MATERIAL:
 		if (name == ufbxi_Materials) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = ignore_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -8376,7 +9547,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_OTHER:
 		if (name == ufbxi_TextureId) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = ignore_geometry ? '-' : 'i';
 			info->flags |= UFBXI_ARRAY_FLAG_TMP_BUF;
 			return true;
 		} else if (name == ufbxi_UV) {
@@ -8390,11 +9561,11 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_GEOMETRY_UV_INFO:
 		if (name == ufbxi_TextureUV) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(uc->vertex_values | UFBXI_ARRAY_FLAG_PAD_BEGIN);
 			return true;
 		} else if (name == ufbxi_TextureUVVerticeIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = ignore_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		}
@@ -8402,18 +9573,18 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_SHAPE:
 		if (name == ufbxi_Indexes) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = ignore_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
 		if (name == ufbxi_Vertices) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(uc->vertex_values | UFBXI_ARRAY_FLAG_PAD_BEGIN);
 			return true;
 		}
 		if (name == ufbxi_Normals) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(uc->vertex_values | UFBXI_ARRAY_FLAG_PAD_BEGIN);
 			return true;
 		}
 		break;
@@ -8426,16 +9597,16 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 			info->type = 'r';
 			return true;
 		} else if (name == ufbxi_Indexes) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'i';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_data);
 			return true;
 		} else if (name == ufbxi_Weights) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_data);
 			return true;
 		} else if (name == ufbxi_BlendWeights) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_data);
 			return true;
 		} else if (name == ufbxi_FullWeights) {
 			info->type = 'r';
@@ -8462,12 +9633,12 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 			info->type = 'r';
 			return true;
 		} else if (name == ufbxi_Indexes) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'i';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_data);
 			return true;
 		} else if (name == ufbxi_Weights) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
-			info->flags = UFBXI_ARRAY_FLAG_RESULT;
+			info->type = ignore_geometry ? '-' : 'r';
+			info->flags = (uint8_t)(UFBXI_ARRAY_FLAG_RESULT | uc->borrow_data);
 			return true;
 		}
 		break;
@@ -8481,21 +9652,21 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_CHANNEL:
 		if (name == ufbxi_Key) {
-			info->type = uc->opts.ignore_animation ? '-' : 'd';
+			info->type = ignore_animation ? '-' : 'd';
 			return true;
 		}
 		break;
 
 	case UFBXI_PARSE_AUDIO:
 		if (name == ufbxi_Content) {
-			info->type = uc->opts.ignore_embedded ? '-' : 'C';
+			info->type = ignore_embedded ? '-' : 'C';
 			return true;
 		}
 		break;
 
 	default:
 		if (name == ufbxi_BinaryData) {
-			info->type = uc->opts.ignore_embedded ? '-' : 'C';
+			info->type = ignore_embedded ? '-' : 'C';
 			return true;
 		}
 		break;
@@ -8505,6 +9676,85 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 	return false;
 }
 
+// Internal `ufbxi_node.filter` value for objects deferred by `ufbx_load_opts.lazy_geometry`,
+// treated as `UFBX_ELEMENT_FILTER_STUB` apart from being recorded in `ufbxi_read_mesh()`.
+#define UFBXI_ELEMENT_FILTER_LAZY ((uint8_t)UFBX_ELEMENT_FILTER_RESULT_COUNT)
+
+// Objects that may contain mesh geometry, in 6x00 files meshes are stored directly in models
+// and the sub-type may be missing, see `ufbxi_read_synthetic_attribute()`.
+static ufbxi_noinline bool ufbxi_is_lazy_geometry_object(ufbxi_context *uc, const ufbxi_node *node, ufbx_string sub_type)
+{
+	bool is_mesh = sub_type.length == 4 && !memcmp(sub_type.data, "Mesh", 4);
+	if (uc->version >= 7000) {
+		return node->name == ufbxi_Geometry && is_mesh;
+	} else {
+		return node->name == ufbxi_Model && (is_mesh || sub_type.length == 0);
+	}
+}
+
+// Resolve `node->filter` for a child of `Objects` using `ufbx_load_opts.element_filter_cb`
+// and `ufbx_load_opts.lazy_geometry`. Called after parsing the values but before the children of `node`.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_filter_object(ufbxi_context *uc, ufbxi_node *node)
+{
+	ufbx_element_filter_info info = { 0 };
+	ufbx_string type_and_name;
+
+	// Objects without the usual header are passed through, see `ufbxi_read_object()`
+	if (uc->version >= 7000) {
+		if (!ufbxi_get_val3(node, "Lss", &info.fbx_id, &type_and_name, &info.fbx_sub_type)) return 1;
+	} else {
+		if (!ufbxi_get_val2(node, "ss", &type_and_name, &info.fbx_sub_type)) return 1;
+	}
+
+	info.fbx_type.data = node->name;
+	info.fbx_type.length = node->name_len;
+	if (info.fbx_sub_type.length > 3 && !memcmp(info.fbx_sub_type.data, "Fbx", 3)) {
+		info.fbx_sub_type.data += 3;
+		info.fbx_sub_type.length -= 3;
+	}
+
+	// Name and type are packed as Type::Name (ASCII) or Name\x00\x01Type (binary),
+	// see `ufbxi_split_type_and_name()`. Both names stay NULL-terminated without copying.
+	const char *sep = uc->from_ascii ? "::" : "\x00\x01";
+	info.name = type_and_name;
+	for (size_t i = 0; i + 2 <= type_and_name.length; i++) {
+		const char *ch = type_and_name.data + i;
+		if (ch[0] == sep[0] && ch[1] == sep[1]) {
+			if (uc->from_ascii) {
+				info.name.data = ch + 2;
+				info.name.length = type_and_name.length - i - 2;
+			} else {
+				info.name.length = i;
+			}
+			break;
+		}
+	}
+
+	uint8_t result = UFBX_ELEMENT_FILTER_LOAD;
+	if (uc->opts.element_filter_cb.fn) {
+		ufbx_element_filter_result user_result = uc->opts.element_filter_cb.fn(uc->opts.element_filter_cb.user, &info);
+		ufbxi_check_msg((uint32_t)user_result < UFBX_ELEMENT_FILTER_RESULT_COUNT, "Bad element filter result");
+		result = (uint8_t)user_result;
+	}
+
+	// Defer all geometry except for the object we are reloading, the ordinal
+	// is stable as long as the filter callback returns the same results.
+	if (uc->lazy_geometry && result == UFBX_ELEMENT_FILTER_LOAD && ufbxi_is_lazy_geometry_object(uc, node, info.fbx_sub_type)) {
+		uint32_t index = uc->lazy_filter_count++;
+		ufbxi_check(uc->lazy_filter_count > 0);
+		uint64_t *offset = ufbxi_push(&uc->tmp_lazy_offsets, uint64_t, 1);
+		ufbxi_check(offset);
+		*offset = ufbxi_get_read_offset(uc);
+		if (!uc->lazy_reload || index < uc->lazy_target || index >= uc->lazy_target_end) {
+			result = UFBXI_ELEMENT_FILTER_LAZY;
+		}
+	}
+
+	node->filter = result;
+
+	return 1;
+}
+
 static ufbxi_noinline bool ufbxi_is_raw_string(ufbxi_context *uc, ufbxi_parse_state parent, const char *name, size_t index)
 {
 	(void)index;
@@ -8606,17 +9856,34 @@ static ufbxi_noinline bool ufbxi_is_raw_string(ufbxi_context *uc, ufbxi_parse_st
 
 // -- Binary parsing
 
-ufbxi_nodiscard static ufbxi_noinline char *ufbxi_swap_endian(ufbxi_context *uc, const void *src, size_t count, size_t elem_size)
+// Reverse the bytes of `count` elements of `elem_size` from `src` to `dst`, the ranges must not overlap.
+static ufbxi_noinline void ufbxi_swap_endian_to(void *dst, const void *src, size_t count, size_t elem_size)
 {
 	ufbxi_dev_assert(elem_size > 1);
-	size_t total_size = count * elem_size;
-	ufbxi_check_return(!ufbxi_does_overflow(total_size, count, elem_size), NULL);
-	if (uc->swap_arr_size < total_size) {
-		ufbxi_check_return(ufbxi_grow_array(&uc->ator_tmp, &uc->swap_arr, &uc->swap_arr_size, total_size), NULL);
+	char *d = (char*)dst;
+	const char *s = (const char*)src;
+
+#if UFBXI_HAS_SSE
+	// Swap bytes within 16-bit words and then reverse the words within each element
+	if (elem_size >= 4) {
+		size_t num_vectors = count * elem_size / 16;
+		ufbxi_nounroll for (size_t i = 0; i < num_vectors; i++) {
+			__m128i v = _mm_loadu_si128((const __m128i*)s);
+			v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+			if (elem_size == 4) {
+				v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2,3,0,1));
+				v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2,3,0,1));
+			} else {
+				v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0,1,2,3));
+				v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0,1,2,3));
+			}
+			_mm_storeu_si128((__m128i*)d, v);
+			s += 16; d += 16;
+		}
+		count -= num_vectors * 16 / elem_size;
 	}
-	char *dst = uc->swap_arr, *d = dst;
+#endif
 
-	const char *s = (const char*)src;
 	switch (elem_size) {
 	case 2:
 		ufbxi_nounroll for (size_t i = 0; i < count; i++) {
@@ -8640,8 +9907,18 @@ ufbxi_nodiscard static ufbxi_noinline char *ufbxi_swap_endian(ufbxi_context *uc,
 	default:
 		ufbxi_unreachable("Bad endian swap size");
 	}
+}
 
-	return dst;
+ufbxi_nodiscard static ufbxi_noinline char *ufbxi_swap_endian(ufbxi_context *uc, const void *src, size_t count, size_t elem_size)
+{
+	ufbxi_dev_assert(elem_size > 1);
+	size_t total_size = count * elem_size;
+	ufbxi_check_return(!ufbxi_does_overflow(total_size, count, elem_size), NULL);
+	if (uc->swap_arr_size < total_size) {
+		ufbxi_check_return(ufbxi_grow_array(&uc->ator_tmp, &uc->swap_arr, &uc->swap_arr_size, total_size), NULL);
+	}
+	ufbxi_swap_endian_to(uc->swap_arr, src, count, elem_size);
+	return uc->swap_arr;
 }
 
 // Swap the endianness of an array typed with a lowercase letter
@@ -8667,6 +9944,60 @@ ufbxi_nodiscard static ufbxi_noinline const char *ufbxi_swap_endian_value(ufbxi_
 	}
 }
 
+#if UFBXI_HAS_SSE
+
+// Convert a prefix of an array using SSE2, returns the number of elements converted.
+// The results are identical to the scalar conversions in `ufbxi_binary_convert_array()`.
+static ufbxi_noinline size_t ufbxi_binary_convert_array_sse(char src_type, char dst_type, const void *src, void *dst, size_t size)
+{
+	const char *s = (const char*)src;
+	char *d = (char*)dst;
+	size_t num_vectors = size / 4;
+
+	if (src_type == 'd' && dst_type == 'f') {
+		ufbxi_nounroll for (size_t i = 0; i < num_vectors; i++) {
+			__m128 lo = _mm_cvtpd_ps(_mm_loadu_pd((const double*)s + 0));
+			__m128 hi = _mm_cvtpd_ps(_mm_loadu_pd((const double*)s + 2));
+			_mm_storeu_ps((float*)d, _mm_movelh_ps(lo, hi));
+			s += 32; d += 16;
+		}
+	} else if (src_type == 'f' && dst_type == 'd') {
+		ufbxi_nounroll for (size_t i = 0; i < num_vectors; i++) {
+			__m128 v = _mm_loadu_ps((const float*)s);
+			_mm_storeu_pd((double*)d + 0, _mm_cvtps_pd(v));
+			_mm_storeu_pd((double*)d + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+			s += 16; d += 32;
+		}
+	} else if (src_type == 'i' && dst_type == 'd') {
+		ufbxi_nounroll for (size_t i = 0; i < num_vectors; i++) {
+			__m128i v = _mm_loadu_si128((const __m128i*)s);
+			_mm_storeu_pd((double*)d + 0, _mm_cvtepi32_pd(v));
+			_mm_storeu_pd((double*)d + 2, _mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(1,0,3,2))));
+			s += 16; d += 32;
+		}
+	} else if (src_type == 'i' && dst_type == 'f') {
+		ufbxi_nounroll for (size_t i = 0; i < num_vectors; i++) {
+			__m128i v = _mm_loadu_si128((const __m128i*)s);
+			_mm_storeu_ps((float*)d, _mm_cvtepi32_ps(v));
+			s += 16; d += 16;
+		}
+	} else if (src_type == 'i' && dst_type == 'l') {
+		ufbxi_nounroll for (size_t i = 0; i < num_vectors; i++) {
+			__m128i v = _mm_loadu_si128((const __m128i*)s);
+			__m128i sign = _mm_srai_epi32(v, 31);
+			_mm_storeu_si128((__m128i*)d + 0, _mm_unpacklo_epi32(v, sign));
+			_mm_storeu_si128((__m128i*)d + 1, _mm_unpackhi_epi32(v, sign));
+			s += 16; d += 32;
+		}
+	} else {
+		return 0;
+	}
+
+	return num_vectors * 4;
+}
+
+#endif
+
 // Read and convert a post-7000 FBX data array into a different format. `src_type` may be equal to `dst_type`
 // if the platform is not binary compatible with the FBX data representation.
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_context *maybe_uc, char src_type, char dst_type, const void *src, void *dst, size_t size)
@@ -8686,6 +10017,15 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_conte
 		ufbxi_check_err(&maybe_uc->error, src);
 	}
 
+#if UFBXI_HAS_SSE
+	{
+		size_t num_converted = ufbxi_binary_convert_array_sse(src_type, dst_type, src, dst, size);
+		src = (const char*)src + num_converted * ufbxi_array_type_size(src_type);
+		dst = (char*)dst + num_converted * ufbxi_array_type_size(dst_type);
+		size -= num_converted;
+	}
+#endif
+
 	switch (dst_type)
 	{
 
@@ -8894,8 +10234,43 @@ ufbxi_nodiscard ufbxi_noinline static void *ufbxi_push_array_data(ufbxi_context
 	return data;
 }
 
+// Check if an array can reference the input data directly, see `ufbx_load_opts.borrow_input_arrays`.
+// The array must be contained in the user buffer passed to `ufbx_load_memory()` in the exact same format.
+ufbxi_noinline static bool ufbxi_can_borrow_array(ufbxi_context *uc, const ufbxi_array_info *info, char src_type, char dst_type, uint32_t encoding, size_t encoded_size, size_t decoded_size)
+{
+	if ((info->flags & UFBXI_ARRAY_FLAG_BORROW) == 0) return false;
+	if (encoding != 0 || encoded_size != decoded_size) return false;
+	if (src_type != dst_type || info->type == 'b') return false;
+	if (uc->file_big_endian || uc->local_big_endian) return false;
+	if (uc->yield_size + uc->data_size < encoded_size) return false;
+
+	// Invalid indices may point to the zero padding before the array.
+	if ((info->flags & UFBXI_ARRAY_FLAG_PAD_BEGIN) != 0 && uc->scene.metadata.may_contain_no_index) return false;
+
+	size_t elem_size = ufbxi_array_type_size(dst_type);
+	return elem_size > 0 && (uintptr_t)uc->data % elem_size == 0;
+}
+
+// Returns `true` if `ptr` refers to the user buffer passed to `ufbx_load_memory()`.
+ufbxi_noinline static bool ufbxi_is_borrowed(const ufbxi_context *uc, const void *ptr)
+{
+	uintptr_t begin = (uintptr_t)uc->data_begin;
+	uintptr_t end = (uintptr_t)uc->data + uc->yield_size + uc->data_size;
+	return (uintptr_t)ptr >= begin && (uintptr_t)ptr < end;
+}
+
 ufbxi_noinline static void ufbxi_postprocess_bool_array(char *data, size_t size)
 {
+#if UFBXI_HAS_SSE
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i one = _mm_set1_epi8(1);
+	for (; size >= 16; size -= 16) {
+		__m128i v = _mm_loadu_si128((const __m128i*)data);
+		_mm_storeu_si128((__m128i*)data, _mm_andnot_si128(_mm_cmpeq_epi8(v, zero), one));
+		data += 16;
+	}
+#endif
+
 	ufbxi_for(char, b, (char*)data, size) {
 		*b = (char)(*b != 0);
 	}
@@ -9023,6 +10398,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 	ufbxi_check(name);
 	node->name_len = name_len;
 	node->name = name;
+	node->filter = uc->parse_filter;
 
 	uint64_t values_end_offset = ufbxi_get_read_offset(uc) + values_len;
 
@@ -9082,9 +10458,16 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 			size_t src_elem_size = ufbxi_array_type_size(src_type);
 			size_t decoded_data_size = src_elem_size * size;
 
-			// Allocate `size` elements for the array.
-			char *arr_data = (char*)ufbxi_push_array_data(uc, &arr_info, size, tmp_buf);
-			ufbxi_check(arr_data);
+			// Allocate `size` elements for the array, or reference the array directly
+			// from the input buffer if it's already in the final format.
+			bool borrowed = ufbxi_can_borrow_array(uc, &arr_info, src_type, dst_type, encoding, encoded_size, decoded_data_size);
+			char *arr_data;
+			if (borrowed) {
+				arr_data = (char*)uc->data;
+			} else {
+				arr_data = (char*)ufbxi_push_array_data(uc, &arr_info, size, tmp_buf);
+				ufbxi_check(arr_data);
+			}
 
 			uint64_t arr_begin = ufbxi_get_read_offset(uc);
 			ufbxi_check(UINT64_MAX - encoded_size > arr_begin);
@@ -9093,6 +10476,12 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 				uc->progress_bytes_total = arr_end;
 			}
 
+			if (encoding == 1) {
+				uc->stats.num_inflated_arrays++;
+				uc->stats.bytes_inflated_input += encoded_size;
+				uc->stats.bytes_inflated_output += decoded_data_size;
+			}
+
 			// Threading
 			if (uc->parse_threaded && encoding == 1 && encoded_size >= UFBXI_MIN_THREADED_DEFLATE_BYTES && !uc->file_big_endian && !uc->local_big_endian) {
 				ufbxi_task *task = ufbxi_thread_pool_create_task(&uc->thread_pool, &ufbxi_deflate_task_fn);
@@ -9150,9 +10539,9 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 				ufbxi_check(encoded_size == decoded_data_size);
 
 				// If the array is contained in the current read buffer and we need to convert
-				// the data anyway we can use the read buffer as the decoded array source, otherwise
-				// do a plain byte copy to the array/conversion buffer.
-				if (uc->yield_size + uc->data_size >= encoded_size && decoded_data != arr_data) {
+				// the data anyway (or we're borrowing it) we can use the read buffer as the decoded
+				// array source, otherwise do a plain byte copy to the array/conversion buffer.
+				if (uc->yield_size + uc->data_size >= encoded_size && (decoded_data != arr_data || borrowed)) {
 					// Yield right after this if we crossed the yield threshold
 					if (encoded_size > uc->yield_size) {
 						uc->data_size += uc->yield_size;
@@ -9205,6 +10594,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 					input.buffer_size = uc->read_buffer_size;
 					input.read_fn = uc->read_fn;
 					input.read_user = uc->read_user;
+					uc->stats.bytes_read += encoded_size - input.data_size;
 					uc->data_offset += encoded_size - input.data_size;
 					uc->data += input.data_size;
 					uc->data_size = 0;
@@ -9218,7 +10608,9 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 					ufbxi_check(ufbxi_resume_progress(uc));
 				}
 
+				ufbx_load_phase prev_phase = ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_INFLATE);
 				ptrdiff_t res = ufbx_inflate(decoded_data, decoded_data_size, &input, uc->inflate_retain);
+				ufbxi_leave_phase(uc, prev_phase);
 				ufbxi_check_msg(res != -28, "Cancelled");
 				ufbxi_check_msg(res == (ptrdiff_t)decoded_data_size, "Bad DEFLATE data");
 
@@ -9364,11 +10756,24 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 		ufbxi_check(ufbxi_skip_bytes(uc, values_end_offset - offset));
 	}
 
+	// Skipped objects can jump directly to the end of the node
+	if (parent_state == UFBXI_PARSE_OBJECTS && uc->filter_objects) {
+		ufbxi_check(ufbxi_filter_object(uc, node));
+		if (node->filter == UFBX_ELEMENT_FILTER_SKIP && recursive && end_offset > 0) {
+			uint64_t current_offset = ufbxi_get_read_offset(uc);
+			ufbxi_check(current_offset <= end_offset);
+			ufbxi_check(ufbxi_skip_bytes(uc, end_offset - current_offset));
+			return 1;
+		}
+	}
+
 	if (recursive) {
 		// Recursively parse the children of this node. Update the parse state
 		// to provide context for child node parsing.
 		ufbxi_parse_state parse_state = ufbxi_update_parse_state(parent_state, node->name);
 		uint32_t num_children = 0;
+		uint8_t parent_filter = uc->parse_filter;
+		uc->parse_filter = node->filter;
 		for (;;) {
 			// Stop at end offset
 			uint64_t current_offset = ufbxi_get_read_offset(uc);
@@ -9382,6 +10787,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 			if (end) break;
 			num_children++;
 		}
+		uc->parse_filter = parent_filter;
 
 		// Pop children from `tmp_stack` to a contiguous array
 		node->num_children = num_children;
@@ -9438,9 +10844,12 @@ static ufbxi_noinline char ufbxi_ascii_refill(ufbxi_context *uc)
 
 		// Read user data, return '\0' on EOF
 		// TODO: Very unoptimal for non-full-size reads in some cases
+		ufbx_load_phase prev_phase = ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_IO);
 		size_t num_read = uc->read_fn(uc->read_user, dst_buffer, dst_size);
+		ufbxi_leave_phase(uc, prev_phase);
 		ufbxi_check_return_msg(num_read != SIZE_MAX, '\0', "IO error");
 		ufbxi_check_return(num_read <= dst_size, '\0');
+		uc->stats.bytes_read += num_read;
 		if (num_read == 0) return '\0';
 
 		uc->data = uc->data_begin = ua->src = dst_buffer;
@@ -10123,9 +11532,11 @@ ufbxi_noinline static bool ufbxi_ascii_array_task_imp(ufbxi_ascii_array_task *t)
 				}
 
 				// If not at end, we are past the last comma, so try to find a
-				// safe range to parse.
+				// safe range to parse. Comments may contain commas so stop
+				// before them and let the state machine above skip them.
 				if (src != end) {
-					const char *parse_end = end;
+					const char *parse_end = (const char*)memchr(src, ';', ufbxi_to_size(end - src));
+					if (!parse_end) parse_end = end;
 					while (parse_end > src) {
 						if (parse_end[-1] == ',') break;
 						parse_end--;
@@ -10157,6 +11568,96 @@ ufbxi_noinline static bool ufbxi_ascii_array_task_fn(ufbxi_task *task)
 	return true;
 }
 
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_run_array_task(ufbxi_context *uc, const ufbxi_ascii_array_task *t, ufbxi_buf *tmp_buf)
+{
+	ufbxi_task *task = ufbxi_thread_pool_create_task(&uc->thread_pool, &ufbxi_ascii_array_task_fn);
+	if (task) {
+		task->data = ufbxi_push_copy(tmp_buf, ufbxi_ascii_array_task, 1, t);
+		ufbxi_check(task->data);
+		ufbxi_thread_pool_run_task(&uc->thread_pool, task);
+	} else {
+		ufbxi_ascii_array_task local = *t;
+		ufbxi_check_msg(ufbxi_ascii_array_task_imp(&local), "Threaded ASCII parse error");
+	}
+	return 1;
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_push_array_chunk(ufbxi_context *uc, const ufbxi_ascii_array_task *t, ufbxi_buf *tmp_buf,
+	size_t value_begin, size_t value_end, size_t span_begin, const char *src_begin, size_t span_end, const char *src_end)
+{
+	size_t num_spans = span_end - span_begin + 1;
+	ufbxi_ascii_span *spans = ufbxi_push_copy(tmp_buf, ufbxi_ascii_span, num_spans, t->spans + span_begin);
+	ufbxi_check(spans);
+
+	spans[num_spans - 1].length = ufbxi_to_size(src_end - spans[num_spans - 1].source);
+	spans[0].length -= ufbxi_to_size(src_begin - spans[0].source);
+	spans[0].source = src_begin;
+
+	ufbxi_ascii_array_task chunk = *t;
+	chunk.arr_data = (char*)t->arr_data + value_begin * ufbxi_array_type_size(t->arr_type);
+	chunk.arr_size = value_end - value_begin;
+	chunk.spans = spans;
+	chunk.num_spans = num_spans;
+	chunk.offset = 0;
+	ufbxi_check(ufbxi_ascii_run_array_task(uc, &chunk, tmp_buf));
+
+	return 1;
+}
+
+// Parse a deferred ASCII array using tasks of up to `UFBXI_ASCII_ARRAY_TASK_VALUES` values.
+// Chunk boundaries are found by counting commas in the source, which is much cheaper than
+// parsing the values themselves. The source starts with the comma terminating the last
+// value parsed before deferring, so value `N` is terminated by comma `N + 2`.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_run_array_tasks(ufbxi_context *uc, const ufbxi_ascii_array_task *t, ufbxi_buf *tmp_buf)
+{
+	bool split = t->arr_size > UFBXI_ASCII_ARRAY_TASK_VALUES;
+
+	// Comments may contain commas, so we can't split arrays that contain them.
+	if (split) {
+		ufbxi_for(const ufbxi_ascii_span, span, t->spans, t->num_spans) {
+			if (memchr(span->source, ';', span->length)) {
+				split = false;
+				break;
+			}
+		}
+	}
+
+	if (!split) {
+		ufbxi_check(ufbxi_ascii_run_array_task(uc, t, tmp_buf));
+		return 1;
+	}
+
+	size_t num_commas = 0;
+	size_t value_begin = 0;
+	size_t next_cut = UFBXI_ASCII_ARRAY_TASK_VALUES + 1;
+	size_t chunk_span = 0;
+	const char *chunk_src = t->spans[0].source;
+
+	for (size_t span_ix = 0; span_ix < t->num_spans && value_begin + UFBXI_ASCII_ARRAY_TASK_VALUES < t->arr_size; span_ix++) {
+		const char *src = t->spans[span_ix].source;
+		const char *end = src + t->spans[span_ix].length;
+		while (src != end && value_begin + UFBXI_ASCII_ARRAY_TASK_VALUES < t->arr_size) {
+			if (*src++ != ',') continue;
+			if (++num_commas < next_cut) continue;
+
+			size_t value_end = value_begin + UFBXI_ASCII_ARRAY_TASK_VALUES;
+			ufbxi_check(ufbxi_ascii_push_array_chunk(uc, t, tmp_buf, value_begin, value_end, chunk_span, chunk_src, span_ix, src));
+
+			value_begin = value_end;
+			next_cut += UFBXI_ASCII_ARRAY_TASK_VALUES;
+			chunk_span = span_ix;
+			chunk_src = src;
+		}
+	}
+
+	// The last chunk contains all the remaining values, `ufbxi_ascii_array_task_imp()`
+	// will fail if the array contains a different number of values than reported.
+	const ufbxi_ascii_span *last = &t->spans[t->num_spans - 1];
+	ufbxi_check(ufbxi_ascii_push_array_chunk(uc, t, tmp_buf, value_begin, t->arr_size, chunk_span, chunk_src, t->num_spans - 1, last->source + last->length));
+
+	return 1;
+}
+
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_ascii_read_float_array(ufbxi_context *uc, char type, size_t *p_num_read)
 {
 	ufbxi_ascii *ua = &uc->ascii;
@@ -10317,6 +11818,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 	ufbxi_check(node);
 	node->name = name;
 	node->name_len = (uint8_t)name_len;
+	node->filter = uc->parse_filter;
 
 	bool in_ascii_array = false;
 
@@ -10649,15 +12151,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 				t.spans = spans;
 				t.offset = 0;
 
-				// TODO: Split these further
-				ufbxi_task *task = ufbxi_thread_pool_create_task(&uc->thread_pool, &ufbxi_ascii_array_task_fn);
-				if (task) {
-					task->data = ufbxi_push_copy(tmp_buf, ufbxi_ascii_array_task, 1, &t);
-					ufbxi_check(task->data);
-					ufbxi_thread_pool_run_task(&uc->thread_pool, task);
-				} else {
-					ufbxi_check_msg(ufbxi_ascii_array_task_imp(&t), "Threaded ASCII parse error");
-				}
+				ufbxi_check(ufbxi_ascii_run_array_tasks(uc, &t, tmp_buf));
 			}
 		}
 	} else {
@@ -10667,17 +12161,25 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 		ufbxi_check(node->vals);
 	}
 
+	// ASCII files can't skip objects so parse them with all content ignored
+	if (parent_state == UFBXI_PARSE_OBJECTS && uc->filter_objects) {
+		ufbxi_check(ufbxi_filter_object(uc, node));
+	}
+
 	// Recursively parse the children of this node. Update the parse state
 	// to provide context for child node parsing.
 	if (ufbxi_ascii_accept(uc, '{')) {
 		if (recursive) {
 			size_t num_children = 0;
+			uint8_t parent_filter = uc->parse_filter;
+			uc->parse_filter = node->filter;
 			for (;;) {
 				bool end = false;
 				ufbxi_check(ufbxi_ascii_parse_node(uc, depth + 1, parse_state, &end, tmp_buf, recursive));
 				if (end) break;
 				num_children++;
 			}
+			uc->parse_filter = parent_filter;
 
 			// Pop children from `tmp_stack` to a contiguous array
 			node->children = ufbxi_push_pop(tmp_buf, &uc->tmp_stack, ufbxi_node, num_children);
@@ -11241,11 +12743,13 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_begin_parse(ufbxi_context *uc)
 
 ufbxi_nodiscard static int ufbxi_parse_toplevel_child_imp(ufbxi_context *uc, ufbxi_parse_state state, ufbxi_buf *buf, bool *p_end)
 {
+	ufbx_load_phase prev_phase = ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_PARSE);
 	if (uc->from_ascii) {
 		ufbxi_check(ufbxi_ascii_parse_node(uc, 0, state, p_end, buf, true));
 	} else {
 		ufbxi_check(ufbxi_binary_parse_node(uc, 0, state, p_end, buf, true));
 	}
+	ufbxi_leave_phase(uc, prev_phase);
 
 	return 1;
 }
@@ -11270,11 +12774,13 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_parse_toplevel(ufbxi_context *uc
 	for (;;) {
 		// Parse the next top-level node
 		bool end = false;
+		ufbx_load_phase prev_phase = ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_PARSE);
 		if (uc->from_ascii) {
 			ufbxi_check(ufbxi_ascii_parse_node(uc, 0, UFBXI_PARSE_ROOT, &end, &uc->tmp, false));
 		} else {
 			ufbxi_check(ufbxi_binary_parse_node(uc, 0, UFBXI_PARSE_ROOT, &end, &uc->tmp, false));
 		}
+		ufbxi_leave_phase(uc, prev_phase);
 
 		// Top-level node not found
 		if (end) {
@@ -11376,16 +12882,126 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_parse_toplevel_child(ufbxi_conte
 	return 1;
 }
 
+// Check if data up to `end_offset` has been fed, with slack for the 13/25 byte record
+// that array parsing may peek past the end of the node.
+static ufbxi_forceinline bool ufbxi_feed_has_data(ufbxi_context *uc, uint64_t end_offset)
+{
+	return !uc->feeding || (end_offset > 0 && end_offset <= uc->feed_size && uc->feed_size - end_offset >= 25);
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_feed_finish_toplevel(ufbxi_context *uc)
+{
+	ufbxi_node *node = &uc->top_nodes[uc->feed_top_index];
+	uint32_t num_children = uc->feed_num_children;
+
+	node->num_children = num_children;
+	node->children = ufbxi_push_pop(&uc->tmp, &uc->tmp_stack, ufbxi_node, num_children);
+	ufbxi_check(node->children);
+
+	if (uc->opts.retain_dom) {
+		for (size_t i = 0; i < num_children; i++) {
+			ufbxi_check(ufbxi_retain_toplevel_child(uc, &node->children[i]));
+		}
+	}
+
+	uc->feed_top_index = SIZE_MAX;
+	uc->feed_num_children = 0;
+	return 1;
+}
+
+// Parse binary top-level nodes to the `top_nodes` cache from the data fed so far, see
+// `ufbx_load_feed()`. Parsing stops at the first node or child that has not been fed
+// completely and resumes from the same point when more data arrives. The final NULL
+// record is left for `ufbxi_parse_toplevel()` which finds the rest from the cache.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_feed_parse(ufbxi_context *uc)
+{
+	ufbx_assert(!uc->from_ascii && uc->version >= 6000);
+	size_t header_size = (uc->version >= 7500) ? 25 : 13;
+
+	while (!uc->feed_parsed_to_end) {
+		uint64_t offset = ufbxi_get_read_offset(uc);
+		if (uc->feeding && uc->feed_size - offset < header_size) return 1;
+
+		const char *header = ufbxi_peek_bytes(uc, header_size), *header_words = header;
+		ufbxi_check(header);
+
+		uint64_t end_offset, values_len;
+		uint8_t name_len;
+		if (uc->version >= 7500) {
+			if (uc->file_big_endian) {
+				header_words = ufbxi_swap_endian(uc, header_words, 3, 8);
+				ufbxi_check(header_words);
+			}
+			end_offset = ufbxi_read_u64(header_words + 0);
+			values_len = ufbxi_read_u64(header_words + 16);
+			name_len = ufbxi_read_u8(header + 24);
+		} else {
+			if (uc->file_big_endian) {
+				header_words = ufbxi_swap_endian(uc, header_words, 3, 4);
+				ufbxi_check(header_words);
+			}
+			end_offset = ufbxi_read_u32(header_words + 0);
+			values_len = ufbxi_read_u32(header_words + 8);
+			name_len = ufbxi_read_u8(header + 12);
+		}
+		bool null_record = end_offset == 0 && name_len == 0;
+
+		bool end = false;
+		if (uc->feed_top_index == SIZE_MAX) {
+			if (null_record) {
+				uc->feed_parsed_to_end = true;
+				break;
+			}
+
+			// Parse the header and values of the top-level node, children follow one by one
+			ufbxi_check(values_len <= UINT64_MAX - offset - header_size - name_len);
+			if (!ufbxi_feed_has_data(uc, offset + header_size + name_len + values_len)) return 1;
+			ufbxi_check(ufbxi_binary_parse_node(uc, 0, UFBXI_PARSE_ROOT, &end, &uc->tmp, false));
+			ufbxi_check(!end);
+
+			uc->top_nodes_len++;
+			ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->top_nodes, &uc->top_nodes_cap, uc->top_nodes_len));
+			ufbxi_node *node = &uc->top_nodes[uc->top_nodes_len - 1];
+			ufbxi_pop(&uc->tmp_stack, ufbxi_node, 1, node);
+			if (uc->opts.retain_dom) {
+				ufbxi_check(ufbxi_retain_toplevel(uc, node));
+			}
+
+			uc->feed_top_index = uc->top_nodes_len - 1;
+			uc->feed_num_children = 0;
+			if (!uc->has_next_child) {
+				ufbxi_check(ufbxi_feed_finish_toplevel(uc));
+			}
+		} else {
+			if (!null_record && !ufbxi_feed_has_data(uc, end_offset)) return 1;
+
+			ufbxi_node *node = &uc->top_nodes[uc->feed_top_index];
+			ufbxi_parse_state state = ufbxi_update_parse_state(UFBXI_PARSE_ROOT, node->name);
+			ufbxi_check(ufbxi_parse_toplevel_child_imp(uc, state, &uc->tmp, &end));
+			if (end) {
+				ufbxi_check(ufbxi_feed_finish_toplevel(uc));
+			} else {
+				ufbxi_check(uc->feed_num_children < UINT32_MAX);
+				uc->feed_num_children++;
+			}
+		}
+	}
+
+	return 1;
+}
+
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_parse_legacy_toplevel(ufbxi_context *uc)
 {
 	ufbx_assert(uc->top_nodes_len == 0);
 
 	bool end = false;
+	ufbx_load_phase prev_phase = ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_PARSE);
 	if (uc->from_ascii) {
 		ufbxi_check(ufbxi_ascii_parse_node(uc, 0, UFBXI_PARSE_ROOT, &end, &uc->tmp, true));
 	} else {
 		ufbxi_check(ufbxi_binary_parse_node(uc, 0, UFBXI_PARSE_ROOT, &end, &uc->tmp, true));
 	}
+	ufbxi_leave_phase(uc, prev_phase);
 
 	// Top-level node not found
 	if (end) {
@@ -11759,6 +13375,22 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_maps(ufbxi_context *uc)
 	return 1;
 }
 
+// Intern the global strings to `pool->map` in the same order as `ufbxi_load_strings()` and
+// `ufbxi_load_maps()`. The resulting map is immutable and can be shared between concurrent
+// loads via `ufbxi_string_pool.shared`, it only refers to static data so it doesn't need
+// to outlive the loaded scenes.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_init_shared_strings(ufbxi_string_pool *pool)
+{
+	ufbxi_check_err(pool->error, ufbxi_map_grow(&pool->map, ufbx_string, ufbxi_arraycount(ufbxi_strings) + ufbxi_arraycount(ufbxi_prop_type_names)));
+	ufbxi_for(const ufbx_string, str, ufbxi_strings, ufbxi_arraycount(ufbxi_strings)) {
+		ufbxi_check_err(pool->error, ufbxi_push_string_imp(pool, str->data, str->length, NULL, false, true));
+	}
+	ufbxi_for(const ufbxi_prop_type_name, name, ufbxi_prop_type_names, ufbxi_arraycount(ufbxi_prop_type_names)) {
+		ufbxi_check_err(pool->error, ufbxi_push_string_imp(pool, name->name, strlen(name->name), NULL, false, true));
+	}
+	return 1;
+}
+
 // -- Reading the parsed data
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_embedded_blob(ufbxi_context *uc, ufbx_blob *dst_blob, ufbxi_node *node)
@@ -12307,7 +13939,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_split_type_and_name(ufbxi_contex
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_insert_fbx_id(ufbxi_context *uc, uint64_t fbx_id, uint32_t element_id)
 {
 	uint32_t hash = ufbxi_hash64(fbx_id);
-	ufbxi_fbx_id_entry *entry = ufbxi_map_find(&uc->fbx_id_map, ufbxi_fbx_id_entry, hash, &fbx_id);
+	ufbxi_fbx_id_entry *entry = ufbxi_map_find_uint64(&uc->fbx_id_map, ufbxi_fbx_id_entry, hash, fbx_id);
 
 	if (!entry) {
 		entry = ufbxi_map_insert(&uc->fbx_id_map, ufbxi_fbx_id_entry, hash, &fbx_id);
@@ -12325,7 +13957,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_insert_fbx_id(ufbxi_context *uc,
 static ufbxi_noinline ufbxi_fbx_id_entry *ufbxi_find_fbx_id(ufbxi_context *uc, uint64_t fbx_id)
 {
 	uint32_t hash = ufbxi_hash64(fbx_id);
-	return ufbxi_map_find(&uc->fbx_id_map, ufbxi_fbx_id_entry, hash, &fbx_id);
+	return ufbxi_map_find_uint64(&uc->fbx_id_map, ufbxi_fbx_id_entry, hash, fbx_id);
 }
 
 static ufbxi_forceinline bool ufbxi_fbx_id_exists(ufbxi_context *uc, uint64_t fbx_id)
@@ -12336,7 +13968,7 @@ static ufbxi_forceinline bool ufbxi_fbx_id_exists(ufbxi_context *uc, uint64_t fb
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_insert_fbx_attr(ufbxi_context *uc, uint64_t fbx_id, uint64_t attrib_fbx_id)
 {
 	uint32_t hash = ufbxi_hash64(fbx_id);
-	ufbxi_fbx_attr_entry *entry = ufbxi_map_find(&uc->fbx_attr_map, ufbxi_fbx_attr_entry, hash, &fbx_id);
+	ufbxi_fbx_attr_entry *entry = ufbxi_map_find_uint64(&uc->fbx_attr_map, ufbxi_fbx_attr_entry, hash, fbx_id);
 	// TODO: Strict / warn about duplicate objects
 
 	if (!entry) {
@@ -12707,6 +14339,11 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_check_indices(ufbxi_context *uc,
 		owns_indices = true;
 	}
 
+	// Indices referencing the input buffer must not be modified in place
+	if (owns_indices && uc->borrow_indices && ufbxi_is_borrowed(uc, indices)) {
+		owns_indices = false;
+	}
+
 	// Normalize out-of-bounds indices to `invalid_index`
 	for (size_t i = 0; i < num_indices; i++) {
 		uint32_t ix = indices[i];
@@ -13007,6 +14644,17 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_sort_blend_offsets(ufbxi_context
 	return 1;
 }
 
+// Objects stubbed by `ufbx_load_opts.element_filter_cb` are read as if all content was ignored
+static ufbxi_forceinline bool ufbxi_ignore_geometry(ufbxi_context *uc, const ufbxi_node *node)
+{
+	return uc->opts.ignore_geometry || node->filter != UFBX_ELEMENT_FILTER_LOAD;
+}
+
+static ufbxi_forceinline bool ufbxi_ignore_animation(ufbxi_context *uc, const ufbxi_node *node)
+{
+	return uc->opts.ignore_animation || node->filter != UFBX_ELEMENT_FILTER_LOAD;
+}
+
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_shape(ufbxi_context *uc, ufbxi_node *node, ufbxi_element_info *info)
 {
 	ufbxi_node *node_vertices = ufbxi_find_child(node, ufbxi_Vertices);
@@ -13017,7 +14665,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_shape(ufbxi_context *uc, uf
 	ufbx_blend_shape *shape = ufbxi_push_element(uc, info, ufbx_blend_shape, UFBX_ELEMENT_BLEND_SHAPE);
 	ufbxi_check(shape);
 
-	if (uc->opts.ignore_geometry) return 1;
+	if (ufbxi_ignore_geometry(uc, node)) return 1;
 
 	ufbxi_value_array *vertices = ufbxi_get_array(node_vertices, 'r');
 	ufbxi_value_array *indices = ufbxi_get_array(node_indices, 'i');
@@ -13449,7 +15097,16 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_mesh(ufbxi_context *uc, ufb
 	ufbxi_node *node_indices = ufbxi_find_child(node, ufbxi_PolygonVertexIndex);
 	if (!node_vertices) return 1;
 
-	if (uc->opts.ignore_geometry) return 1;
+	// Remember deferred meshes for `ufbx_load_mesh_geometry()`
+	if (node->filter == UFBXI_ELEMENT_FILTER_LAZY) {
+		ufbxi_lazy_mesh *lazy = ufbxi_push(&uc->tmp_lazy_meshes, ufbxi_lazy_mesh, 1);
+		ufbxi_check(lazy);
+		lazy->element_id = mesh->element.element_id;
+		lazy->index = uc->lazy_index;
+		mesh->geometry_deferred = true;
+	}
+
+	if (ufbxi_ignore_geometry(uc, node)) return 1;
 
 	ufbxi_value_array *vertices = ufbxi_get_array(node_vertices, 'r');
 	ufbxi_value_array *indices = node_indices ? ufbxi_get_array(node_indices, 'i') : NULL;
@@ -13836,7 +15493,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_nurbs_curve(ufbxi_context *
 	nurbs->basis.topology = ufbxi_read_nurbs_topology(form);
 	nurbs->basis.is_2d = dimension == 2;
 
-	if (!uc->opts.ignore_geometry) {
+	if (!ufbxi_ignore_geometry(uc, node)) {
 		ufbxi_value_array *points = ufbxi_find_array(node, ufbxi_Points, 'r');
 		ufbxi_value_array *knot = ufbxi_find_array(node, ufbxi_KnotVector, 'r');
 		ufbxi_check(points);
@@ -13872,7 +15529,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_nurbs_surface(ufbxi_context
 	nurbs->span_subdivision_u = step_u > 0 ? (uint32_t)step_u : 4u;
 	nurbs->span_subdivision_v = step_v > 0 ? (uint32_t)step_v : 4u;
 
-	if (!uc->opts.ignore_geometry) {
+	if (!ufbxi_ignore_geometry(uc, node)) {
 		ufbxi_value_array *points = ufbxi_find_array(node, ufbxi_Points, 'r');
 		ufbxi_value_array *knot_u = ufbxi_find_array(node, ufbxi_KnotVectorU, 'r');
 		ufbxi_value_array *knot_v = ufbxi_find_array(node, ufbxi_KnotVectorV, 'r');
@@ -13898,7 +15555,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_line(ufbxi_context *uc, ufb
 	ufbx_line_curve *line = ufbxi_push_element(uc, info, ufbx_line_curve, UFBX_ELEMENT_LINE_CURVE);
 	ufbxi_check(line);
 
-	if (!uc->opts.ignore_geometry) {
+	if (!ufbxi_ignore_geometry(uc, node)) {
 		ufbxi_value_array *points = ufbxi_find_array(node, ufbxi_Points, 'r');
 		ufbxi_value_array *points_index = ufbxi_find_array(node, ufbxi_PointsIndex, 'i');
 		ufbxi_check(points);
@@ -14262,7 +15919,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_animation_curve(ufbxi_conte
 	ufbxi_read_extrapolation(&curve->pre_extrapolation, node, ufbxi_Pre_Extrapolation);
 	ufbxi_read_extrapolation(&curve->post_extrapolation, node, ufbxi_Post_Extrapolation);
 
-	if (uc->opts.ignore_animation) return 1;
+	if (ufbxi_ignore_animation(uc, node)) return 1;
 
 	ufbxi_value_array *times, *values, *attr_flags, *attrs, *refs;
 	ufbxi_check(times = ufbxi_find_array(node, ufbxi_KeyTime, 'l'));
@@ -14954,6 +16611,14 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_object(ufbxi_context *uc, u
 		return 1;
 	}
 
+	// Skipped by `ufbx_load_opts.element_filter_cb`
+	if (node->filter == UFBX_ELEMENT_FILTER_SKIP) return 1;
+
+	// Objects are read in the same order they are filtered in
+	if (node->filter == UFBXI_ELEMENT_FILTER_LAZY) {
+		uc->lazy_index = uc->lazy_read_count++;
+	}
+
 	ufbx_string type_and_name, sub_type_str;
 
 	// Failing to parse the object properties is not an error since
@@ -15123,7 +16788,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_objects(ufbxi_context *uc)
 typedef struct {
 	ufbxi_node **nodes;
 	size_t num_nodes;
-	uint32_t task_index;
+	uint64_t task_index;
 } ufbxi_object_batch;
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_objects_threaded(ufbxi_context *uc)
@@ -15185,8 +16850,8 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_objects_threaded(ufbxi_cont
 
 		if (!parsed_to_end) {
 			size_t num_nodes = 0;
-			uint32_t task_start = uc->thread_pool.start_index;
-			uint32_t max_tasks = uc->thread_pool.num_tasks / UFBX_THREAD_GROUP_COUNT;
+			uint64_t task_start = uc->thread_pool.start_index;
+			uint32_t max_tasks = uc->thread_pool.max_tasks / UFBX_THREAD_GROUP_COUNT;
 			max_tasks = ufbxi_min32(max_tasks, ufbxi_thread_pool_available_tasks(&uc->thread_pool));
 			size_t max_memory = uc->opts.thread_opts.memory_limit / UFBX_THREAD_GROUP_COUNT;
 
@@ -15200,7 +16865,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_objects_threaded(ufbxi_cont
 				ufbxi_check(ufbxi_push_copy(&uc->tmp_stack, ufbxi_node*, 1, &node));
 				num_nodes++;
 
-				uint32_t num_tasks = uc->thread_pool.start_index - task_start;
+				uint32_t num_tasks = (uint32_t)(uc->thread_pool.start_index - task_start);
 				if (num_tasks >= max_tasks) break;
 
 				size_t memory_used = tmp_buf->pushed_size + tmp_buf->pos;
@@ -15905,8 +17570,10 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_root(ufbxi_context *uc)
 	}
 
 	// Connections: Relationships between nodes
+	ufbx_load_phase prev_phase = ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_CONNECTIONS);
 	ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_Connections));
 	ufbxi_check(ufbxi_read_connections(uc));
+	ufbxi_leave_phase(uc, prev_phase);
 
 	// Takes: Pre-7000 animation data
 	ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_Takes));
@@ -16482,6 +18149,316 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_read_legacy_root(ufbxi_context *
 	return 1;
 }
 
+// -- Probing
+//
+// `ufbx_probe_*()` reads only the headers of top-level objects into `ufbx_probe_info`.
+// Content loading is forced off so array payloads are skipped without decompressing
+// them, and no elements are created so none of the scene finalization is needed.
+
+static ufbxi_noinline void ufbxi_probe_stack_times(ufbxi_context *uc, ufbx_probe_anim_stack *stack, ufbx_props *props)
+{
+	// See `ufbxi_update_anim_stack()`
+	ufbx_prop *begin, *end;
+	begin = ufbxi_find_prop(props, ufbxi_LocalStart);
+	end = ufbxi_find_prop(props, ufbxi_LocalStop);
+	if (!begin || !end) {
+		begin = ufbxi_find_prop(props, ufbxi_ReferenceStart);
+		end = ufbxi_find_prop(props, ufbxi_ReferenceStop);
+	}
+
+	if (begin && end) {
+		stack->time_begin = (double)begin->value_int / uc->ktime_sec_double;
+		stack->time_end = (double)end->value_int / uc->ktime_sec_double;
+	}
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_probe_object(ufbxi_context *uc, ufbxi_node *node)
+{
+	ufbx_probe_info *info = &uc->probe_info;
+	ufbx_string type_and_name, sub_type_str;
+
+	// See `ufbxi_read_object()`
+	if (uc->version >= 7000) {
+		uint64_t fbx_id;
+		if (!ufbxi_get_val3(node, "Lss", &fbx_id, &type_and_name, &sub_type_str)) return 1;
+	} else {
+		if (!ufbxi_get_val2(node, "ss", &type_and_name, &sub_type_str)) return 1;
+	}
+	info->num_objects++;
+
+	// Remove the "Fbx" prefix from sub-types, remember to re-intern!
+	if (sub_type_str.length > 3 && !memcmp(sub_type_str.data, "Fbx", 3)) {
+		sub_type_str.data += 3;
+		sub_type_str.length -= 3;
+		ufbxi_check(ufbxi_push_string_place_str(&uc->string_pool, &sub_type_str, false));
+	}
+
+	ufbx_string type_str, name_str;
+	ufbxi_check(ufbxi_split_type_and_name(uc, type_and_name, &type_str, &name_str));
+
+	const char *name = node->name, *sub_type = sub_type_str.data;
+	if (name == ufbxi_Model) {
+		info->num_nodes++;
+		ufbxi_check(ufbxi_push_copy(&uc->tmp_probe_node_names, ufbx_string, 1, &name_str));
+
+		// Pre-7000 models contain their attributes, see `ufbxi_read_synthetic_attribute()`
+		if (uc->version < 7000) {
+			if (sub_type == ufbxi_empty_char && ufbxi_find_child(node, ufbxi_Vertices) && ufbxi_find_child(node, ufbxi_PolygonVertexIndex)) {
+				sub_type = ufbxi_Mesh;
+			}
+			if (sub_type == ufbxi_Mesh) {
+				info->num_meshes++;
+				ufbxi_check(ufbxi_push_copy(&uc->tmp_probe_mesh_names, ufbx_string, 1, &name_str));
+			} else if (sub_type == ufbxi_Light) {
+				info->num_lights++;
+			} else if (sub_type == ufbxi_Camera) {
+				info->num_cameras++;
+			}
+		}
+	} else if (name == ufbxi_NodeAttribute) {
+		if (sub_type == ufbxi_Light) {
+			info->num_lights++;
+		} else if (sub_type == ufbxi_Camera) {
+			info->num_cameras++;
+		}
+	} else if (name == ufbxi_Geometry) {
+		if (sub_type == ufbxi_Mesh) {
+			info->num_meshes++;
+			ufbxi_check(ufbxi_push_copy(&uc->tmp_probe_mesh_names, ufbx_string, 1, &name_str));
+		}
+	} else if (name == ufbxi_Deformer) {
+		if (sub_type == ufbxi_Skin) {
+			info->num_skin_deformers++;
+		} else if (sub_type == ufbxi_BlendShape) {
+			info->num_blend_deformers++;
+		}
+	} else if (name == ufbxi_Material) {
+		info->num_materials++;
+		ufbxi_check(ufbxi_push_copy(&uc->tmp_probe_material_names, ufbx_string, 1, &name_str));
+	} else if (name == ufbxi_Texture) {
+		info->num_textures++;
+	} else if (name == ufbxi_AnimationStack) {
+		ufbx_props props;
+		ufbxi_check(ufbxi_read_properties(uc, node, &props));
+		props.defaults = ufbxi_find_template(uc, name, sub_type);
+
+		ufbxi_probe_stack *stack = ufbxi_push_zero(&uc->tmp_probe_stacks, ufbxi_probe_stack, 1);
+		ufbxi_check(stack);
+		stack->stack.name = name_str;
+		stack->has_props = props.props.count > 0;
+		ufbxi_probe_stack_times(uc, &stack->stack, &props);
+	}
+
+	return 1;
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_probe_take(ufbxi_context *uc, ufbxi_node *node, ufbxi_probe_stack *stacks, size_t num_stacks)
+{
+	// See `ufbxi_read_take()`
+	ufbx_prop tmp_props[4];
+	uint32_t num_props = 0;
+	memset(tmp_props, 0, sizeof(tmp_props));
+
+	int64_t start = 0, stop = 0;
+	if (ufbxi_find_val2(node, ufbxi_LocalTime, "LL", &start, &stop)) {
+		ufbxi_init_synthetic_int_prop(&tmp_props[num_props++], ufbxi_LocalStart, start, UFBX_PROP_INTEGER);
+		ufbxi_init_synthetic_int_prop(&tmp_props[num_props++], ufbxi_LocalStop, stop, UFBX_PROP_INTEGER);
+	}
+	if (ufbxi_find_val2(node, ufbxi_ReferenceTime, "LL", &start, &stop)) {
+		ufbxi_init_synthetic_int_prop(&tmp_props[num_props++], ufbxi_ReferenceStart, start, UFBX_PROP_INTEGER);
+		ufbxi_init_synthetic_int_prop(&tmp_props[num_props++], ufbxi_ReferenceStop, stop, UFBX_PROP_INTEGER);
+	}
+
+	ufbx_props props = { 0 };
+	props.props.data = tmp_props;
+	props.props.count = num_props;
+
+	const char *name;
+	ufbxi_check(ufbxi_get_val1(node, "C", (char**)&name));
+
+	// Post-7000 takes are only used as a fallback for stacks missing properties
+	if (uc->version >= 7000) {
+		ufbxi_for(ufbxi_probe_stack, stack, stacks, num_stacks) {
+			if (stack->stack.name.data == name && !stack->has_props) {
+				ufbxi_probe_stack_times(uc, &stack->stack, &props);
+				stack->has_props = true;
+			}
+		}
+		return 1;
+	}
+
+	ufbxi_probe_stack *stack = ufbxi_push_zero(&uc->tmp_probe_stacks, ufbxi_probe_stack, 1);
+	ufbxi_check(stack);
+	stack->stack.name.data = name;
+	stack->stack.name.length = strlen(name);
+	stack->has_props = true;
+	ufbxi_probe_stack_times(uc, &stack->stack, &props);
+
+	return 1;
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_probe_takes(ufbxi_context *uc, ufbxi_probe_stack *stacks, size_t num_stacks)
+{
+	for (;;) {
+		ufbxi_node *node;
+		ufbxi_check(ufbxi_parse_toplevel_child(uc, &node, NULL));
+		if (!node) break;
+
+		if (node->name == ufbxi_Take) {
+			ufbxi_check(ufbxi_probe_take(uc, node, stacks, num_stacks));
+		}
+	}
+
+	return 1;
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_probe_legacy_model(ufbxi_context *uc, ufbxi_node *node)
+{
+	ufbx_probe_info *info = &uc->probe_info;
+
+	// See `ufbxi_read_legacy_model()`
+	ufbx_string type_and_name, type, name;
+	ufbxi_check(ufbxi_get_val1(node, "s", &type_and_name));
+	ufbxi_check(ufbxi_split_type_and_name(uc, type_and_name, &type, &name));
+
+	info->num_objects++;
+	info->num_nodes++;
+	ufbxi_check(ufbxi_push_copy(&uc->tmp_probe_node_names, ufbx_string, 1, &name));
+
+	const char *attrib_type = ufbxi_empty_char;
+	ufbxi_ignore(ufbxi_find_val1(node, ufbxi_Type, "C", (char**)&attrib_type));
+	if (attrib_type == ufbxi_Light) {
+		info->num_lights++;
+	} else if (attrib_type == ufbxi_Camera) {
+		info->num_cameras++;
+	} else if (ufbxi_find_child(node, ufbxi_Vertices)) {
+		info->num_meshes++;
+		ufbxi_check(ufbxi_push_copy(&uc->tmp_probe_mesh_names, ufbx_string, 1, &name));
+	}
+
+	bool has_skin = false;
+	ufbxi_for(ufbxi_node, child, node->children, node->num_children) {
+		if (child->name == ufbxi_Material) {
+			ufbx_string material_type, material_name;
+			ufbxi_check(ufbxi_get_val1(child, "s", &type_and_name));
+			ufbxi_check(ufbxi_split_type_and_name(uc, type_and_name, &material_type, &material_name));
+			info->num_objects++;
+			info->num_materials++;
+			ufbxi_check(ufbxi_push_copy(&uc->tmp_probe_material_names, ufbx_string, 1, &material_name));
+		} else if (child->name == ufbxi_Link) {
+			has_skin = true;
+		}
+	}
+	if (has_skin) {
+		info->num_objects++;
+		info->num_skin_deformers++;
+	}
+
+	return 1;
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_probe_root(ufbxi_context *uc)
+{
+	ufbx_probe_info *info = &uc->probe_info;
+	ufbxi_probe_stack *stacks = NULL;
+	size_t num_stacks = 0;
+
+	if (uc->version < 6000) {
+		// See `ufbxi_read_legacy_root()`
+		uc->ktime_sec = 46186158000;
+		uc->ktime_sec_double = (double)uc->ktime_sec;
+
+		for (;;) {
+			ufbxi_check(ufbxi_parse_legacy_toplevel(uc));
+			if (!uc->top_node) break;
+
+			ufbxi_node *node = uc->top_node;
+			if (node->name == ufbxi_FBXHeaderExtension) {
+				ufbxi_check(ufbxi_read_header_extension(uc));
+			} else if (node->name == ufbxi_Takes) {
+				ufbxi_check(ufbxi_probe_takes(uc, NULL, 0));
+			} else if (node->name == ufbxi_Model) {
+				ufbxi_check(ufbxi_probe_legacy_model(uc, node));
+			}
+		}
+	} else {
+		// See `ufbxi_read_root()`
+		ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_FBXHeaderExtension));
+		ufbxi_check(ufbxi_read_header_extension(uc));
+
+		if (uc->exporter == UFBX_EXPORTER_BLENDER_ASCII) {
+			ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_Creator));
+			if (uc->top_node) {
+				ufbxi_ignore(ufbxi_get_val1(uc->top_node, "S", &uc->scene.metadata.creator));
+			}
+		}
+
+		ufbxi_check(ufbxi_match_exporter(uc));
+		uc->ascii.found_version = true;
+
+		ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_Definitions));
+		ufbxi_check(ufbxi_read_definitions(uc));
+
+		ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_Objects));
+		if (!uc->sure_fbx) {
+			ufbxi_check_msg(uc->top_node, "Not an FBX file");
+		}
+
+		for (;;) {
+			ufbxi_node *node;
+			ufbxi_check(ufbxi_parse_toplevel_child(uc, &node, NULL));
+			if (!node) break;
+			ufbxi_check(ufbxi_probe_object(uc, node));
+		}
+
+		// Post-7000 files only need `Takes` as a fallback for missing stack time
+		// ranges, so usually we can stop reading the file here.
+		bool need_takes = true;
+		if (uc->version >= 7000) {
+			num_stacks = uc->tmp_probe_stacks.num_items;
+			stacks = ufbxi_push_pop(&uc->tmp, &uc->tmp_probe_stacks, ufbxi_probe_stack, num_stacks);
+			ufbxi_check(stacks);
+
+			need_takes = false;
+			ufbxi_for(ufbxi_probe_stack, stack, stacks, num_stacks) {
+				if (!stack->has_props) need_takes = true;
+			}
+		}
+
+		if (need_takes) {
+			ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_Takes));
+			ufbxi_check(ufbxi_probe_takes(uc, stacks, num_stacks));
+		}
+	}
+
+	if (!stacks) {
+		num_stacks = uc->tmp_probe_stacks.num_items;
+		stacks = ufbxi_push_pop(&uc->tmp, &uc->tmp_probe_stacks, ufbxi_probe_stack, num_stacks);
+		ufbxi_check(stacks);
+	}
+
+	info->node_names.count = uc->tmp_probe_node_names.num_items;
+	info->node_names.data = ufbxi_push_pop(&uc->result, &uc->tmp_probe_node_names, ufbx_string, info->node_names.count);
+	ufbxi_check(info->node_names.data);
+
+	info->mesh_names.count = uc->tmp_probe_mesh_names.num_items;
+	info->mesh_names.data = ufbxi_push_pop(&uc->result, &uc->tmp_probe_mesh_names, ufbx_string, info->mesh_names.count);
+	ufbxi_check(info->mesh_names.data);
+
+	info->material_names.count = uc->tmp_probe_material_names.num_items;
+	info->material_names.data = ufbxi_push_pop(&uc->result, &uc->tmp_probe_material_names, ufbx_string, info->material_names.count);
+	ufbxi_check(info->material_names.data);
+
+	info->anim_stacks.count = num_stacks;
+	info->anim_stacks.data = ufbxi_push(&uc->result, ufbx_probe_anim_stack, num_stacks);
+	ufbxi_check(info->anim_stacks.data);
+	for (size_t i = 0; i < num_stacks; i++) {
+		info->anim_stacks.data[i] = stacks[i].stack;
+	}
+
+	return 1;
+}
+
 // Filename manipulation
 
 ufbxi_nodiscard ufbxi_noinline static size_t ufbxi_trim_delimiters(ufbxi_context *uc, const char *data, size_t length)
@@ -16877,6 +18854,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_init(ufbxi_context *uc)
 	uc->obj.tmp_face_group_infos.ator = &uc->ator_tmp;
 	uc->obj.tmp_meshes.ator = &uc->ator_tmp;
 	uc->obj.tmp_props.ator = &uc->ator_tmp;
+	uc->obj.tmp_vertex_lines.ator = &uc->ator_tmp;
 
 	// .obj parsing does its own yield logic
 	uc->data_size += uc->yield_size;
@@ -16915,6 +18893,7 @@ static ufbxi_noinline void ufbxi_obj_free(ufbxi_context *uc)
 	ufbxi_buf_free(&uc->obj.tmp_face_group_infos);
 	ufbxi_buf_free(&uc->obj.tmp_meshes);
 	ufbxi_buf_free(&uc->obj.tmp_props);
+	ufbxi_buf_free(&uc->obj.tmp_vertex_lines);
 
 	ufbxi_map_free(&uc->obj.group_map);
 
@@ -17071,6 +19050,117 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_tokenize_line(ufbxi_context
 	return 1;
 }
 
+typedef struct {
+	const ufbxi_obj_vertex_line *lines;
+	size_t num_lines;
+} ufbxi_obj_vertex_task;
+
+// Parse the values of deferred vertex lines, tokenizing them the same way as `ufbxi_obj_tokenize()`.
+ufbxi_noinline static bool ufbxi_obj_vertex_task_imp(const ufbxi_obj_vertex_task *t)
+{
+	uint32_t parse_flags = ufbxi_parse_double_init_flags();
+	ufbxi_for(const ufbxi_obj_vertex_line, line, t->lines, t->num_lines) {
+		const char *ptr = line->src, *end = ptr + line->src_length;
+		for (uint32_t i = 0; i < line->num_values; i++) {
+			while (ptr != end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\r')) ptr++;
+			if (ptr == end) return false;
+
+			const char *tok = ptr;
+			do {
+				ptr++;
+			} while (ptr != end && !ufbxi_is_space(*ptr));
+
+			char *num_end; // ufbxi_uninit
+			double val = ufbxi_parse_double(tok, ufbxi_to_size(ptr - tok), &num_end, parse_flags);
+			if (num_end != ptr) return false;
+			line->dst[i] = (ufbx_real)val;
+		}
+	}
+	return true;
+}
+
+ufbxi_noinline static bool ufbxi_obj_vertex_task_fn(ufbxi_task *task)
+{
+	const ufbxi_obj_vertex_task *t = (const ufbxi_obj_vertex_task*)task->data;
+	if (!ufbxi_obj_vertex_task_imp(t)) {
+		task->error = "Threaded OBJ parse error";
+		return false;
+	}
+	return true;
+}
+
+// Submit the pending vertex lines as a task. If `flush` is set or the current thread group
+// is full the group is started, after which we wait for the next group to finish so that
+// its `tmp_thread_parse[]` buffer can be reused.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_submit_vertices(ufbxi_context *uc, bool flush)
+{
+	ufbxi_thread_pool *pool = &uc->thread_pool;
+	ufbxi_buf *tmp_buf = &uc->tmp_thread_parse[pool->group];
+
+	size_t num_lines = uc->obj.tmp_vertex_lines.num_items;
+	if (num_lines > 0) {
+		ufbxi_obj_vertex_task *t = ufbxi_push(tmp_buf, ufbxi_obj_vertex_task, 1);
+		ufbxi_check(t);
+		t->lines = ufbxi_push_pop(tmp_buf, &uc->obj.tmp_vertex_lines, ufbxi_obj_vertex_line, num_lines);
+		t->num_lines = num_lines;
+		ufbxi_check(t->lines);
+
+		ufbxi_task *task = ufbxi_thread_pool_create_task(pool, &ufbxi_obj_vertex_task_fn);
+		if (task) {
+			task->data = t;
+			ufbxi_thread_pool_run_task(pool, task);
+		} else {
+			ufbxi_check_msg(ufbxi_obj_vertex_task_imp(t), "Threaded OBJ parse error");
+		}
+		uc->obj.num_group_vertex_tasks++;
+	}
+
+	uint32_t max_tasks = ufbxi_max32(pool->max_tasks / UFBX_THREAD_GROUP_COUNT, 1);
+	size_t max_memory = uc->opts.thread_opts.memory_limit / UFBX_THREAD_GROUP_COUNT;
+	size_t memory_used = tmp_buf->pushed_size + tmp_buf->pos;
+	if (flush || uc->obj.num_group_vertex_tasks >= max_tasks || memory_used >= max_memory) {
+		ufbxi_thread_pool_flush_group(pool);
+		ufbxi_check(ufbxi_thread_pool_wait_group(pool));
+		ufbxi_buf_clear(&uc->tmp_thread_parse[pool->group]);
+		uc->obj.num_group_vertex_tasks = 0;
+	}
+
+	return 1;
+}
+
+// Defer parsing vertex values to a task. Sets `*p_deferred` to `false` for lines that need to
+// be parsed immediately as they contain line continuations.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_defer_vertex(ufbxi_context *uc, ufbx_real *vals, size_t offset, size_t num_values, bool *p_deferred)
+{
+	ufbx_string first = uc->obj.tokens[offset];
+	ufbx_string last = uc->obj.tokens[offset + num_values - 1];
+	size_t src_length = ufbxi_to_size(last.data - first.data) + last.length;
+	if (src_length > UINT32_MAX || memchr(first.data, '\\', src_length) != NULL) {
+		*p_deferred = false;
+		return 1;
+	}
+
+	const char *src = first.data;
+	if (uc->read_fn || uc->obj.eof) {
+		src = ufbxi_push_copy(&uc->tmp_thread_parse[uc->thread_pool.group], char, src_length, src);
+		ufbxi_check(src);
+	}
+
+	ufbxi_obj_vertex_line *line = ufbxi_push(&uc->obj.tmp_vertex_lines, ufbxi_obj_vertex_line, 1);
+	ufbxi_check(line);
+	line->dst = vals;
+	line->src = src;
+	line->src_length = (uint32_t)src_length;
+	line->num_values = (uint32_t)num_values;
+
+	if (uc->obj.tmp_vertex_lines.num_items >= UFBXI_OBJ_VERTEX_TASK_LINES) {
+		ufbxi_check(ufbxi_obj_submit_vertices(uc, false));
+	}
+
+	*p_deferred = true;
+	return 1;
+}
+
 static ufbxi_noinline int ufbxi_obj_parse_vertex(ufbxi_context *uc, ufbxi_obj_attrib attrib, size_t offset)
 {
 	if (uc->opts.ignore_geometry) return 1;
@@ -17090,6 +19180,14 @@ static ufbxi_noinline int ufbxi_obj_parse_vertex(ufbxi_context *uc, ufbxi_obj_at
 	uint32_t parse_flags = uc->double_parse_flags;
 	ufbx_real *vals = ufbxi_push_fast(dst, ufbx_real, num_values);
 	ufbxi_check(vals);
+
+	// Colors may be popped by MRGB comments so they are always parsed immediately
+	if (uc->obj.defer_vertices && attrib != UFBXI_OBJ_ATTRIB_COLOR) {
+		bool deferred = false;
+		ufbxi_check(ufbxi_obj_defer_vertex(uc, vals, offset, read_values, &deferred));
+		if (deferred) return 1;
+	}
+
 	for (size_t i = 0; i < read_values; i++) {
 		ufbx_string str = uc->obj.tokens[offset + i];
 		char *end; // ufbxi_uninit
@@ -17415,7 +19513,8 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_pop_vertices(ufbxi_context *
 	ufbxi_check(min_index < uc->obj.tmp_vertices[attrib].num_items / stride);
 
 	size_t count = uc->obj.tmp_vertices[attrib].num_items - (size_t)min_index * stride;
-	ufbx_real *data = ufbxi_push(&uc->result, ufbx_real, count + 4);
+	ufbxi_buf *buf = uc->vertex_values == UFBXI_ARRAY_FLAG_TMP_BUF ? &uc->tmp : &uc->result;
+	ufbx_real *data = ufbxi_push(buf, ufbx_real, count + 4);
 	ufbxi_check(data);
 
 	data[0] = 0.0f;
@@ -17680,6 +19779,8 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_pop_meshes(ufbxi_context *uc
 
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_file(ufbxi_context *uc)
 {
+	uc->obj.defer_vertices = uc->thread_pool.enabled && !uc->opts.ignore_geometry;
+
 	while (!uc->obj.eof) {
 		ufbxi_check(ufbxi_obj_tokenize_line(uc));
 		size_t num_tokens = uc->obj.num_tokens;
@@ -17754,6 +19855,13 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_file(ufbxi_context *uc
 		}
 	}
 
+	// Wait for all vertex values to be parsed before popping them
+	if (uc->obj.defer_vertices) {
+		ufbxi_check(ufbxi_obj_submit_vertices(uc, true));
+		ufbxi_check(ufbxi_thread_pool_wait_all(&uc->thread_pool));
+		uc->obj.defer_vertices = false;
+	}
+
 	ufbxi_check(ufbxi_obj_flush_mesh(uc));
 	ufbxi_check(ufbxi_obj_pop_meshes(uc));
 
@@ -18637,8 +20745,8 @@ ufbx_static_assert(connection_size, sizeof(ufbx_connection) == sizeof(ufbx_eleme
 
 ufbxi_forceinline static bool ufbxi_cmp_connection_less(ufbx_connection *a, ufbx_connection *b, size_t index)
 {
-	ufbx_element *a_elem = (&a->src)[index], *b_elem = (&b->src)[index];
-	if (a_elem != b_elem) return a_elem < b_elem;
+	uint32_t a_id = (&a->src)[index]->element_id, b_id = (&b->src)[index]->element_id;
+	if (a_id != b_id) return a_id < b_id;
 	int cmp = strcmp((&a->src_prop)[index].data, (&b->src_prop)[index].data);
 	if (cmp != 0) return cmp < 0;
 	cmp = strcmp((&a->src_prop)[index ^ 1].data, (&b->src_prop)[index ^ 1].data);
@@ -18652,10 +20760,197 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_sort_connections(ufbxi_context *
 	return 1;
 }
 
+typedef struct {
+	const char *name;
+	uint32_t index;
+} ufbxi_conn_prop_name;
+
+// Sort the resolved `connections_src` into `connections_src` and `connections_dst` using
+// `ufbxi_radix_sort_u64()`. Property names are replaced with up to 16-bit ranks in `strcmp()`
+// order, so the key `element_id : rank(prop) : rank(other_prop)` orders connections the same
+// way as `ufbxi_cmp_connection_less()`. Leaves `*p_sorted` as `false` if `ufbxi_sort_connections()` should be used instead.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_radix_sort_connections(ufbxi_context *uc, bool *p_sorted)
+{
+	size_t count = uc->scene.connections_src.count;
+	ufbx_connection *conns = uc->scene.connections_src.data;
+	*p_sorted = false;
+	if (count < UFBXI_MIN_RADIX_SORT_SIZE) return 1;
+	ufbxi_check(count <= UINT32_MAX);
+
+	// Assign an index for each unique property name pointer, names are pooled so
+	// there usually are only a few of them.
+	uint32_t *name_ix = ufbxi_push(&uc->tmp_stack, uint32_t, count * 2);
+	ufbxi_check(name_ix);
+
+	ufbxi_map map; // ufbxi_uninit
+	memset(&map, 0, sizeof(map));
+	ufbxi_map_init(&map, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
+
+	// Consecutive connections often have the same names, so remember the previous one per side
+	const char *prev_name[2] = { NULL, NULL };
+	uint32_t prev_ix[2] = { 0, 0 };
+
+	bool ok = true, fits = true;
+	for (size_t i = 0; i < count * 2; i++) {
+		const char *name = (&conns[i >> 1].src_prop)[i & 1].data;
+		if (name == prev_name[i & 1]) {
+			name_ix[i] = prev_ix[i & 1];
+			continue;
+		}
+
+		uint32_t hash = ufbxi_hash_uptr((uintptr_t)name);
+		ufbxi_conn_prop_name *entry = ufbxi_map_find(&map, ufbxi_conn_prop_name, hash, &name);
+		if (!entry) {
+			if (map.size > UINT16_MAX) {
+				fits = false;
+				break;
+			}
+			entry = ufbxi_map_insert(&map, ufbxi_conn_prop_name, hash, &name);
+			if (!entry) {
+				ok = false;
+				break;
+			}
+			entry->name = name;
+			entry->index = map.size - 1;
+		}
+		name_ix[i] = entry->index;
+		prev_name[i & 1] = name;
+		prev_ix[i & 1] = entry->index;
+	}
+
+	// Rank the names, equal strings get the same rank even if they are not pooled
+	size_t num_names = map.size;
+	uint32_t *ranks = NULL;
+	uint32_t rank_bits = 0;
+	if (ok && fits) {
+		ufbxi_conn_prop_name *names = (ufbxi_conn_prop_name*)map.items;
+		ranks = ufbxi_push(&uc->tmp_stack, uint32_t, num_names);
+		ok = ranks && ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, num_names * sizeof(ufbxi_conn_prop_name));
+		if (ok) {
+			ufbxi_macro_stable_sort(ufbxi_conn_prop_name, 16, names, uc->tmp_arr, num_names, ( strcmp(a->name, b->name) < 0 ));
+			uint32_t rank = 0;
+			for (size_t i = 0; i < num_names; i++) {
+				if (i > 0 && strcmp(names[i - 1].name, names[i].name) != 0) rank++;
+				ranks[names[i].index] = rank;
+			}
+			while ((rank >> rank_bits) != 0) rank_bits++;
+		}
+	}
+
+	ufbxi_map_free(&map);
+	ufbxi_check(ok);
+	if (!fits) {
+		ufbxi_pop(&uc->tmp_stack, uint32_t, count * 2, NULL);
+		return 1;
+	}
+
+	ufbxi_radix_u64 *keys = ufbxi_push(&uc->tmp_stack, ufbxi_radix_u64, count * 3);
+	ufbxi_check(keys);
+
+	ufbxi_radix_u64 *src_keys = keys, *dst_keys = keys + count, *sort_tmp = keys + count * 2;
+	for (size_t i = 0; i < count; i++) {
+		uint64_t src_rank = ranks[name_ix[i * 2 + 0]];
+		uint64_t dst_rank = ranks[name_ix[i * 2 + 1]];
+		src_keys[i].key = ((uint64_t)conns[i].src->element_id << rank_bits | src_rank) << rank_bits | dst_rank;
+		src_keys[i].index = (uint32_t)i;
+		dst_keys[i].key = ((uint64_t)conns[i].dst->element_id << rank_bits | dst_rank) << rank_bits | src_rank;
+		dst_keys[i].index = (uint32_t)i;
+	}
+	ufbxi_radix_sort_u64(src_keys, sort_tmp, count);
+	ufbxi_radix_sort_u64(dst_keys, sort_tmp, count);
+
+	// Gather both sorted lists from a copy of the unsorted connections
+	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, count * sizeof(ufbx_connection)));
+	ufbx_connection *unsorted = (ufbx_connection*)uc->tmp_arr;
+	memcpy(unsorted, conns, count * sizeof(ufbx_connection));
+
+	ufbx_connection *dst_conns = ufbxi_push(&uc->result, ufbx_connection, count);
+	ufbxi_check(dst_conns);
+	for (size_t i = 0; i < count; i++) {
+		conns[i] = unsorted[src_keys[i].index];
+		dst_conns[i] = unsorted[dst_keys[i].index];
+	}
+	uc->scene.connections_dst.data = dst_conns;
+	uc->scene.connections_dst.count = count;
+
+	ufbxi_pop(&uc->tmp_stack, ufbxi_radix_u64, count * 3, NULL);
+	ufbxi_pop(&uc->tmp_stack, uint32_t, num_names, NULL);
+	ufbxi_pop(&uc->tmp_stack, uint32_t, count * 2, NULL);
+
+	*p_sorted = true;
+	return 1;
+}
+
+typedef struct {
+	ufbxi_context *uc;
+	const ufbxi_tmp_connection *connections;
+	ufbx_element **elements;
+	size_t num_connections;
+} ufbxi_connection_task;
+
+// Look up the `src` and `dst` elements of connections into `elements[i*2 + 0/1]`.
+// The FBX ID map and element list are not modified anymore so this is safe to run in parallel.
+ufbxi_noinline static void ufbxi_connection_task_imp(const ufbxi_connection_task *t)
+{
+	for (size_t i = 0; i < t->num_connections; i++) {
+		t->elements[i * 2 + 0] = ufbxi_find_element_by_fbx_id(t->uc, t->connections[i].src);
+		t->elements[i * 2 + 1] = ufbxi_find_element_by_fbx_id(t->uc, t->connections[i].dst);
+	}
+}
+
+ufbxi_noinline static bool ufbxi_connection_task_fn(ufbxi_task *task)
+{
+	ufbxi_connection_task_imp((const ufbxi_connection_task*)task->data);
+	return true;
+}
+
+// Resolve the elements of all connections, split into `UFBXI_CONNECTION_TASK_SIZE` tasks if threading is enabled.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_resolve_connection_elements(ufbxi_context *uc, const ufbxi_tmp_connection *connections, size_t num_connections, ufbx_element **elements)
+{
+	ufbxi_thread_pool *pool = &uc->thread_pool;
+	size_t task_size = UFBXI_CONNECTION_TASK_SIZE;
+
+	if (!pool->enabled || num_connections <= task_size) {
+		ufbxi_connection_task t; // ufbxi_uninit
+		t.uc = uc;
+		t.connections = connections;
+		t.elements = elements;
+		t.num_connections = num_connections;
+		ufbxi_connection_task_imp(&t);
+		return 1;
+	}
+
+	size_t num_tasks = (num_connections + task_size - 1) / task_size;
+	ufbxi_connection_task *tasks = ufbxi_push(&uc->tmp, ufbxi_connection_task, num_tasks);
+	ufbxi_check(tasks);
+
+	for (size_t i = 0; i < num_tasks; i++) {
+		size_t begin = i * task_size;
+		ufbxi_connection_task *t = &tasks[i];
+		t->uc = uc;
+		t->connections = connections + begin;
+		t->elements = elements + begin * 2;
+		t->num_connections = ufbxi_min_sz(task_size, num_connections - begin);
+
+		ufbxi_task *task = ufbxi_thread_pool_create_task(pool, &ufbxi_connection_task_fn);
+		if (task) {
+			task->data = t;
+			ufbxi_thread_pool_run_task(pool, task);
+		} else {
+			ufbxi_connection_task_imp(t);
+		}
+	}
+
+	ufbxi_thread_pool_flush_group(pool);
+	ufbxi_check(ufbxi_thread_pool_wait_all(pool));
+
+	return 1;
+}
+
 static uint64_t ufbxi_find_attribute_fbx_id(ufbxi_context *uc, uint64_t node_fbx_id)
 {
 	uint32_t hash = ufbxi_hash64(node_fbx_id);
-	ufbxi_fbx_attr_entry *entry = ufbxi_map_find(&uc->fbx_attr_map, ufbxi_fbx_attr_entry, hash, &node_fbx_id);
+	ufbxi_fbx_attr_entry *entry = ufbxi_map_find_uint64(&uc->fbx_attr_map, ufbxi_fbx_attr_entry, hash, node_fbx_id);
 	if (entry) {
 		return entry->attr_fbx_id;
 	}
@@ -18692,9 +20987,14 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_resolve_connections(ufbxi_contex
 		}
 	}
 
-	ufbxi_for(ufbxi_tmp_connection, tmp_conn, tmp_connections, num_connections) {
-		ufbx_element *src = ufbxi_find_element_by_fbx_id(uc, tmp_conn->src);
-		ufbx_element *dst = ufbxi_find_element_by_fbx_id(uc, tmp_conn->dst);
+	ufbx_element **conn_elements = ufbxi_push(&uc->tmp, ufbx_element*, num_connections * 2);
+	ufbxi_check(conn_elements);
+	ufbxi_check(ufbxi_resolve_connection_elements(uc, tmp_connections, num_connections, conn_elements));
+
+	for (size_t conn_ix = 0; conn_ix < num_connections; conn_ix++) {
+		ufbxi_tmp_connection *tmp_conn = &tmp_connections[conn_ix];
+		ufbx_element *src = conn_elements[conn_ix * 2 + 0];
+		ufbx_element *dst = conn_elements[conn_ix * 2 + 1];
 		if (!src || !dst) continue;
 
 		if (!uc->opts.disable_quirks) {
@@ -18765,13 +21065,17 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_resolve_connections(ufbxi_contex
 		conn->dst_prop = tmp_conn->dst_prop;
 	}
 
-	uc->scene.connections_dst.count = uc->scene.connections_src.count;
-	uc->scene.connections_dst.data = ufbxi_push_copy(&uc->result, ufbx_connection,
-		uc->scene.connections_src.count, uc->scene.connections_src.data);
-	ufbxi_check(uc->scene.connections_dst.data);
+	bool sorted = false;
+	ufbxi_check(ufbxi_radix_sort_connections(uc, &sorted));
+	if (!sorted) {
+		uc->scene.connections_dst.count = uc->scene.connections_src.count;
+		uc->scene.connections_dst.data = ufbxi_push_copy(&uc->result, ufbx_connection,
+			uc->scene.connections_src.count, uc->scene.connections_src.data);
+		ufbxi_check(uc->scene.connections_dst.data);
 
-	ufbxi_check(ufbxi_sort_connections(uc, uc->scene.connections_src.data, uc->scene.connections_src.count, 0));
-	ufbxi_check(ufbxi_sort_connections(uc, uc->scene.connections_dst.data, uc->scene.connections_dst.count, 1));
+		ufbxi_check(ufbxi_sort_connections(uc, uc->scene.connections_src.data, uc->scene.connections_src.count, 0));
+		ufbxi_check(ufbxi_sort_connections(uc, uc->scene.connections_dst.data, uc->scene.connections_dst.count, 1));
+	}
 
 	// We don't need the temporary connections at this point anymore
 	ufbxi_buf_free(&uc->tmp_connections);
@@ -19293,7 +21597,7 @@ ufbxi_forceinline static void ufbxi_patch_index_pointer(ufbxi_context *uc, uint3
 
 ufbxi_nodiscard static bool ufbxi_cmp_anim_prop_less(const ufbx_anim_prop *a, const ufbx_anim_prop *b)
 {
-	if (a->element != b->element) return a->element < b->element;
+	if (a->element != b->element) return a->element->element_id < b->element->element_id;
 	if (a->_internal_key != b->_internal_key) return a->_internal_key < b->_internal_key;
 	return ufbxi_str_less(a->prop_name, b->prop_name);
 }
@@ -19301,7 +21605,38 @@ ufbxi_nodiscard static bool ufbxi_cmp_anim_prop_less(const ufbx_anim_prop *a, co
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_sort_anim_props(ufbxi_context *uc, ufbx_anim_prop *aprops, size_t count)
 {
 	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, count * sizeof(ufbx_anim_prop)));
-	ufbxi_macro_stable_sort(ufbx_anim_prop, 32, aprops, uc->tmp_arr, count, ( ufbxi_cmp_anim_prop_less(a, b) ));
+	if (count < UFBXI_MIN_RADIX_SORT_SIZE) {
+		ufbxi_macro_stable_sort(ufbx_anim_prop, 32, aprops, uc->tmp_arr, count, ( ufbxi_cmp_anim_prop_less(a, b) ));
+		return 1;
+	}
+
+	// Radix sort by `element_id` and `_internal_key` and finish runs of equal keys by name,
+	// this matches `ufbxi_cmp_anim_prop_less()`.
+	ufbxi_check(count <= UINT32_MAX);
+	ufbxi_radix_u64 *keys = ufbxi_push(&uc->tmp_stack, ufbxi_radix_u64, count * 2);
+	ufbxi_check(keys);
+	for (size_t i = 0; i < count; i++) {
+		keys[i].key = (uint64_t)aprops[i].element->element_id << 32u | aprops[i]._internal_key;
+		keys[i].index = (uint32_t)i;
+	}
+	ufbxi_radix_sort_u64(keys, keys + count, count);
+
+	ufbx_anim_prop *unsorted = (ufbx_anim_prop*)uc->tmp_arr;
+	memcpy(unsorted, aprops, count * sizeof(ufbx_anim_prop));
+	for (size_t i = 0; i < count; i++) {
+		aprops[i] = unsorted[keys[i].index];
+	}
+
+	for (size_t begin = 0; begin < count; ) {
+		size_t end = begin + 1;
+		while (end < count && keys[end].key == keys[begin].key) end++;
+		if (end - begin > 1) {
+			ufbxi_macro_stable_sort(ufbx_anim_prop, 32, aprops + begin, uc->tmp_arr, end - begin, ( ufbxi_str_less(a->prop_name, b->prop_name) ));
+		}
+		begin = end;
+	}
+
+	ufbxi_pop(&uc->tmp_stack, ufbxi_radix_u64, count * 2, NULL);
 	return 1;
 }
 
@@ -19330,7 +21665,7 @@ ufbxi_nodiscard ufbxi_noinline static ufbx_anim_prop *ufbxi_find_anim_prop_start
 {
 	size_t index = SIZE_MAX;
 	ufbxi_macro_lower_bound_eq(ufbx_anim_prop, 16, &index, layer->anim_props.data, 0, layer->anim_props.count,
-		(a->element < element), (a->element == element));
+		(a->element->element_id < element->element_id), (a->element == element));
 	return index != SIZE_MAX ? &layer->anim_props.data[index] : NULL;
 }
 
@@ -20361,45 +22696,10 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_lod_group(ufbxi_context
 	return 1;
 }
 
-ufbxi_nodiscard ufbxi_noinline static int ufbxi_generate_normals(ufbxi_context *uc, ufbx_mesh *mesh)
+static ufbxi_noinline void ufbxi_fetch_maps_fn(void *user, size_t index)
 {
-	size_t num_indices = mesh->num_indices;
-
-	mesh->generated_normals = true;
-
-	ufbx_topo_edge *topo = ufbxi_push(&uc->tmp_stack, ufbx_topo_edge, num_indices);
-	ufbxi_check(topo);
-
-	uint32_t *normal_indices = ufbxi_push(&uc->result, uint32_t, num_indices);
-	ufbxi_check(normal_indices);
-
-	ufbx_compute_topology(mesh, topo, num_indices);
-	size_t num_normals = ufbx_generate_normal_mapping(mesh, topo, num_indices, normal_indices, num_indices, false);
-
-	if (num_normals == mesh->num_vertices) {
-		mesh->vertex_normal.unique_per_vertex = true;
-	}
-
-	ufbx_vec3 *normal_data = ufbxi_push(&uc->result, ufbx_vec3, num_normals + 1);
-	ufbxi_check(normal_data);
-
-	normal_data[0] = ufbx_zero_vec3;
-	normal_data++;
-
-	ufbx_compute_normals(mesh, &mesh->vertex_position, normal_indices, num_indices, normal_data, num_normals);
-
-	mesh->vertex_normal.exists = true;
-	mesh->vertex_normal.values.data = normal_data;
-	mesh->vertex_normal.values.count = num_normals;
-	mesh->vertex_normal.indices.data = normal_indices;
-	mesh->vertex_normal.indices.count = num_indices;
-	mesh->vertex_normal.value_reals = 3;
-
-	mesh->skinned_normal = mesh->vertex_normal;
-
-	ufbxi_pop(&uc->tmp_stack, ufbx_topo_edge, num_indices, NULL);
-
-	return 1;
+	ufbx_scene *scene = (ufbx_scene*)user;
+	ufbxi_fetch_maps(scene, scene->materials.data[index]);
 }
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_push_prop_prefix(ufbxi_context *uc, ufbx_string *dst, ufbx_string prefix)
@@ -21015,62 +23315,288 @@ ufbxi_nodiscard ufbxi_noinline static ufbx_node *ufbxi_get_geometry_transform_no
 	return NULL;
 }
 
-ufbxi_noinline static void ufbxi_mirror_vec3_list(const void *v_list, ufbx_mirror_axis axis, size_t stride)
-{
-	const ufbx_void_list *list = (const ufbx_void_list*)v_list;
-	if (axis == UFBX_MIRROR_AXIS_NONE || !list || list->count == 0) return;
-	if (!stride) stride = sizeof(ufbx_vec3);
+typedef void ufbxi_finalize_fn(void *user, size_t index);
 
-	void *ptr = (char*)list->data + (size_t)((int)axis - 1) * sizeof(ufbx_real);
-	void *end = (char*)ptr + list->count * stride;
-	while (ptr != end) {
-		ufbx_real *v = (ufbx_real*)ptr;
-		*v = -*v;
-		ptr = (char*)ptr + stride;
+typedef struct {
+	ufbxi_finalize_fn *fn;
+	void *user;
+	size_t begin, end;
+} ufbxi_finalize_task;
+
+ufbxi_noinline static void ufbxi_finalize_task_imp(const ufbxi_finalize_task *t)
+{
+	for (size_t i = t->begin; i < t->end; i++) {
+		t->fn(t->user, i);
 	}
 }
 
-ufbxi_noinline static void ufbxi_scale_vec3_list(const void *v_list, ufbx_real scale, size_t stride)
+ufbxi_noinline static bool ufbxi_finalize_task_fn(ufbxi_task *task)
 {
-	const ufbx_void_list *list = (const ufbx_void_list*)v_list;
-	if (!list || list->count == 0) return;
-	if (!stride) stride = sizeof(ufbx_vec3);
+	ufbxi_finalize_task_imp((const ufbxi_finalize_task*)task->data);
+	return true;
+}
+
+// Call `fn(user, i)` for `i` in `[0, count)`. The items must be independent of each other and `fn()` may
+// not allocate from `uc`. If threading is enabled, consecutive items are batched into tasks of roughly
+// `UFBXI_FINALIZE_TASK_WORK` units, where the cost of each item is a `size_t` at `work + i * work_stride`
+// or `UFBXI_FINALIZE_ITEM_WORK` if `work == NULL`.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_run_finalize_tasks(ufbxi_context *uc, ufbxi_finalize_fn *fn, void *user, size_t count, const void *work, size_t work_stride)
+{
+	ufbxi_thread_pool *pool = &uc->thread_pool;
+
+	ufbxi_finalize_task all; // ufbxi_uninit
+	all.fn = fn;
+	all.user = user;
+	all.begin = 0;
+	all.end = count;
 
-	void *ptr = list->data, *end = (char*)ptr + list->count * stride;
-	while (ptr != end) {
+	if (!pool->enabled || count <= 1) {
+		ufbxi_finalize_task_imp(&all);
+		return 1;
+	}
+
+	size_t max_tasks = count;
+	ufbxi_finalize_task *tasks = ufbxi_push(&uc->tmp, ufbxi_finalize_task, max_tasks);
+	ufbxi_check(tasks);
+
+	size_t num_tasks = 0;
+	size_t begin = 0, task_work = 0;
+	for (size_t i = 0; i < count; i++) {
+		task_work += work ? *(const size_t*)((const char*)work + i * work_stride) : UFBXI_FINALIZE_ITEM_WORK;
+		if (task_work >= UFBXI_FINALIZE_TASK_WORK || i + 1 == count) {
+			ufbxi_finalize_task *t = &tasks[num_tasks++];
+			*t = all;
+			t->begin = begin;
+			t->end = i + 1;
+			begin = i + 1;
+			task_work = 0;
+		}
+	}
+
+	if (num_tasks == 1) {
+		ufbxi_finalize_task_imp(&all);
+		return 1;
+	}
+
+	for (size_t i = 0; i < num_tasks; i++) {
+		ufbxi_finalize_task *t = &tasks[i];
+		ufbxi_task *task = ufbxi_thread_pool_create_task(pool, &ufbxi_finalize_task_fn);
+		if (task) {
+			task->data = t;
+			ufbxi_thread_pool_run_task(pool, task);
+		} else {
+			ufbxi_finalize_task_imp(t);
+		}
+	}
+
+	ufbxi_thread_pool_flush_group(pool);
+	ufbxi_check(ufbxi_thread_pool_wait_all(pool));
+
+	return 1;
+}
+
+// In-place modification of a strided `ufbx_vec3` list, see `ufbxi_modify_vec3_job()`.
+// Large lists are split into multiple jobs so that they can be processed in parallel.
+typedef struct {
+	char *data;
+	size_t count;
+	size_t stride;
+	ufbx_matrix matrix;
+	ufbx_real scale;
+	ufbx_mirror_axis mirror_axis;
+	bool do_scale;
+	bool do_transform;
+	bool do_normalize;
+} ufbxi_vec3_job;
+
+// Apply scaling, mirroring, affine transform and normalization (in this order) for each
+// enabled operation in a single pass over the data. The results are bit-identical to
+// applying `ufbxi_mul3()`, negation, `ufbx_transform_position()` and `ufbxi_normalize3()`.
+ufbxi_noinline static void ufbxi_modify_vec3_job(const ufbxi_vec3_job *job)
+{
+	char *ptr = job->data, *end = ptr + job->count * job->stride;
+	size_t stride = job->stride;
+	ufbx_real scale = job->scale;
+	const ufbx_matrix *m = &job->matrix;
+	bool do_scale = job->do_scale, do_transform = job->do_transform, do_normalize = job->do_normalize;
+
+#if UFBXI_HAS_SSE && !defined(UFBX_REAL_IS_FLOAT)
+	// Process the X and Y components as a pair, the operations are done in the same order
+	// as the scalar versions so the results match exactly.
+	const __m128d scale_xy = _mm_set1_pd(scale);
+	const __m128d mirror_xy = _mm_set_pd(job->mirror_axis == UFBX_MIRROR_AXIS_Y ? -0.0 : 0.0, job->mirror_axis == UFBX_MIRROR_AXIS_X ? -0.0 : 0.0);
+	const bool mirror_z = job->mirror_axis == UFBX_MIRROR_AXIS_Z;
+	const __m128d col0 = _mm_loadu_pd(&m->cols[0].x), col1 = _mm_loadu_pd(&m->cols[1].x);
+	const __m128d col2 = _mm_loadu_pd(&m->cols[2].x), col3 = _mm_loadu_pd(&m->cols[3].x);
+
+	for (; ptr != end; ptr += stride) {
 		ufbx_vec3 *v = (ufbx_vec3*)ptr;
-		v->x *= scale;
-		v->y *= scale;
-		v->z *= scale;
-		ptr = (char*)ptr + stride;
+		__m128d xy = _mm_loadu_pd(&v->x);
+		double z = v->z;
+
+		if (do_scale) {
+			xy = _mm_mul_pd(xy, scale_xy);
+			z *= scale;
+		}
+		xy = _mm_xor_pd(xy, mirror_xy);
+		if (mirror_z) z = -z;
+
+		if (do_transform) {
+			__m128d x2 = _mm_unpacklo_pd(xy, xy), y2 = _mm_unpackhi_pd(xy, xy);
+			double x = _mm_cvtsd_f64(xy), y = _mm_cvtsd_f64(y2);
+			__m128d r = _mm_add_pd(_mm_mul_pd(col0, x2), _mm_mul_pd(col1, y2));
+			r = _mm_add_pd(r, _mm_mul_pd(col2, _mm_set1_pd(z)));
+			xy = _mm_add_pd(r, col3);
+			z = m->m20*x + m->m21*y + m->m22*z + m->m23;
+		}
+
+		if (do_normalize) {
+			__m128d sq = _mm_mul_pd(xy, xy);
+			double len = ufbx_sqrt(_mm_cvtsd_f64(sq) + _mm_cvtsd_f64(_mm_unpackhi_pd(sq, sq)) + z*z);
+			if (len > UFBX_EPSILON) {
+				double inv = 1.0 / len;
+				xy = _mm_mul_pd(xy, _mm_set1_pd(inv));
+				z *= inv;
+			} else {
+				xy = _mm_setzero_pd();
+				z = 0.0;
+			}
+		}
+
+		_mm_storeu_pd(&v->x, xy);
+		v->z = z;
 	}
+#else
+	// Negating by multiplying with -1 is exact (apart from NaN signs) so mirroring can be done without branches
+	ufbx_real mirror_x = job->mirror_axis == UFBX_MIRROR_AXIS_X ? (ufbx_real)-1.0 : (ufbx_real)1.0;
+	ufbx_real mirror_y = job->mirror_axis == UFBX_MIRROR_AXIS_Y ? (ufbx_real)-1.0 : (ufbx_real)1.0;
+	ufbx_real mirror_z = job->mirror_axis == UFBX_MIRROR_AXIS_Z ? (ufbx_real)-1.0 : (ufbx_real)1.0;
+
+	for (; ptr != end; ptr += stride) {
+		ufbx_vec3 *v = (ufbx_vec3*)ptr;
+		ufbx_real x = v->x, y = v->y, z = v->z;
+
+		if (do_scale) {
+			x *= scale;
+			y *= scale;
+			z *= scale;
+		}
+		x *= mirror_x;
+		y *= mirror_y;
+		z *= mirror_z;
+
+		if (do_transform) {
+			ufbx_real tx = m->m00*x + m->m01*y + m->m02*z + m->m03;
+			ufbx_real ty = m->m10*x + m->m11*y + m->m12*z + m->m13;
+			ufbx_real tz = m->m20*x + m->m21*y + m->m22*z + m->m23;
+			x = tx;
+			y = ty;
+			z = tz;
+		}
+
+		if (do_normalize) {
+			ufbx_real len = (ufbx_real)ufbx_sqrt(x*x + y*y + z*z);
+			if (len > UFBX_EPSILON) {
+				ufbx_real inv = (ufbx_real)1.0 / len;
+				x *= inv;
+				y *= inv;
+				z *= inv;
+			} else {
+				x = y = z = (ufbx_real)0.0;
+			}
+		}
+
+		v->x = x;
+		v->y = y;
+		v->z = z;
+	}
+#endif
+}
+
+static ufbxi_noinline void ufbxi_modify_vec3_job_fn(void *user, size_t index)
+{
+	ufbxi_modify_vec3_job(&((const ufbxi_vec3_job*)user)[index]);
 }
 
-ufbxi_noinline static void ufbxi_transform_vec3_list(const void *v_list, const ufbx_matrix *matrix, size_t stride)
+// Queue a modification of `v_list` to `uc->tmp_stack`, splitting it to `UFBXI_FINALIZE_TASK_WORK` sized
+// jobs if threading is enabled. `stride` of zero means tightly packed `ufbx_vec3` values.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_push_vec3_jobs(ufbxi_context *uc, size_t *p_num_jobs, const void *v_list, size_t stride, const ufbxi_vec3_job *op)
 {
 	const ufbx_void_list *list = (const ufbx_void_list*)v_list;
-	if (!list || list->count == 0) return;
+	if (!list || list->count == 0) return 1;
+	if (!op->do_scale && op->mirror_axis == UFBX_MIRROR_AXIS_NONE && !op->do_transform && !op->do_normalize) return 1;
 	if (!stride) stride = sizeof(ufbx_vec3);
 
-	void *ptr = list->data, *end = (char*)ptr + list->count * stride;
-	while (ptr != end) {
-		ufbx_vec3 *v = (ufbx_vec3*)ptr;
-		*v = ufbx_transform_position(matrix, *v);
-		ptr = (char*)ptr + stride;
+	size_t chunk_size = uc->thread_pool.enabled ? UFBXI_FINALIZE_TASK_WORK : SIZE_MAX;
+	for (size_t begin = 0; begin < list->count; begin += chunk_size) {
+		ufbxi_vec3_job *job = ufbxi_push(&uc->tmp_stack, ufbxi_vec3_job, 1);
+		ufbxi_check(job);
+		*job = *op;
+		job->data = (char*)list->data + begin * stride;
+		job->count = ufbxi_min_sz(list->count - begin, chunk_size);
+		job->stride = stride;
+		*p_num_jobs += 1;
 	}
+
+	return 1;
 }
 
-ufbxi_noinline static void ufbxi_normalize_vec3_list(const ufbx_vec3_list *list)
+static bool ufbxi_less_vec3_job_data(void *user, const void *va, const void *vb)
 {
-	ufbxi_nounroll ufbxi_for_list(ufbx_vec3, normal, *list) {
-		*normal = ufbxi_normalize3(*normal);
+	(void)user;
+	const ufbxi_vec3_job *a = *(const ufbxi_vec3_job*const*)va, *b = *(const ufbxi_vec3_job*const*)vb;
+	return (uintptr_t)a->data < (uintptr_t)b->data;
+}
+
+// Run `jobs` in parallel if none of them overlap, otherwise serially in order. Vertex data can
+// be shared between elements, eg. OBJ meshes referring to the same vertex range.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_run_vec3_jobs(ufbxi_context *uc, ufbxi_vec3_job *jobs, size_t num_jobs)
+{
+	bool overlap = true;
+	if (uc->thread_pool.enabled && num_jobs > 1) {
+		ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, num_jobs * sizeof(ufbxi_vec3_job*)));
+		ufbxi_vec3_job **sorted = (ufbxi_vec3_job**)uc->tmp_arr;
+		for (size_t i = 0; i < num_jobs; i++) {
+			sorted[i] = &jobs[i];
+		}
+		ufbxi_unstable_sort(sorted, num_jobs, sizeof(ufbxi_vec3_job*), &ufbxi_less_vec3_job_data, NULL);
+
+		overlap = false;
+		for (size_t i = 1; i < num_jobs; i++) {
+			const ufbxi_vec3_job *prev = sorted[i - 1];
+			if ((uintptr_t)sorted[i]->data < (uintptr_t)(prev->data + prev->count * prev->stride)) {
+				overlap = true;
+				break;
+			}
+		}
+	}
+
+	if (overlap) {
+		ufbxi_for(ufbxi_vec3_job, job, jobs, num_jobs) {
+			ufbxi_modify_vec3_job(job);
+		}
+	} else {
+		ufbxi_check(ufbxi_run_finalize_tasks(uc, &ufbxi_modify_vec3_job_fn, jobs, num_jobs, &jobs[0].count, sizeof(ufbxi_vec3_job)));
 	}
+
+	return 1;
+}
+
+ufbxi_noinline static void ufbxi_normalize_vec3_list(const ufbx_vec3_list *list)
+{
+	ufbxi_vec3_job job = { 0 };
+	job.data = (char*)list->data;
+	job.count = list->count;
+	job.stride = sizeof(ufbx_vec3);
+	job.do_normalize = true;
+	ufbxi_modify_vec3_job(&job);
 }
 
 // Forward declare as we're kind of preprocessing ata here that would usually happen later.
 ufbxi_noinline static ufbx_transform ufbxi_get_geometry_transform(const ufbx_props *props, ufbx_node *node);
 
-ufbxi_nodiscard ufbxi_noinline static int ufbxi_flip_attrib_winding(ufbxi_context *uc, ufbx_mesh *mesh, ufbx_uint32_list *indices, bool is_position)
+// Queue `indices` to be flipped to `uc->tmp_stack`, duplicating shared index buffers if necessary.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_flip_attrib_winding(ufbxi_context *uc, ufbx_mesh *mesh, ufbx_uint32_list *indices, bool is_position, size_t *p_num_flip)
 {
 	// All zero, no flipping needed
 	if (indices->data == uc->zero_indices || indices->count == 0) return 1;
@@ -21089,34 +23615,26 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_flip_attrib_winding(ufbxi_contex
 		uc->tmp_mesh_consecutive_indices = indices->data;
 	}
 
-	uint32_t *data = indices->data;
-	ufbxi_for_list(ufbx_face, face, mesh->faces) {
-		if (face->num_indices == 0) continue;
-		size_t begin = face->index_begin + 1;
-		size_t end = face->index_begin + face->num_indices - 1;
-		while (begin < end) {
-			uint32_t tmp = data[begin];
-			data[begin] = data[end];
-			data[end] = tmp;
-			begin++;
-			end--;
-		}
-	}
+	uint32_t **p_data = ufbxi_push(&uc->tmp_stack, uint32_t*, 1);
+	ufbxi_check(p_data);
+	*p_data = indices->data;
+	*p_num_flip += 1;
 
 	return 1;
 }
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_flip_winding(ufbxi_context *uc, ufbx_mesh *mesh)
 {
+	size_t num_flip = 0;
 	uc->tmp_mesh_consecutive_indices = NULL;
-	ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &mesh->vertex_position.indices, true));
-	ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &mesh->vertex_normal.indices, false));
-	ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &mesh->vertex_crease.indices, false));
+	ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &mesh->vertex_position.indices, true, &num_flip));
+	ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &mesh->vertex_normal.indices, false, &num_flip));
+	ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &mesh->vertex_crease.indices, false, &num_flip));
 	if (mesh->uv_sets.count > 0) {
 		ufbxi_for_list(ufbx_uv_set, set, mesh->uv_sets) {
-			ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &set->vertex_uv.indices, false));
-			ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &set->vertex_tangent.indices, false));
-			ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &set->vertex_bitangent.indices, false));
+			ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &set->vertex_uv.indices, false, &num_flip));
+			ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &set->vertex_tangent.indices, false, &num_flip));
+			ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &set->vertex_bitangent.indices, false, &num_flip));
 		}
 		mesh->vertex_uv = mesh->uv_sets.data[0].vertex_uv;
 		mesh->vertex_bitangent = mesh->uv_sets.data[0].vertex_bitangent;
@@ -21124,13 +23642,34 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_flip_winding(ufbxi_context *uc,
 	}
 	if (mesh->color_sets.count > 0) {
 		ufbxi_for_list(ufbx_color_set, set, mesh->color_sets) {
-			ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &set->vertex_color.indices, false));
+			ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &set->vertex_color.indices, false, &num_flip));
 		}
 		mesh->vertex_color = mesh->color_sets.data[0].vertex_color;
 	}
-	ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &mesh->skinned_position.indices, false));
+	ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &mesh->skinned_position.indices, false, &num_flip));
 	if (mesh->skinned_normal.indices.data != mesh->vertex_normal.indices.data) {
-		ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &mesh->skinned_normal.indices, false));
+		ufbxi_check(ufbxi_flip_attrib_winding(uc, mesh, &mesh->skinned_normal.indices, false, &num_flip));
+	}
+
+	// Flip all the queued index buffers in a single pass over the faces
+	if (num_flip > 0) {
+		ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, num_flip * sizeof(uint32_t*)));
+		uint32_t **flip_data = (uint32_t**)uc->tmp_arr;
+		ufbxi_pop(&uc->tmp_stack, uint32_t*, num_flip, flip_data);
+
+		ufbxi_for_list(ufbx_face, face, mesh->faces) {
+			if (face->num_indices <= 2) continue;
+			size_t first = face->index_begin + 1;
+			size_t last = face->index_begin + face->num_indices - 1;
+			for (size_t i = 0; i < num_flip; i++) {
+				uint32_t *data = flip_data[i];
+				for (size_t begin = first, end = last; begin < end; begin++, end--) {
+					uint32_t tmp = data[begin];
+					data[begin] = data[end];
+					data[end] = tmp;
+				}
+			}
+		}
 	}
 
 	ufbxi_update_vertex_first_index(mesh);
@@ -21193,40 +23732,52 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_modify_geometry(ufbxi_context *u
 		do_scale = true;
 	}
 
-	ufbx_real geometry_scale = uc->scene.metadata.geometry_scale;
-	ufbx_mirror_axis mirror_axis = uc->mirror_axis;
+	// Vertex data modifications are queued as `ufbxi_vec3_job` and run in parallel at the end
+	ufbxi_vec3_job op_scale = { 0 }, op_mirror = { 0 };
+	op_scale.do_scale = do_scale;
+	op_scale.scale = uc->scene.metadata.geometry_scale;
+	op_scale.mirror_axis = do_mirror ? uc->mirror_axis : UFBX_MIRROR_AXIS_NONE;
+	op_mirror.mirror_axis = op_scale.mirror_axis;
+	size_t num_jobs = 0;
 
 	ufbxi_for_ptr_list(ufbx_blend_shape, p_shape, uc->scene.blend_shapes) {
 		ufbx_blend_shape *shape = *p_shape;
-
-		if (do_scale) {
-			ufbxi_scale_vec3_list(&shape->position_offsets, geometry_scale, 0);
-		}
-
-		if (do_mirror) {
-			ufbxi_mirror_vec3_list(&shape->position_offsets, mirror_axis, 0);
-			ufbxi_mirror_vec3_list(&shape->normal_offsets, mirror_axis, 0);
-		}
+		ufbxi_check(ufbxi_push_vec3_jobs(uc, &num_jobs, &shape->position_offsets, 0, &op_scale));
+		ufbxi_check(ufbxi_push_vec3_jobs(uc, &num_jobs, &shape->normal_offsets, 0, &op_mirror));
 	}
 
 	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, uc->scene.meshes) {
 		ufbx_mesh *mesh = *p_mesh;
 
-		if (do_scale) {
-			ufbxi_scale_vec3_list(&mesh->vertex_position.values, geometry_scale, 0);
+		ufbxi_vec3_job op_position = op_scale, op_normal = op_mirror, op_tangent = op_mirror;
+
+		ufbx_node *geo_node = ufbxi_get_geometry_transform_node(&mesh->element);
+		if (do_geometry_transforms && geo_node) {
+			op_position.do_transform = true;
+			op_position.matrix = geo_node->geometry_to_node;
+
+			op_normal.do_transform = true;
+			op_normal.do_normalize = true;
+			op_normal.matrix = ufbx_matrix_for_normals(&geo_node->geometry_to_node);
+
+			op_tangent.do_transform = true;
+			op_tangent.do_normalize = true;
+			op_tangent.matrix = geo_node->geometry_to_node;
+			op_tangent.matrix.m03 = 0.0f;
+			op_tangent.matrix.m13 = 0.0f;
+			op_tangent.matrix.m23 = 0.0f;
+		}
+
+		ufbxi_check(ufbxi_push_vec3_jobs(uc, &num_jobs, &mesh->vertex_position.values, 0, &op_position));
+		ufbxi_check(ufbxi_push_vec3_jobs(uc, &num_jobs, &mesh->vertex_normal.values, 0, &op_normal));
+		ufbxi_for_list(ufbx_uv_set, set, mesh->uv_sets) {
+			ufbxi_check(ufbxi_push_vec3_jobs(uc, &num_jobs, &set->vertex_tangent.values, 0, &op_tangent));
+			ufbxi_check(ufbxi_push_vec3_jobs(uc, &num_jobs, &set->vertex_bitangent.values, 0, &op_tangent));
 		}
 
 		bool do_flip_winding = do_winding;
-		if (do_mirror) {
-			ufbxi_mirror_vec3_list(&mesh->vertex_position.values, mirror_axis, 0);
-			ufbxi_mirror_vec3_list(&mesh->vertex_normal.values, mirror_axis, 0);
-			ufbxi_for_list(ufbx_uv_set, set, mesh->uv_sets) {
-				ufbxi_mirror_vec3_list(&set->vertex_tangent.values, mirror_axis, 0);
-				ufbxi_mirror_vec3_list(&set->vertex_bitangent.values, mirror_axis, 0);
-			}
-			if (!uc->opts.handedness_conversion_retain_winding) {
-				do_flip_winding = !do_flip_winding;
-			}
+		if (do_mirror && !uc->opts.handedness_conversion_retain_winding) {
+			do_flip_winding = !do_flip_winding;
 		}
 
 		// Flip face winding retaining the first vertex
@@ -21234,77 +23785,48 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_modify_geometry(ufbxi_context *u
 			mesh->reversed_winding = true;
 			ufbxi_check(ufbxi_flip_winding(uc, mesh));
 		}
-
-		ufbx_node *geo_node = ufbxi_get_geometry_transform_node(&mesh->element);
-		if (do_geometry_transforms && geo_node) {
-			ufbx_matrix tangent_matrix = geo_node->geometry_to_node;
-			tangent_matrix.m03 = 0.0f;
-			tangent_matrix.m13 = 0.0f;
-			tangent_matrix.m23 = 0.0f;
-			ufbx_matrix normal_matrix = ufbx_matrix_for_normals(&geo_node->geometry_to_node);
-
-			ufbxi_transform_vec3_list(&mesh->vertex_position.values, &geo_node->geometry_to_node, 0);
-			ufbxi_transform_vec3_list(&mesh->vertex_normal.values, &normal_matrix, 0);
-			ufbxi_normalize_vec3_list(&mesh->vertex_normal.values);
-
-			ufbxi_for_list(ufbx_uv_set, set, mesh->uv_sets) {
-				ufbxi_transform_vec3_list(&set->vertex_tangent.values, &tangent_matrix, 0);
-				ufbxi_transform_vec3_list(&set->vertex_bitangent.values, &tangent_matrix, 0);
-				ufbxi_normalize_vec3_list(&set->vertex_tangent.values);
-				ufbxi_normalize_vec3_list(&set->vertex_bitangent.values);
-			}
-		}
 	}
 
 	ufbxi_for_ptr_list(ufbx_line_curve, p_curve, uc->scene.line_curves) {
 		ufbx_line_curve *curve = *p_curve;
 
-		if (do_scale) {
-			ufbxi_scale_vec3_list(&curve->control_points, geometry_scale, 0);
-		}
-
-		if (do_mirror) {
-			ufbxi_mirror_vec3_list(&curve->control_points, mirror_axis, 0);
-		}
-
+		ufbxi_vec3_job op = op_scale;
 		ufbx_node *geo_node = ufbxi_get_geometry_transform_node(&curve->element);
 		if (do_geometry_transforms && geo_node) {
-			ufbxi_transform_vec3_list(&curve->control_points, &geo_node->geometry_to_node, 0);
+			op.do_transform = true;
+			op.matrix = geo_node->geometry_to_node;
 		}
+		ufbxi_check(ufbxi_push_vec3_jobs(uc, &num_jobs, &curve->control_points, 0, &op));
 	}
 
 	ufbxi_for_ptr_list(ufbx_nurbs_curve, p_curve, uc->scene.nurbs_curves) {
 		ufbx_nurbs_curve *curve = *p_curve;
 
-		if (do_scale) {
-			ufbxi_scale_vec3_list(&curve->control_points, geometry_scale, sizeof(ufbx_vec4));
-		}
-
-		if (do_mirror) {
-			ufbxi_mirror_vec3_list(&curve->control_points, mirror_axis, sizeof(ufbx_vec4));
-		}
-
+		ufbxi_vec3_job op = op_scale;
 		ufbx_node *geo_node = ufbxi_get_geometry_transform_node(&curve->element);
 		if (do_geometry_transforms && geo_node) {
-			ufbxi_transform_vec3_list(&curve->control_points, &geo_node->geometry_to_node, sizeof(ufbx_vec4));
+			op.do_transform = true;
+			op.matrix = geo_node->geometry_to_node;
 		}
+		ufbxi_check(ufbxi_push_vec3_jobs(uc, &num_jobs, &curve->control_points, sizeof(ufbx_vec4), &op));
 	}
 
 	ufbxi_for_ptr_list(ufbx_nurbs_surface, p_surface, uc->scene.nurbs_surfaces) {
 		ufbx_nurbs_surface *surface = *p_surface;
 
-		if (do_scale) {
-			ufbxi_scale_vec3_list(&surface->control_points, geometry_scale, sizeof(ufbx_vec4));
-		}
-
-		if (do_mirror) {
-			ufbxi_mirror_vec3_list(&surface->control_points, mirror_axis, sizeof(ufbx_vec4));
-		}
-
+		ufbxi_vec3_job op = op_scale;
 		ufbx_node *geo_node = ufbxi_get_geometry_transform_node(&surface->element);
 		if (do_geometry_transforms && geo_node) {
-			ufbxi_transform_vec3_list(&surface->control_points, &geo_node->geometry_to_node, sizeof(ufbx_vec4));
+			op.do_transform = true;
+			op.matrix = geo_node->geometry_to_node;
 		}
+		ufbxi_check(ufbxi_push_vec3_jobs(uc, &num_jobs, &surface->control_points, sizeof(ufbx_vec4), &op));
+	}
+
+	if (num_jobs > 0) {
+		ufbxi_vec3_job *jobs = ufbxi_push_pop(&uc->tmp, &uc->tmp_stack, ufbxi_vec3_job, num_jobs);
+		ufbxi_check(jobs);
+		ufbxi_check(ufbxi_run_vec3_jobs(uc, jobs, num_jobs));
 	}
 
 	if (uc->opts.geometry_transform_handling != UFBX_GEOMETRY_TRANSFORM_HANDLING_PRESERVE) {
@@ -21558,10 +24080,11 @@ static bool ufbxi_material_part_usage_less(void *user, const void *va, const voi
 	return pa->face_indices.data[0] < pb->face_indices.data[0];
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_finalize_mesh_material(ufbxi_buf *buf, ufbx_error *error, ufbx_mesh *mesh)
+// Count the number of faces and triangles per material, clamping out-of-bounds face materials to zero.
+// Does not allocate so this can be called from a task, see `ufbxi_finalize_mesh_material()` for the full process.
+static ufbxi_noinline void ufbxi_count_mesh_material_parts(ufbx_mesh *mesh)
 {
 	size_t num_materials = mesh->materials.count;
-	size_t num_parts = mesh->material_parts.count;
 	size_t num_faces = mesh->faces.count;
 
 	ufbx_mesh_part *parts = mesh->material_parts.data;
@@ -21569,7 +24092,6 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_finalize_mesh_material(ufbxi_buf
 
 	uint32_t *face_material = mesh->face_material.data;
 
-	// Count the number of faces and triangles per material
 	ufbxi_nounroll for (size_t i = 0; i < num_faces; i++) {
 		ufbx_face face = mesh->faces.data[i];
 		uint32_t mat_ix = 0;
@@ -21586,37 +24108,167 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_finalize_mesh_material(ufbxi_buf
 			ufbxi_mesh_part_add_face(&parts[mat_ix], face.num_indices);
 		}
 	}
+}
+
+// Allocate per-material buffers (clear `num_faces` to 0 to re-use it as an index when fetching the face indices).
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_alloc_mesh_material_parts(ufbxi_buf *buf, ufbx_error *error, ufbx_mesh *mesh)
+{
+	size_t num_parts = mesh->material_parts.count;
+	ufbx_mesh_part *parts = mesh->material_parts.data;
+	if (!parts) return 1;
+
+	uint32_t part_index = 0;
+	ufbxi_for(ufbx_mesh_part, part, parts, num_parts) {
+		part->index = part_index++;
+		part->face_indices.count = part->num_faces;
+		part->face_indices.data = ufbxi_push(buf, uint32_t, part->num_faces);
+		ufbxi_check_err(error, part->face_indices.data);
+		part->num_faces = 0;
+	}
+
+	mesh->material_part_usage_order.count = num_parts;
+	mesh->material_part_usage_order.data = ufbxi_push(buf, uint32_t, num_parts);
+	ufbxi_check_err(error, mesh->material_part_usage_order.data);
+
+	return 1;
+}
+
+// Fetch the per-material face indices into buffers from `ufbxi_alloc_mesh_material_parts()`.
+// Does not allocate so this can be called from a task.
+static ufbxi_noinline void ufbxi_fill_mesh_material_parts(ufbx_mesh *mesh)
+{
+	size_t num_parts = mesh->material_parts.count;
+	size_t num_faces = mesh->faces.count;
+	ufbx_mesh_part *parts = mesh->material_parts.data;
+	if (!parts) return;
 
-	if (parts) {
-		// Allocate per-material buffers (clear `num_faces` to 0 to re-use it as
-		// an index when fetching the face indices).
-		uint32_t part_index = 0;
-		ufbxi_for(ufbx_mesh_part, part, parts, num_parts) {
-			part->index = part_index++;
-			part->face_indices.count = part->num_faces;
-			part->face_indices.data = ufbxi_push(buf, uint32_t, part->num_faces);
-			ufbxi_check_err(error, part->face_indices.data);
-			part->num_faces = 0;
+	uint32_t *face_material = mesh->face_material.data;
+	ufbxi_nounroll for (size_t i = 0; i < num_faces; i++) {
+		uint32_t mat_ix = face_material ? face_material[i] : 0;
+		if (mat_ix < num_parts) {
+			ufbx_mesh_part *part = &parts[mat_ix];
+			part->face_indices.data[part->num_faces++] = (uint32_t)i;
 		}
+	}
 
-		// Fetch the per-material face indices
-		ufbxi_nounroll for (size_t i = 0; i < num_faces; i++) {
-			uint32_t mat_ix = face_material ? face_material[i] : 0;
-			if (mat_ix < num_parts) {
-				ufbx_mesh_part *part = &parts[mat_ix];
-				part->face_indices.data[part->num_faces++] = (uint32_t)i;
-			}
+	for (size_t i = 0; i < num_parts; i++) {
+		mesh->material_part_usage_order.data[i] = (uint32_t)i;
+	}
+	ufbxi_unstable_sort(mesh->material_part_usage_order.data, num_parts, sizeof(uint32_t), &ufbxi_material_part_usage_less, parts);
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_finalize_mesh_material(ufbxi_buf *buf, ufbx_error *error, ufbx_mesh *mesh)
+{
+	ufbxi_count_mesh_material_parts(mesh);
+	ufbxi_check_err(error, ufbxi_alloc_mesh_material_parts(buf, error, mesh));
+	ufbxi_fill_mesh_material_parts(mesh);
+	return 1;
+}
+
+// Deferred per-mesh work of `ufbxi_finalize_scene()`, split into phases that don't allocate
+// so that they can be run as tasks with allocation done serially in between.
+typedef struct {
+	ufbx_mesh *mesh;
+	size_t work;
+	ufbx_topo_edge *topo;
+	uint32_t *normal_indices;
+	size_t num_normals;
+	bool generate_normals;
+	bool material_parts;
+} ufbxi_mesh_job;
+
+static ufbxi_noinline void ufbxi_mesh_job_count_fn(void *user, size_t index)
+{
+	ufbxi_mesh_job *job = &((ufbxi_mesh_job*)user)[index];
+	ufbx_mesh *mesh = job->mesh;
+
+	if (job->generate_normals) {
+		ufbx_compute_topology(mesh, job->topo, mesh->num_indices);
+		job->num_normals = ufbx_generate_normal_mapping(mesh, job->topo, mesh->num_indices, job->normal_indices, mesh->num_indices, false);
+	}
+	if (job->material_parts) {
+		ufbxi_count_mesh_material_parts(mesh);
+	}
+}
+
+static ufbxi_noinline void ufbxi_mesh_job_fill_fn(void *user, size_t index)
+{
+	ufbxi_mesh_job *job = &((ufbxi_mesh_job*)user)[index];
+	ufbx_mesh *mesh = job->mesh;
+
+	if (job->generate_normals) {
+		ufbx_compute_normals(mesh, &mesh->vertex_position, job->normal_indices, mesh->num_indices,
+			(ufbx_vec3*)mesh->vertex_normal.values.data, job->num_normals);
+	}
+	if (job->material_parts) {
+		ufbxi_fill_mesh_material_parts(mesh);
+	}
+}
+
+// Generate missing normals and per-material face lists for `jobs`, the result is identical
+// to processing the meshes one by one. Topology for normal generation is needed only
+// temporarily so it is allocated in batches of up to `UFBXI_FINALIZE_TOPO_BATCH` indices.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_run_mesh_jobs(ufbxi_context *uc, ufbxi_mesh_job *jobs, size_t num_jobs)
+{
+	if (num_jobs == 0) return 1;
+
+	size_t max_batch_indices = uc->thread_pool.enabled ? UFBXI_FINALIZE_TOPO_BATCH : 0;
+
+	for (size_t begin = 0; begin < num_jobs; ) {
+		size_t end = begin, num_topo = 0;
+		while (end < num_jobs) {
+			size_t num_indices = jobs[end].generate_normals ? jobs[end].mesh->num_indices : 0;
+			if (num_topo > 0 && num_topo + num_indices > max_batch_indices) break;
+			num_topo += num_indices;
+			end++;
+		}
+
+		ufbx_topo_edge *topo = ufbxi_push(&uc->tmp_stack, ufbx_topo_edge, num_topo);
+		ufbxi_check(topo);
+		for (size_t i = begin; i < end; i++) {
+			if (!jobs[i].generate_normals) continue;
+			jobs[i].topo = topo;
+			topo += jobs[i].mesh->num_indices;
 		}
 
-		mesh->material_part_usage_order.count = num_parts;
-		mesh->material_part_usage_order.data = ufbxi_push(buf, uint32_t, num_parts);
-		ufbxi_check_err(error, mesh->material_part_usage_order.data);
-		for (size_t i = 0; i < num_parts; i++) {
-			mesh->material_part_usage_order.data[i] = (uint32_t)i;
+		ufbxi_check(ufbxi_run_finalize_tasks(uc, &ufbxi_mesh_job_count_fn, jobs + begin, end - begin, &jobs[begin].work, sizeof(ufbxi_mesh_job)));
+
+		ufbxi_pop(&uc->tmp_stack, ufbx_topo_edge, num_topo, NULL);
+		begin = end;
+	}
+
+	ufbxi_for(ufbxi_mesh_job, job, jobs, num_jobs) {
+		ufbx_mesh *mesh = job->mesh;
+		job->topo = NULL;
+
+		if (job->generate_normals) {
+			size_t num_normals = job->num_normals;
+			if (num_normals == mesh->num_vertices) {
+				mesh->vertex_normal.unique_per_vertex = true;
+			}
+
+			ufbx_vec3 *normal_data = ufbxi_push(&uc->result, ufbx_vec3, num_normals + 1);
+			ufbxi_check(normal_data);
+
+			normal_data[0] = ufbx_zero_vec3;
+			normal_data++;
+
+			mesh->vertex_normal.exists = true;
+			mesh->vertex_normal.values.data = normal_data;
+			mesh->vertex_normal.values.count = num_normals;
+			mesh->vertex_normal.indices.data = job->normal_indices;
+			mesh->vertex_normal.indices.count = mesh->num_indices;
+			mesh->vertex_normal.value_reals = 3;
+
+			mesh->skinned_normal = mesh->vertex_normal;
+		}
+		if (job->material_parts) {
+			ufbxi_check(ufbxi_alloc_mesh_material_parts(&uc->result, &uc->error, mesh));
 		}
-		ufbxi_unstable_sort(mesh->material_part_usage_order.data, num_parts, sizeof(uint32_t), &ufbxi_material_part_usage_less, parts);
 	}
 
+	ufbxi_check(ufbxi_run_finalize_tasks(uc, &ufbxi_mesh_job_fill_fn, jobs, num_jobs, &jobs[0].work, sizeof(ufbxi_mesh_job)));
+
 	return 1;
 }
 
@@ -21679,8 +24331,10 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 	uc->scene.metadata.raw_original_file_path = ufbx_find_blob(&uc->scene.metadata.scene_props, "DocumentUrl", ufbx_empty_blob);
 
 	// Resolve and add the connections to elements
+	ufbx_load_phase prev_phase = ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_CONNECTIONS);
 	ufbxi_check(ufbxi_resolve_connections(uc));
 	ufbxi_check(ufbxi_add_connections_to_elements(uc));
+	ufbxi_leave_phase(uc, prev_phase);
 	ufbxi_check(ufbxi_linearize_nodes(uc));
 
 	for (size_t type = 0; type < UFBX_ELEMENT_TYPE_COUNT; type++) {
@@ -22035,8 +24689,14 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 		uc->zero_indices = zero_indices;
 		uc->consecutive_indices = consecutive_indices;
 
+		// Normal generation and material face lists are deferred to `ufbxi_run_mesh_jobs()`
+		ufbxi_mesh_job *mesh_jobs = ufbxi_push_zero(&uc->tmp_stack, ufbxi_mesh_job, uc->scene.meshes.count);
+		ufbxi_check(mesh_jobs);
+		size_t num_mesh_jobs = 0;
+
 		ufbxi_for_ptr_list(ufbx_mesh, p_mesh, uc->scene.meshes) {
 			ufbx_mesh *mesh = *p_mesh;
+			ufbxi_mesh_job *job = &mesh_jobs[num_mesh_jobs];
 
 			ufbxi_patch_index_pointer(uc, &mesh->vertex_position.indices.data);
 			ufbxi_patch_index_pointer(uc, &mesh->vertex_normal.indices.data);
@@ -22060,7 +24720,11 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 
 			// Generate normals if necessary
 			if (!mesh->vertex_normal.exists && uc->opts.generate_missing_normals) {
-				ufbxi_check(ufbxi_generate_normals(uc, mesh));
+				mesh->generated_normals = true;
+				job->normal_indices = ufbxi_push(&uc->result, uint32_t, mesh->num_indices);
+				ufbxi_check(job->normal_indices);
+				job->generate_normals = true;
+				job->work += mesh->num_indices;
 			}
 
 			// Assign first UV and color sets as the "canonical" ones
@@ -22129,7 +24793,8 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 					mesh->face_material.count = 0;
 				}
 			} else if (mesh->materials.count > 0) {
-				ufbxi_check(ufbxi_finalize_mesh_material(&uc->result, &uc->error, mesh));
+				job->material_parts = true;
+				job->work += mesh->num_faces;
 			}
 
 			// Fetch deformers
@@ -22151,7 +24816,15 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 			if (mesh->max_face_triangles > uc->scene.metadata.max_face_triangles) {
 				uc->scene.metadata.max_face_triangles = mesh->max_face_triangles;
 			}
+
+			if (job->generate_normals || job->material_parts) {
+				job->mesh = mesh;
+				num_mesh_jobs++;
+			}
 		}
+
+		ufbxi_check(ufbxi_run_mesh_jobs(uc, mesh_jobs, num_mesh_jobs));
+		ufbxi_pop(&uc->tmp_stack, ufbxi_mesh_job, uc->scene.meshes.count, NULL);
 	}
 
 	ufbxi_for_ptr_list(ufbx_stereo_camera, p_stereo, uc->scene.stereo_cameras) {
@@ -22194,7 +24867,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 			ufbx_anim_value *value = *p_value;
 			ufbxi_for_list(ufbx_connection, ac, value->element.connections_src) {
 				if (ac->src_prop.length == 0 && ac->dst_prop.length > 0) {
-					ufbx_anim_prop *aprop = ufbxi_push(&uc->tmp_stack, ufbx_anim_prop, 1);
+					ufbx_anim_prop *aprop = ufbxi_push_zero(&uc->tmp_stack, ufbx_anim_prop, 1);
 					uint32_t id = ac->dst->element_id;
 					min_id = ufbxi_min32(min_id, id);
 					max_id = ufbxi_max32(max_id, id);
@@ -22510,12 +25183,11 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 	ufbxi_propagate_main_textures(&uc->scene);
 	ufbxi_check(ufbxi_pop_texture_files(uc));
 
-	// Second pass to fetch material maps
+	// Second pass to sort material textures
 	ufbxi_for_ptr_list(ufbx_material, p_material, uc->scene.materials) {
 		ufbx_material *material = *p_material;
 
 		ufbxi_check(ufbxi_sort_material_textures(uc, material->textures.data, material->textures.count));
-		ufbxi_fetch_maps(&uc->scene, material);
 
 		// Fetch `ufbx_material_texture.shader_prop` names
 		if (material->shader) {
@@ -22536,6 +25208,9 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 		}
 	}
 
+	// Fetch material maps, these only read the (now sorted) textures and properties of each material
+	ufbxi_check(ufbxi_run_finalize_tasks(uc, &ufbxi_fetch_maps_fn, &uc->scene, uc->scene.materials.count, NULL, 0));
+
 	ufbxi_for_ptr_list(ufbx_display_layer, p_layer, uc->scene.display_layers) {
 		ufbx_display_layer *layer = *p_layer;
 		ufbxi_check(ufbxi_fetch_dst_elements(uc, &layer->nodes, &layer->element, false, true, NULL, UFBX_ELEMENT_NODE));
@@ -25052,6 +27727,24 @@ static ufbxi_forceinline double ufbxi_find_cubic_bezier_t(double p1, double p2,
 	return t;
 }
 
+// Store evaluated values of a `ufbx_load_opts.float_geometry` attribute as `values_float`,
+// padded like `ufbxi_convert_float_values()`.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_store_float_vec3(ufbx_error *error, ufbxi_buf *buf_result, ufbx_vertex_vec3 *attrib, const ufbx_vec3 *values, size_t num_values)
+{
+	float *dst = ufbxi_push(buf_result, float, num_values * 3 + 4);
+	ufbxi_check_err(error, dst);
+	dst[0] = dst[1] = dst[2] = dst[3] = 0.0f;
+	dst += 4;
+	for (size_t i = 0; i < num_values; i++) {
+		dst[i * 3 + 0] = (float)values[i].x;
+		dst[i * 3 + 1] = (float)values[i].y;
+		dst[i * 3 + 2] = (float)values[i].z;
+	}
+	attrib->values_float.data = dst;
+	attrib->values_float.count = num_values * 3;
+	return 1;
+}
+
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *scene, ufbx_error *error, ufbxi_buf *buf_result, ufbxi_buf *buf_tmp,
 	double time, bool load_caches, ufbx_geometry_cache_data_opts *cache_opts)
 {
@@ -25072,8 +27765,13 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *sc
 		if (mesh->blend_deformers.count == 0 && mesh->skin_deformers.count == 0 && (mesh->cache_deformers.count == 0 || !load_caches)) continue;
 		if (mesh->num_vertices == 0) continue;
 
+		// Positions are only available as `float` with `ufbx_load_opts.float_geometry`,
+		// evaluate in `ufbx_real` and store the results as `float` as well.
 		size_t num_vertices = mesh->num_vertices;
-		ufbx_vec3 *result_pos = ufbxi_push(buf_result, ufbx_vec3, num_vertices + 1);
+		bool float_geometry = mesh->vertices.count == 0;
+		if (float_geometry && mesh->vertex_position.values_float.count < num_vertices * 3) continue;
+
+		ufbx_vec3 *result_pos = ufbxi_push(float_geometry ? buf_tmp : buf_result, ufbx_vec3, num_vertices + 1);
 		ufbxi_check_err(error, result_pos);
 
 		result_pos[0] = ufbx_zero_vec3;
@@ -25093,8 +27791,8 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *sc
 					}
 				} else if (channel->interpretation == UFBX_CACHE_INTERPRETATION_VERTEX_NORMAL && !cached_normals) {
 					// TODO: Is this right at all?
-					size_t num_normals = mesh->skinned_normal.values.count;
-					ufbx_vec3 *normal_data = ufbxi_push(buf_result, ufbx_vec3, num_normals + 1);
+					size_t num_normals = float_geometry ? mesh->skinned_normal.values_float.count / 3 : mesh->skinned_normal.values.count;
+					ufbx_vec3 *normal_data = ufbxi_push(float_geometry ? buf_tmp : buf_result, ufbx_vec3, num_normals + 1);
 					ufbxi_check_err(error, normal_data);
 					normal_data[0] = ufbx_zero_vec3;
 					normal_data++;
@@ -25102,14 +27800,27 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *sc
 					size_t num_read = ufbx_sample_geometry_cache_vec3(channel, time, normal_data, num_normals, cache_opts);
 					if (num_read == num_normals) {
 						cached_normals = true;
-						mesh->skinned_normal.values.data = normal_data;
+						if (float_geometry) {
+							ufbxi_check_err(error, ufbxi_store_float_vec3(error, buf_result, &mesh->skinned_normal, normal_data, num_normals));
+						} else {
+							mesh->skinned_normal.values.data = normal_data;
+						}
 					}
 				}
 			}
 		}
 
 		if (!cached_position) {
-			memcpy(result_pos, mesh->vertices.data, num_vertices * sizeof(ufbx_vec3));
+			if (float_geometry) {
+				const float *src = mesh->vertex_position.values_float.data;
+				for (size_t i = 0; i < num_vertices; i++) {
+					result_pos[i].x = (ufbx_real)src[i * 3 + 0];
+					result_pos[i].y = (ufbx_real)src[i * 3 + 1];
+					result_pos[i].z = (ufbx_real)src[i * 3 + 2];
+				}
+			} else {
+				memcpy(result_pos, mesh->vertices.data, num_vertices * sizeof(ufbx_vec3));
+			}
 
 			ufbxi_for_ptr_list(ufbx_blend_deformer, p_blend, mesh->blend_deformers) {
 				ufbx_add_blend_vertex_offsets(*p_blend, result_pos, num_vertices, 1.0f);
@@ -25128,7 +27839,11 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *sc
 			}
 		}
 
-		mesh->skinned_position.values.data = result_pos;
+		if (float_geometry) {
+			ufbxi_check_err(error, ufbxi_store_float_vec3(error, buf_result, &mesh->skinned_position, result_pos, num_vertices));
+		} else {
+			mesh->skinned_position.values.data = result_pos;
+		}
 
 		if (!cached_normals) {
 			size_t num_indices = mesh->num_indices;
@@ -25142,7 +27857,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *sc
 				mesh->skinned_normal.unique_per_vertex = true;
 			}
 
-			ufbx_vec3 *normal_data = ufbxi_push(buf_result, ufbx_vec3, num_normals + 1);
+			ufbx_vec3 *normal_data = ufbxi_push(float_geometry ? buf_tmp : buf_result, ufbx_vec3, num_normals + 1);
 			ufbxi_check_err(error, normal_data);
 
 			normal_data[0] = ufbx_zero_vec3;
@@ -25152,8 +27867,12 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *sc
 
 			mesh->generated_normals = true;
 			mesh->skinned_normal.exists = true;
-			mesh->skinned_normal.values.data = normal_data;
-			mesh->skinned_normal.values.count = num_normals;
+			if (float_geometry) {
+				ufbxi_check_err(error, ufbxi_store_float_vec3(error, buf_result, &mesh->skinned_normal, normal_data, num_normals));
+			} else {
+				mesh->skinned_normal.values.data = normal_data;
+				mesh->skinned_normal.values.count = num_normals;
+			}
 			mesh->skinned_normal.indices.data = normal_indices;
 			mesh->skinned_normal.indices.count = num_indices;
 			mesh->skinned_normal.value_reals = 3;
@@ -25201,48 +27920,65 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_resolve_warning_elements(ufbxi_c
 	return 1;
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_finish_probe(ufbxi_context *uc)
 {
-	// Check for deferred failure
-	if (uc->deferred_failure) return 0;
-	if (uc->deferred_load) {
-		ufbx_stream stream = { 0 };
-		ufbx_open_file_opts opts = { 0 };
-		const char *filename = uc->load_filename;
-		size_t filename_len = uc->load_filename_len;
-		bool ok = false;
-		if (filename_len == SIZE_MAX) {
-			opts.filename_null_terminated = true;
-			filename_len = strlen(filename);
-		}
-		if (uc->opts.filename.length == 0 || uc->opts.filename.data == NULL) {
-			uc->opts.filename.data = filename;
-			uc->opts.filename.length = filename_len;
-		}
-		ufbx_error error;
-		error.type = UFBX_ERROR_NONE;
-		if (uc->opts.open_main_file_with_default || uc->opts.open_file_cb.fn == &ufbx_default_open_file) {
-			ufbx_open_file_context ctx = (ufbx_open_file_context)&uc->ator_tmp;
-			ok = ufbx_open_file_ctx(&stream, ctx, filename, filename_len, &opts, &error);
-		} else {
-			ok = ufbxi_open_file(&uc->opts.open_file_cb, &stream, uc->load_filename, filename_len, NULL, &uc->ator_tmp, UFBX_OPEN_FILE_MAIN_MODEL);
-		}
-		if (!ok) {
-			if (error.type != UFBX_ERROR_NONE) {
-				// cppcheck-suppress uninitStructMember
-				uc->error = error;
-			} else {
-				ufbxi_set_err_info(&uc->error, filename, filename_len);
-			}
-			ufbxi_fail_msg("open_file_fn()", "File not found");
-		}
-		uc->read_fn = stream.read_fn;
-		uc->skip_fn = stream.skip_fn;
-		uc->size_fn = stream.size_fn;
-		uc->close_fn = stream.close_fn;
-		uc->read_user = stream.user;
+	ufbx_probe_info *info = &uc->probe_info;
+	const ufbx_metadata *metadata = &uc->scene.metadata;
+
+	info->file_format = metadata->file_format;
+	info->ascii = uc->from_ascii;
+	info->big_endian = uc->file_big_endian;
+	info->version = uc->version;
+	info->creator = metadata->creator;
+	info->exporter = metadata->exporter;
+	info->exporter_version = metadata->exporter_version;
+	info->original_application = metadata->original_application;
+	info->latest_application = metadata->latest_application;
+
+	// Retain the info, this must be the final allocation as we copy
+	// `ator_result` to `ufbxi_probe_imp`, see `ufbxi_load_imp()`.
+	ufbxi_probe_imp *imp = ufbxi_push(&uc->result, ufbxi_probe_imp, 1);
+	ufbxi_check(imp);
+
+	ufbxi_init_ref(&imp->refcount, UFBXI_PROBE_IMP_MAGIC, NULL);
+
+	imp->magic = UFBXI_PROBE_IMP_MAGIC;
+	imp->info = *info;
+	imp->refcount.ator = uc->ator_result;
+	imp->refcount.ator.error = NULL;
+
+	imp->refcount.buf = uc->result;
+	imp->refcount.buf.ator = &imp->refcount.ator;
+	imp->string_buf = uc->string_pool.buf;
+	imp->string_buf.ator = &imp->refcount.ator;
+
+	imp->info.result_memory_used = imp->refcount.ator.current_size;
+	imp->info.temp_memory_used = uc->ator_tmp.current_size;
+
+	uc->probe_imp = imp;
+
+	return 1;
+}
+
+static ufbxi_noinline void ufbxi_finish_stats(ufbxi_context *uc)
+{
+	ufbx_load_stats *stats = &uc->stats;
+
+	ufbxi_update_phase_time(uc);
+	for (size_t i = 0; i < UFBX_LOAD_PHASE_COUNT; i++) {
+		stats->total_wall_time += stats->phases[i].wall_time;
+		stats->total_cpu_time += stats->phases[i].cpu_time;
 	}
 
+	stats->num_thread_tasks = (size_t)uc->thread_pool.start_index;
+	stats->peak_temp_memory_used = uc->ator_tmp.peak_size;
+
+	uc->scene.metadata.load_stats = *stats;
+}
+
+// Validate options and initialize the context before reading any data
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_init_load(ufbxi_context *uc)
+{
 	if (uc->opts.progress_cb.fn && uc->progress_bytes_total == 0 && uc->size_fn) {
 		uint64_t total = uc->size_fn(uc->read_user);
 		ufbxi_check(total != UINT64_MAX);
@@ -25258,9 +27994,19 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 
 	ufbxi_check(ufbxi_thread_pool_init(&uc->thread_pool, &uc->error, &uc->ator_tmp, &uc->opts.thread_opts));
 
+	// Tasks run by the loading thread are already included in its CPU time
+	#if UFBXI_HAS_PTHREADS
+		if (uc->collect_stats) {
+			uc->thread_pool.collect_cpu_time = true;
+			uc->thread_pool.clock_cb = uc->opts.clock_cb;
+			uc->thread_pool.owner = pthread_self();
+		}
+	#endif
+
 	if (!uc->opts.allow_unsafe) {
 		ufbxi_check_msg(uc->opts.index_error_handling != UFBX_INDEX_ERROR_HANDLING_UNSAFE_IGNORE, "Unsafe options");
 		ufbxi_check_msg(uc->opts.unicode_error_handling != UFBX_UNICODE_ERROR_HANDLING_UNSAFE_IGNORE, "Unsafe options");
+		ufbxi_check_msg(!uc->opts.borrow_input_arrays, "Unsafe options");
 	} else {
 		uc->scene.metadata.is_unsafe = true;
 	}
@@ -25269,6 +28015,40 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 		uc->scene.metadata.may_contain_no_index = true;
 	}
 
+	// Arrays can reference user memory directly only if they are not modified in place
+	// during loading, mapped files are released before returning so they can't be used.
+	if (uc->opts.borrow_input_arrays && !uc->read_fn && !uc->map_data) {
+		bool flip_winding = uc->opts.reverse_winding || uc->opts.handedness_conversion_axis != UFBX_MIRROR_AXIS_NONE;
+		bool modify_geometry = uc->opts.space_conversion == UFBX_SPACE_CONVERSION_MODIFY_GEOMETRY
+			|| uc->opts.handedness_conversion_axis != UFBX_MIRROR_AXIS_NONE
+			|| uc->opts.geometry_transform_handling == UFBX_GEOMETRY_TRANSFORM_HANDLING_MODIFY_GEOMETRY
+			|| uc->opts.geometry_transform_handling == UFBX_GEOMETRY_TRANSFORM_HANDLING_MODIFY_GEOMETRY_NO_FALLBACK;
+		bool normalize = uc->opts.normalize_normals || uc->opts.normalize_tangents;
+
+		uc->borrow_data = UFBXI_ARRAY_FLAG_BORROW;
+		uc->borrow_indices = flip_winding ? 0 : UFBXI_ARRAY_FLAG_BORROW;
+		uc->borrow_geometry = modify_geometry ? 0 : UFBXI_ARRAY_FLAG_BORROW;
+		uc->borrow_normals = modify_geometry || normalize ? 0 : UFBXI_ARRAY_FLAG_BORROW;
+	}
+
+	// Float geometry is converted at the end of loading so the `ufbx_real` values can be
+	// temporary, unless they need to be retained for the DOM or are already `float`.
+	uc->vertex_values = UFBXI_ARRAY_FLAG_RESULT;
+	if (uc->opts.float_geometry && !uc->opts.retain_dom && sizeof(ufbx_real) != sizeof(float)) {
+		uc->vertex_values = UFBXI_ARRAY_FLAG_TMP_BUF;
+	}
+
+	// Deferred geometry is loaded later from the same memory, see `ufbx_load_mesh_geometry()`.
+	// Mapped files can only be used by `ufbx_load_opts.mesh_stream_cb` before they are released.
+	bool lazy_geometry = uc->opts.lazy_geometry || uc->opts.mesh_stream_cb.fn;
+	if (uc->map_data && !uc->opts.mesh_stream_cb.fn) lazy_geometry = false;
+	if (lazy_geometry && !uc->opts.ignore_geometry && !uc->read_fn) {
+		uc->lazy_geometry = true;
+		uc->lazy_data = uc->data_begin;
+		uc->lazy_size = uc->data_size;
+	}
+	uc->filter_objects = uc->opts.element_filter_cb.fn != NULL || uc->lazy_geometry;
+
 	uc->retain_mesh_parts = !uc->opts.ignore_geometry && !uc->opts.skip_mesh_parts;
 	uc->scene.metadata.may_contain_missing_vertex_position = uc->opts.allow_missing_vertex_position;
 	uc->scene.metadata.may_contain_broken_elements = uc->opts.connect_broken_elements;
@@ -25283,14 +28063,227 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 
 	uc->retain_vertex_w = (uc->opts.retain_dom || uc->opts.retain_vertex_attrib_w) && !uc->opts.ignore_geometry;
 
-	ufbxi_check(ufbxi_load_strings(uc));
+	// Shared strings already contain the global strings, see `ufbxi_init_shared_strings()`
+	if (!uc->shared_strings) {
+		ufbxi_check(ufbxi_load_strings(uc));
+	}
 	ufbxi_check(ufbxi_load_maps(uc));
-	ufbxi_check(ufbxi_determine_format(uc));
+
+	return 1;
+}
+
+typedef struct {
+	uintptr_t src;
+	float *dst;
+} ufbxi_float_values;
+
+// Convert `ufbx_real src[num_reals]` to `float`, arrays shared between attributes
+// (eg. `ufbx_mesh.vertex_uv` and `ufbx_uv_set.vertex_uv`) are converted only once.
+// The result is padded by four zeros in front to match `UFBXI_ARRAY_FLAG_PAD_BEGIN`.
+ufbxi_nodiscard static ufbxi_noinline float *ufbxi_convert_float_values(ufbxi_context *uc, ufbxi_map *map, const ufbx_real *src, size_t num_reals)
+{
+	uintptr_t key = (uintptr_t)src;
+	uint32_t hash = ufbxi_hash_uptr(key);
+	ufbxi_float_values *entry = ufbxi_map_find(map, ufbxi_float_values, hash, &key);
+	if (entry) return entry->dst;
+
+	float *dst = NULL;
+	if (sizeof(ufbx_real) == sizeof(float)) {
+		dst = (float*)src;
+	} else {
+		dst = ufbxi_push(&uc->result, float, num_reals + 4);
+		ufbxi_check_return(dst, NULL);
+		dst[0] = dst[1] = dst[2] = dst[3] = 0.0f;
+		dst += 4;
+		for (size_t i = 0; i < num_reals; i++) {
+			dst[i] = (float)src[i];
+		}
+	}
+
+	entry = ufbxi_map_insert(map, ufbxi_float_values, hash, &key);
+	ufbxi_check_return(entry, NULL);
+	entry->src = key;
+	entry->dst = dst;
+	return dst;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_convert_float_attrib(ufbxi_context *uc, ufbxi_map *map, ufbx_vertex_attrib *attrib, size_t num_components)
+{
+	if (!attrib->exists || attrib->values.count == 0) return 1;
+
+	size_t num_reals = attrib->values.count * num_components;
+	float *data = ufbxi_convert_float_values(uc, map, (const ufbx_real*)attrib->values.data, num_reals);
+	ufbxi_check(data);
+	attrib->values_float.data = data;
+	attrib->values_float.count = num_reals;
+	return 1;
+}
+
+static ufbxi_forceinline void ufbxi_clear_float_attrib(ufbx_vertex_attrib *attrib)
+{
+	if (sizeof(ufbx_real) == sizeof(float)) return;
+	attrib->values.data = NULL;
+	attrib->values.count = 0;
+}
+
+// Store geometry as `float` for `ufbx_load_opts.float_geometry`, values are cleared only
+// after converting everything as attributes may share the same values.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_convert_float_geometry(ufbxi_context *uc)
+{
+	ufbxi_map map; // ufbxi_uninit
+	memset(&map, 0, sizeof(map));
+	ufbxi_map_init(&map, &uc->ator_tmp, &ufbxi_map_cmp_uintptr, NULL);
+
+	int ok = 1;
+	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, uc->scene.meshes) {
+		ufbx_mesh *mesh = *p_mesh;
+		ok = ok && ufbxi_convert_float_attrib(uc, &map, (ufbx_vertex_attrib*)&mesh->vertex_position, 3);
+		ok = ok && ufbxi_convert_float_attrib(uc, &map, (ufbx_vertex_attrib*)&mesh->vertex_normal, 3);
+		ok = ok && ufbxi_convert_float_attrib(uc, &map, (ufbx_vertex_attrib*)&mesh->vertex_uv, 2);
+		ok = ok && ufbxi_convert_float_attrib(uc, &map, (ufbx_vertex_attrib*)&mesh->vertex_tangent, 3);
+		ok = ok && ufbxi_convert_float_attrib(uc, &map, (ufbx_vertex_attrib*)&mesh->vertex_bitangent, 3);
+		ok = ok && ufbxi_convert_float_attrib(uc, &map, (ufbx_vertex_attrib*)&mesh->vertex_color, 4);
+		ok = ok && ufbxi_convert_float_attrib(uc, &map, (ufbx_vertex_attrib*)&mesh->skinned_position, 3);
+		ok = ok && ufbxi_convert_float_attrib(uc, &map, (ufbx_vertex_attrib*)&mesh->skinned_normal, 3);
+		ufbxi_for_list(ufbx_uv_set, set, mesh->uv_sets) {
+			ok = ok && ufbxi_convert_float_attrib(uc, &map, (ufbx_vertex_attrib*)&set->vertex_uv, 2);
+			ok = ok && ufbxi_convert_float_attrib(uc, &map, (ufbx_vertex_attrib*)&set->vertex_tangent, 3);
+			ok = ok && ufbxi_convert_float_attrib(uc, &map, (ufbx_vertex_attrib*)&set->vertex_bitangent, 3);
+		}
+		ufbxi_for_list(ufbx_color_set, set, mesh->color_sets) {
+			ok = ok && ufbxi_convert_float_attrib(uc, &map, (ufbx_vertex_attrib*)&set->vertex_color, 4);
+		}
+	}
+
+	ufbxi_for_ptr_list(ufbx_blend_shape, p_shape, uc->scene.blend_shapes) {
+		ufbx_blend_shape *shape = *p_shape;
+		if (ok && shape->position_offsets.count > 0) {
+			size_t num_reals = shape->position_offsets.count * 3;
+			shape->position_offsets_float.data = ufbxi_convert_float_values(uc, &map, (const ufbx_real*)shape->position_offsets.data, num_reals);
+			shape->position_offsets_float.count = num_reals;
+			ok = shape->position_offsets_float.data != NULL;
+		}
+		if (ok && shape->normal_offsets.count > 0) {
+			size_t num_reals = shape->normal_offsets.count * 3;
+			shape->normal_offsets_float.data = ufbxi_convert_float_values(uc, &map, (const ufbx_real*)shape->normal_offsets.data, num_reals);
+			shape->normal_offsets_float.count = num_reals;
+			ok = shape->normal_offsets_float.data != NULL;
+		}
+	}
+
+	ufbxi_map_free(&map);
+	ufbxi_check(ok);
+
+	if (sizeof(ufbx_real) != sizeof(float)) {
+		ufbxi_for_ptr_list(ufbx_mesh, p_mesh, uc->scene.meshes) {
+			ufbx_mesh *mesh = *p_mesh;
+			mesh->vertices.data = NULL;
+			mesh->vertices.count = 0;
+			ufbxi_clear_float_attrib((ufbx_vertex_attrib*)&mesh->vertex_position);
+			ufbxi_clear_float_attrib((ufbx_vertex_attrib*)&mesh->vertex_normal);
+			ufbxi_clear_float_attrib((ufbx_vertex_attrib*)&mesh->vertex_uv);
+			ufbxi_clear_float_attrib((ufbx_vertex_attrib*)&mesh->vertex_tangent);
+			ufbxi_clear_float_attrib((ufbx_vertex_attrib*)&mesh->vertex_bitangent);
+			ufbxi_clear_float_attrib((ufbx_vertex_attrib*)&mesh->vertex_color);
+			ufbxi_clear_float_attrib((ufbx_vertex_attrib*)&mesh->skinned_position);
+			ufbxi_clear_float_attrib((ufbx_vertex_attrib*)&mesh->skinned_normal);
+			ufbxi_for_list(ufbx_uv_set, set, mesh->uv_sets) {
+				ufbxi_clear_float_attrib((ufbx_vertex_attrib*)&set->vertex_uv);
+				ufbxi_clear_float_attrib((ufbx_vertex_attrib*)&set->vertex_tangent);
+				ufbxi_clear_float_attrib((ufbx_vertex_attrib*)&set->vertex_bitangent);
+			}
+			ufbxi_for_list(ufbx_color_set, set, mesh->color_sets) {
+				ufbxi_clear_float_attrib((ufbx_vertex_attrib*)&set->vertex_color);
+			}
+		}
+		ufbxi_for_ptr_list(ufbx_blend_shape, p_shape, uc->scene.blend_shapes) {
+			ufbx_blend_shape *shape = *p_shape;
+			memset(&shape->position_offsets, 0, sizeof(shape->position_offsets));
+			memset(&shape->normal_offsets, 0, sizeof(shape->normal_offsets));
+		}
+	}
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
+{
+	// Check for deferred failure
+	if (uc->deferred_failure) return 0;
+	if (uc->deferred_load) {
+		ufbx_stream stream = { 0 };
+		ufbx_open_file_opts opts = { 0 };
+		const char *filename = uc->load_filename;
+		size_t filename_len = uc->load_filename_len;
+		bool ok = false;
+		if (filename_len == SIZE_MAX) {
+			opts.filename_null_terminated = true;
+			filename_len = strlen(filename);
+		}
+		if (uc->opts.filename.length == 0 || uc->opts.filename.data == NULL) {
+			uc->opts.filename.data = filename;
+			uc->opts.filename.length = filename_len;
+		}
+		ufbx_error error;
+		error.type = UFBX_ERROR_NONE;
+		bool use_default = uc->opts.open_main_file_with_default || uc->opts.open_file_cb.fn == &ufbx_default_open_file;
+		#if UFBXI_HAS_MMAP
+			if (use_default && uc->opts.map_main_file) {
+				ok = ufbxi_mmap_open(&uc->ator_tmp, filename, filename_len, opts.filename_null_terminated, &uc->map_data, &uc->map_size);
+			}
+		#endif
+		if (ok) {
+			// Parse directly from the mapping as if loading from memory
+			uc->data_begin = uc->data = (const char*)uc->map_data;
+			uc->data_size = uc->map_size;
+			uc->stats.bytes_read += uc->map_size;
+			if (uc->progress_bytes_total == 0) {
+				uc->progress_bytes_total = uc->map_size;
+			}
+		} else if (use_default) {
+			ufbx_open_file_context ctx = (ufbx_open_file_context)&uc->ator_tmp;
+			ok = ufbx_open_file_ctx(&stream, ctx, filename, filename_len, &opts, &error);
+		} else {
+			ok = ufbxi_open_file(&uc->opts.open_file_cb, &stream, uc->load_filename, filename_len, NULL, &uc->ator_tmp, UFBX_OPEN_FILE_MAIN_MODEL);
+		}
+		if (!ok) {
+			if (error.type != UFBX_ERROR_NONE) {
+				// cppcheck-suppress uninitStructMember
+				uc->error = error;
+			} else {
+				ufbxi_set_err_info(&uc->error, filename, filename_len);
+			}
+			ufbxi_fail_msg("open_file_fn()", "File not found");
+		}
+		uc->read_fn = stream.read_fn;
+		uc->skip_fn = stream.skip_fn;
+		uc->size_fn = stream.size_fn;
+		uc->close_fn = stream.close_fn;
+		uc->read_user = stream.user;
+	}
+
+	// Incremental loads have already started in `ufbx_load_feed()`
+	if (!uc->feed_initialized) {
+		ufbxi_check(ufbxi_init_load(uc));
+		ufbxi_check(ufbxi_determine_format(uc));
+	}
 
 	ufbx_file_format format = uc->scene.metadata.file_format;
 
-	if (format == UFBX_FILE_FORMAT_FBX) {
+	if (uc->probe) {
+		ufbxi_check_msg(format == UFBX_FILE_FORMAT_FBX, "Probing is only supported for FBX files");
 		ufbxi_check(ufbxi_begin_parse(uc));
+		ufbxi_check(ufbxi_probe_root(uc));
+		ufbxi_update_scene_metadata(&uc->scene.metadata);
+		ufbxi_check(ufbxi_finish_probe(uc));
+		return 1;
+	}
+
+	if (format == UFBX_FILE_FORMAT_FBX) {
+		if (!uc->feed_parse_begun) {
+			ufbxi_check(ufbxi_begin_parse(uc));
+		}
+		ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_READ_OBJECTS);
 		if (uc->version < 6000) {
 			ufbxi_check(ufbxi_read_legacy_root(uc));
 		} else {
@@ -25302,13 +28295,17 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 		ufbxi_update_scene_metadata(&uc->scene.metadata);
 		ufbxi_check(ufbxi_init_file_paths(uc));
 	} else if (format == UFBX_FILE_FORMAT_OBJ) {
+		ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_PARSE);
 		ufbxi_check(ufbxi_obj_load(uc));
 		ufbxi_update_scene_metadata(&uc->scene.metadata);
 	} else if (format == UFBX_FILE_FORMAT_MTL) {
+		ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_PARSE);
 		ufbxi_check(ufbxi_mtl_load(uc));
 		ufbxi_update_scene_metadata(&uc->scene.metadata);
 	}
 
+	ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_FINALIZE);
+
 	// Fake DOM root if necessary
 	if (uc->opts.retain_dom && !uc->scene.dom_root) {
 		ufbx_dom_node *dom_root = ufbxi_push_zero(&uc->result, ufbx_dom_node, 1);
@@ -25329,6 +28326,8 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 		ufbxi_update_scene_settings_obj(uc);
 	}
 
+	ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_MODIFY_GEOMETRY);
+
 	// Axis conversion
 	if (ufbx_coordinate_axes_valid(uc->opts.target_axes)) {
 		ufbxi_transform_to_axes(uc, uc->opts.target_axes);
@@ -25343,6 +28342,8 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 	ufbxi_update_adjust_transforms(uc, &uc->scene);
 
 	ufbxi_check(ufbxi_modify_geometry(uc));
+
+	ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_FINALIZE);
 	ufbxi_postprocess_scene(uc);
 
 	ufbxi_update_scene(&uc->scene, true, NULL, 0);
@@ -25353,7 +28354,9 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 	}
 
 	if (uc->opts.load_external_files) {
+		ufbx_load_phase prev_phase = ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_EXTERNAL_FILES);
 		ufbxi_check(ufbxi_load_external_files(uc));
+		ufbxi_leave_phase(uc, prev_phase);
 	}
 
 	// Evaluate skinning if requested
@@ -25364,6 +28367,10 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 			0.0, uc->opts.load_external_files && uc->opts.evaluate_caches, &cache_opts));
 	}
 
+	if (uc->opts.float_geometry) {
+		ufbxi_check(ufbxi_convert_float_geometry(uc));
+	}
+
 	// Pop warnings to metadata
 	ufbxi_check(ufbxi_pop_warnings(&uc->warnings, &uc->scene.metadata.warnings, uc->scene.metadata.has_warning));
 	ufbxi_check(ufbxi_resolve_warning_elements(uc));
@@ -25376,6 +28383,31 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 	uc->scene.metadata.animation_ignored = uc->opts.ignore_animation;
 	uc->scene.metadata.embedded_ignored = uc->opts.ignore_embedded;
 
+	if (uc->collect_stats) {
+		ufbxi_finish_stats(uc);
+	}
+
+	size_t num_lazy_meshes = uc->tmp_lazy_meshes.num_items;
+	ufbxi_lazy_mesh *lazy_meshes = ufbxi_push_pop(&uc->result, &uc->tmp_lazy_meshes, ufbxi_lazy_mesh, num_lazy_meshes);
+	ufbxi_check(lazy_meshes);
+	uc->scene.metadata.geometry_deferred = num_lazy_meshes > 0;
+
+	// Estimate the input size of each deferred object for batching `ufbxi_stream_meshes()`
+	size_t num_lazy_offsets = uc->tmp_lazy_offsets.num_items;
+	uint64_t *lazy_offsets = ufbxi_push_pop(&uc->tmp, &uc->tmp_lazy_offsets, uint64_t, num_lazy_offsets);
+	ufbxi_check(lazy_offsets);
+	for (size_t i = 0; i < num_lazy_meshes; i++) {
+		ufbxi_lazy_mesh *lazy = &lazy_meshes[i];
+		ufbxi_check(lazy->index < num_lazy_offsets);
+		uint64_t begin = lazy_offsets[lazy->index];
+		uint64_t end = (uint64_t)uc->lazy_size;
+		if (i + 1 < num_lazy_meshes) {
+			ufbxi_check(lazy_meshes[i + 1].index < num_lazy_offsets);
+			end = lazy_offsets[lazy_meshes[i + 1].index];
+		}
+		lazy->size = end > begin ? end - begin : 0;
+	}
+
 	// Retain the scene, this must be the final allocation as we copy
 	// `ator_result` to `ufbx_scene_imp`.
 	ufbxi_scene_imp *imp = ufbxi_push(&uc->result, ufbxi_scene_imp, 1);
@@ -25395,233 +28427,2795 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 	imp->string_buf = uc->string_pool.buf;
 	imp->string_buf.ator = &imp->refcount.ator;
 
-	imp->scene.metadata.result_memory_used = imp->refcount.ator.current_size;
-	imp->scene.metadata.temp_memory_used = uc->ator_tmp.current_size;
-	imp->scene.metadata.result_allocs = imp->refcount.ator.num_allocs;
-	imp->scene.metadata.temp_allocs = uc->ator_tmp.num_allocs;
+	// Options referring to user memory are not needed when reloading geometry
+	imp->lazy_meshes = lazy_meshes;
+	imp->num_lazy_meshes = num_lazy_meshes;
+	if (num_lazy_meshes > 0) {
+		imp->lazy_data = uc->lazy_data;
+		imp->lazy_size = uc->lazy_size;
+		imp->lazy_opts = uc->opts;
+		imp->lazy_opts.filename = uc->scene.metadata.filename;
+		memset(&imp->lazy_opts.raw_filename, 0, sizeof(imp->lazy_opts.raw_filename));
+		memset(&imp->lazy_opts.obj_mtl_data, 0, sizeof(imp->lazy_opts.obj_mtl_data));
+	}
+
+	imp->opts_hash = uc->opts_hash;
+
+	imp->scene.metadata.result_memory_used = imp->refcount.ator.current_size;
+	imp->scene.metadata.temp_memory_used = uc->ator_tmp.current_size;
+	imp->scene.metadata.result_allocs = imp->refcount.ator.num_allocs;
+	imp->scene.metadata.temp_allocs = uc->ator_tmp.num_allocs;
+
+	ufbxi_for_ptr_list(ufbx_element, p_elem, imp->scene.elements) {
+		(*p_elem)->scene = &imp->scene;
+	}
+
+	uc->scene_imp = imp;
+
+	return 1;
+}
+
+static ufbxi_noinline void ufbxi_free_temp(ufbxi_context *uc)
+{
+	ufbxi_thread_pool_free(&uc->thread_pool);
+
+	ufbxi_string_pool_temp_free(&uc->string_pool);
+	ufbxi_buf_free(&uc->warnings.tmp_stack);
+
+	ufbxi_map_free(&uc->prop_type_map);
+	ufbxi_map_free(&uc->fbx_id_map);
+	ufbxi_map_free(&uc->ptr_fbx_id_map);
+	ufbxi_map_free(&uc->texture_file_map);
+	ufbxi_map_free(&uc->anim_stack_map);
+	ufbxi_map_free(&uc->fbx_attr_map);
+	ufbxi_map_free(&uc->node_prop_set);
+	ufbxi_map_free(&uc->dom_node_map);
+
+	ufbxi_buf_free(&uc->tmp);
+	ufbxi_buf_free(&uc->tmp_parse);
+	for (size_t i = 0; i < UFBX_THREAD_GROUP_COUNT; i++) {
+		ufbxi_buf_free(&uc->tmp_thread_parse[i]);
+	}
+	ufbxi_buf_free(&uc->tmp_stack);
+	ufbxi_buf_free(&uc->tmp_connections);
+	ufbxi_buf_free(&uc->tmp_node_ids);
+	ufbxi_buf_free(&uc->tmp_elements);
+	ufbxi_buf_free(&uc->tmp_element_offsets);
+	ufbxi_buf_free(&uc->tmp_element_fbx_ids);
+	ufbxi_buf_free(&uc->tmp_element_ptrs);
+	for (size_t i = 0; i < UFBX_ELEMENT_TYPE_COUNT; i++) {
+		ufbxi_buf_free(&uc->tmp_typed_element_offsets[i]);
+	}
+	ufbxi_buf_free(&uc->tmp_mesh_textures);
+	ufbxi_buf_free(&uc->tmp_full_weights);
+	ufbxi_buf_free(&uc->tmp_dom_nodes);
+	ufbxi_buf_free(&uc->tmp_element_id);
+	ufbxi_buf_free(&uc->tmp_ascii_spans);
+	ufbxi_buf_free(&uc->tmp_probe_node_names);
+	ufbxi_buf_free(&uc->tmp_probe_mesh_names);
+	ufbxi_buf_free(&uc->tmp_probe_material_names);
+	ufbxi_buf_free(&uc->tmp_probe_stacks);
+	ufbxi_buf_free(&uc->tmp_lazy_meshes);
+	ufbxi_buf_free(&uc->tmp_lazy_offsets);
+
+	ufbxi_free(&uc->ator_tmp, ufbxi_node, uc->top_nodes, uc->top_nodes_cap);
+	ufbxi_free(&uc->ator_tmp, void*, uc->element_extra_arr, uc->element_extra_cap);
+
+	ufbxi_free(&uc->ator_tmp, char, uc->ascii.token.str_data, uc->ascii.token.str_cap);
+	ufbxi_free(&uc->ator_tmp, char, uc->ascii.prev_token.str_data, uc->ascii.prev_token.str_cap);
+
+	ufbxi_free(&uc->ator_tmp, char, uc->read_buffer, uc->read_buffer_size);
+	ufbxi_free(&uc->ator_tmp, char, uc->tmp_arr, uc->tmp_arr_size);
+	ufbxi_free(&uc->ator_tmp, char, uc->swap_arr, uc->swap_arr_size);
+
+	ufbxi_obj_free(uc);
+
+	ufbxi_free_ator(&uc->ator_tmp);
+}
+
+static ufbxi_noinline void ufbxi_free_result(ufbxi_context *uc)
+{
+	ufbxi_buf_free(&uc->result);
+	ufbxi_buf_free(&uc->string_pool.buf);
+
+	ufbxi_free_ator(&uc->ator_result);
+}
+
+static ufbxi_noinline ufbx_mesh *ufbxi_load_mesh_geometry(const ufbx_mesh *mesh, ufbx_error *p_error);
+static ufbxi_noinline const ufbxi_lazy_mesh *ufbxi_find_lazy_mesh(const ufbxi_scene_imp *imp, uint32_t element_id);
+static ufbxi_noinline ufbx_scene *ufbxi_reload_lazy_scene(ufbxi_scene_imp *scene_imp, uint32_t begin, uint32_t end, ufbx_error *p_error);
+static ufbxi_noinline ufbx_mesh *ufbxi_make_lazy_mesh(ufbx_scene *scene, const ufbx_mesh *mesh, ufbx_allocator_opts *ator_opts, ufbx_error *p_error);
+
+// Pass meshes one at a time to `ufbx_load_opts.mesh_stream_cb`, deferred geometry
+// is loaded from the input that is still available at this point. Each reload parses
+// the whole file, so consecutive deferred objects are loaded together in batches of
+// up to `UFBXI_LAZY_STREAM_BATCH_BYTES` of input (or a single larger object).
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_stream_meshes(ufbxi_context *uc)
+{
+	ufbxi_scene_imp *imp = uc->scene_imp;
+
+	ufbx_scene *batch = NULL;
+	uint32_t batch_begin = 0, batch_end = 0;
+
+	ufbx_error error = { UFBX_ERROR_NONE };
+	bool cancelled = false;
+	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, imp->scene.meshes) {
+		ufbx_mesh *mesh = NULL;
+		const ufbxi_lazy_mesh *lazy = ufbxi_find_lazy_mesh(imp, (*p_mesh)->element.element_id);
+		if (lazy) {
+			if (!batch || lazy->index < batch_begin || lazy->index >= batch_end) {
+				if (batch) ufbx_free_scene(batch);
+
+				// Extend the batch over the following deferred meshes, other deferred
+				// objects in between are included in the size of the preceding mesh.
+				const ufbxi_lazy_mesh *lazy_end = imp->lazy_meshes + imp->num_lazy_meshes;
+				uint64_t batch_size = lazy->size;
+				batch_begin = lazy->index;
+				batch_end = lazy->index + 1;
+				for (const ufbxi_lazy_mesh *next = lazy + 1; next != lazy_end; next++) {
+					if (next->index < batch_end || batch_size + next->size > UFBXI_LAZY_STREAM_BATCH_BYTES) break;
+					batch_size += next->size;
+					batch_end = next->index + 1;
+				}
+
+				batch = ufbxi_reload_lazy_scene(imp, batch_begin, batch_end, &error);
+				if (!batch) break;
+			}
+
+			ufbx_retain_scene(batch);
+			mesh = ufbxi_make_lazy_mesh(batch, *p_mesh, &imp->lazy_opts.result_allocator, &error);
+		} else {
+			mesh = ufbxi_load_mesh_geometry(*p_mesh, &error);
+		}
+		if (!mesh) break;
+
+		bool keep_going = uc->opts.mesh_stream_cb.fn(uc->opts.mesh_stream_cb.user, mesh);
+		ufbx_free_mesh(mesh);
+		if (!keep_going) {
+			cancelled = true;
+			break;
+		}
+	}
+
+	if (batch) ufbx_free_scene(batch);
+	if (error.type != UFBX_ERROR_NONE) {
+		uc->error = error;
+		return 0;
+	}
+	ufbxi_check_msg(!cancelled, "Cancelled");
+
+	// Mapped files are released after loading
+	if (uc->map_data) {
+		imp->lazy_meshes = NULL;
+		imp->num_lazy_meshes = 0;
+	}
+
+	return 1;
+}
+
+static ufbxi_forceinline uint64_t ufbxi_hash_bytes64(uint64_t hash, const void *data, size_t size)
+{
+	const uint8_t *bytes = (const uint8_t*)data;
+	for (size_t i = 0; i < size; i++) {
+		hash = (hash ^ bytes[i]) * UINT64_C(0x100000001b3);
+	}
+	return hash;
+}
+
+// Hash of the options that affect the contents of the loaded scene. Options that only
+// affect how the file is read (allocators, threads, IO callbacks) are not included.
+// Scalar options are copied to a zeroed struct so padding and pointers don't matter.
+static ufbxi_noinline uint64_t ufbxi_hash_load_opts(const ufbx_load_opts *opts)
+{
+	ufbx_load_opts key; // ufbxi_uninit
+	memset(&key, 0, sizeof(key));
+
+	key.ignore_geometry = opts->ignore_geometry;
+	key.ignore_animation = opts->ignore_animation;
+	key.ignore_embedded = opts->ignore_embedded;
+	key.ignore_all_content = opts->ignore_all_content;
+	key.lazy_geometry = opts->lazy_geometry;
+	key.evaluate_skinning = opts->evaluate_skinning;
+	key.evaluate_caches = opts->evaluate_caches;
+	key.load_external_files = opts->load_external_files;
+	key.ignore_missing_external_files = opts->ignore_missing_external_files;
+	key.skip_skin_vertices = opts->skip_skin_vertices;
+	key.skip_mesh_parts = opts->skip_mesh_parts;
+	key.clean_skin_weights = opts->clean_skin_weights;
+	key.use_blender_pbr_material = opts->use_blender_pbr_material;
+	key.disable_quirks = opts->disable_quirks;
+	key.strict = opts->strict;
+	key.allow_unsafe = opts->allow_unsafe;
+	key.borrow_input_arrays = opts->borrow_input_arrays;
+	key.index_error_handling = opts->index_error_handling;
+	key.connect_broken_elements = opts->connect_broken_elements;
+	key.allow_nodes_out_of_root = opts->allow_nodes_out_of_root;
+	key.allow_missing_vertex_position = opts->allow_missing_vertex_position;
+	key.allow_empty_faces = opts->allow_empty_faces;
+	key.generate_missing_normals = opts->generate_missing_normals;
+	key.path_separator = opts->path_separator;
+	key.node_depth_limit = opts->node_depth_limit;
+	key.geometry_transform_handling = opts->geometry_transform_handling;
+	key.inherit_mode_handling = opts->inherit_mode_handling;
+	key.space_conversion = opts->space_conversion;
+	key.pivot_handling = opts->pivot_handling;
+	key.pivot_handling_retain_empties = opts->pivot_handling_retain_empties;
+	key.handedness_conversion_axis = opts->handedness_conversion_axis;
+	key.handedness_conversion_retain_winding = opts->handedness_conversion_retain_winding;
+	key.reverse_winding = opts->reverse_winding;
+	key.target_axes = opts->target_axes;
+	key.target_unit_meters = opts->target_unit_meters;
+	key.target_camera_axes = opts->target_camera_axes;
+	key.target_light_axes = opts->target_light_axes;
+	key.normalize_normals = opts->normalize_normals;
+	key.normalize_tangents = opts->normalize_tangents;
+	key.use_root_transform = opts->use_root_transform;
+	key.root_transform = opts->root_transform;
+	key.key_clamp_threshold = opts->key_clamp_threshold;
+	key.unicode_error_handling = opts->unicode_error_handling;
+	key.retain_vertex_attrib_w = opts->retain_vertex_attrib_w;
+	key.float_geometry = opts->float_geometry;
+	key.retain_dom = opts->retain_dom;
+	key.file_format = opts->file_format;
+	key.no_format_from_content = opts->no_format_from_content;
+	key.no_format_from_extension = opts->no_format_from_extension;
+	key.obj_search_mtl_by_filename = opts->obj_search_mtl_by_filename;
+	key.obj_merge_objects = opts->obj_merge_objects;
+	key.obj_merge_groups = opts->obj_merge_groups;
+	key.obj_split_groups = opts->obj_split_groups;
+	key.obj_unit_meters = opts->obj_unit_meters;
+	key.obj_axes = opts->obj_axes;
+
+	// Callbacks can only be compared by presence
+	key.element_filter_cb.user = (void*)(uintptr_t)(opts->element_filter_cb.fn ? 1 : 0);
+	key.mesh_stream_cb.user = (void*)(uintptr_t)(opts->mesh_stream_cb.fn ? 1 : 0);
+
+	uint64_t hash = ufbxi_hash_bytes64(UINT64_C(0xcbf29ce484222325), &key, sizeof(key));
+
+	const ufbx_string strs[] = {
+		opts->geometry_transform_helper_name,
+		opts->scale_helper_name,
+		opts->obj_mtl_path,
+	};
+	ufbxi_for(const ufbx_string, str, strs, ufbxi_arraycount(strs)) {
+		size_t length = str->data ? (str->length == SIZE_MAX ? strlen(str->data) : str->length) : 0;
+		hash = ufbxi_hash_bytes64(hash, &length, sizeof(length));
+		hash = ufbxi_hash_bytes64(hash, str->data, length);
+	}
+	hash = ufbxi_hash_bytes64(hash, &opts->obj_mtl_data.size, sizeof(opts->obj_mtl_data.size));
+	hash = ufbxi_hash_bytes64(hash, opts->obj_mtl_data.data, opts->obj_mtl_data.size);
+
+	return hash;
+}
+
+static ufbxi_noinline void ufbxi_begin_load(ufbxi_context *uc, const ufbx_load_opts *user_opts, ufbx_inflate_retain *inflate_retain)
+{
+	// Test endianness
+	{
+		uint8_t buf[2];
+		uint16_t val = 0xbbaa;
+		memcpy(buf, &val, 2);
+		uc->local_big_endian = buf[0] == 0xbb;
+	}
+
+	uc->double_parse_flags = ufbxi_parse_double_init_flags();
+
+	if (user_opts) {
+		uc->opts = *user_opts;
+	} else {
+		memset(&uc->opts, 0, sizeof(uc->opts));
+	}
+
+	uc->opts_hash = ufbxi_hash_load_opts(&uc->opts);
+
+	if (uc->opts.file_size_estimate) {
+		uc->progress_bytes_total = uc->opts.file_size_estimate;
+	}
+
+	// Probing never needs any content or threads, see `ufbxi_probe_root()`
+	if (uc->probe) {
+		uc->opts.ignore_all_content = true;
+		uc->opts.retain_dom = false;
+		uc->opts.load_external_files = false;
+		uc->opts.element_filter_cb.fn = NULL;
+		memset(&uc->opts.thread_opts, 0, sizeof(uc->opts.thread_opts));
+	}
+
+	if (uc->opts.ignore_all_content) {
+		uc->opts.ignore_geometry = true;
+		uc->opts.ignore_animation = true;
+		uc->opts.ignore_embedded = true;
+	}
+
+	inflate_retain->initialized = false;
+
+	ufbxi_init_ator(&uc->error, &uc->ator_tmp, &uc->opts.temp_allocator, "temp");
+	ufbxi_init_ator(&uc->error, &uc->ator_result, &uc->opts.result_allocator, "result");
+	uc->ator_tmp.budget = uc->memory_budget;
+	uc->ator_result.budget = uc->memory_budget;
+
+	if (uc->opts.read_buffer_size == 0) {
+		uc->opts.read_buffer_size = 0x4000;
+	}
+	if (uc->opts.read_buffer_size <= 32) {
+		uc->opts.read_buffer_size = 32;
+	}
+
+	if (uc->opts.file_format_lookahead == 0) {
+		uc->opts.file_format_lookahead = 0x4000;
+	} else if (uc->opts.file_format_lookahead < UFBXI_MIN_FILE_FORMAT_LOOKAHEAD) {
+		uc->opts.file_format_lookahead = UFBXI_MIN_FILE_FORMAT_LOOKAHEAD;
+	}
+
+	if (!uc->opts.path_separator) {
+		uc->opts.path_separator = UFBX_PATH_SEPARATOR;
+	}
+
+	if (!uc->opts.progress_cb.fn || uc->opts.progress_interval_hint >= SIZE_MAX) {
+		uc->progress_interval = SIZE_MAX;
+	} else if (uc->opts.progress_interval_hint > 0) {
+		uc->progress_interval = (size_t)uc->opts.progress_interval_hint;
+	} else {
+		uc->progress_interval = 0x4000;
+	}
+
+	if (!uc->opts.open_file_cb.fn) {
+		uc->opts.open_file_cb.fn = &ufbx_default_open_file;
+	}
+
+	if (!uc->opts.thread_opts.memory_limit) {
+		uc->opts.thread_opts.memory_limit = 32*1024*1024;
+	}
+
+	uc->synthetic_id_counter = UFBXI_SYNTHETIC_ID_START;
+
+	uc->string_pool.error = &uc->error;
+	ufbxi_map_init(&uc->string_pool.map, &uc->ator_tmp, &ufbxi_map_cmp_string, NULL);
+	uc->string_pool.buf.ator = &uc->ator_result;
+	uc->string_pool.buf.unordered = true;
+	uc->string_pool.shared = uc->shared_strings;
+	uc->string_pool.initial_size = 1024;
+	uc->string_pool.error_handling = uc->opts.unicode_error_handling;
+
+	ufbxi_map_init(&uc->prop_type_map, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
+	ufbxi_map_init(&uc->fbx_id_map, &uc->ator_tmp, &ufbxi_map_cmp_uint64, NULL);
+	ufbxi_map_init(&uc->ptr_fbx_id_map, &uc->ator_tmp, &ufbxi_map_cmp_ptr_id, NULL);
+	ufbxi_map_init(&uc->texture_file_map, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
+	ufbxi_map_init(&uc->anim_stack_map, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
+	ufbxi_map_init(&uc->fbx_attr_map, &uc->ator_tmp, &ufbxi_map_cmp_uint64, NULL);
+	ufbxi_map_init(&uc->node_prop_set, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
+	ufbxi_map_init(&uc->dom_node_map, &uc->ator_tmp, &ufbxi_map_cmp_uintptr, NULL);
+
+	uc->tmp.ator = &uc->ator_tmp;
+	uc->tmp_parse.ator = &uc->ator_tmp;
+	uc->tmp_stack.ator = &uc->ator_tmp;
+	uc->tmp_connections.ator = &uc->ator_tmp;
+	uc->tmp_node_ids.ator = &uc->ator_tmp;
+	uc->tmp_elements.ator = &uc->ator_tmp;
+	uc->tmp_element_offsets.ator = &uc->ator_tmp;
+	uc->tmp_element_fbx_ids.ator = &uc->ator_tmp;
+	uc->tmp_element_ptrs.ator = &uc->ator_tmp;
+	for (size_t i = 0; i < UFBX_ELEMENT_TYPE_COUNT; i++) {
+		uc->tmp_typed_element_offsets[i].ator = &uc->ator_tmp;
+	}
+	uc->tmp_mesh_textures.ator = &uc->ator_tmp;
+	uc->tmp_full_weights.ator = &uc->ator_tmp;
+	uc->tmp_dom_nodes.ator = &uc->ator_tmp;
+	uc->tmp_element_id.ator = &uc->ator_tmp;
+	uc->tmp_ascii_spans.ator = &uc->ator_tmp;
+	uc->tmp_probe_node_names.ator = &uc->ator_tmp;
+	uc->tmp_probe_mesh_names.ator = &uc->ator_tmp;
+	uc->tmp_probe_material_names.ator = &uc->ator_tmp;
+	uc->tmp_probe_stacks.ator = &uc->ator_tmp;
+	uc->tmp_lazy_meshes.ator = &uc->ator_tmp;
+	uc->tmp_lazy_offsets.ator = &uc->ator_tmp;
+
+	for (size_t i = 0; i < UFBX_THREAD_GROUP_COUNT; i++) {
+		uc->tmp_thread_parse[i].ator = &uc->ator_tmp;
+		uc->tmp_thread_parse[i].unordered = true;
+		uc->tmp_thread_parse[i].clearable = true;
+	}
+
+	uc->result.ator = &uc->ator_result;
+
+	uc->tmp.unordered = true;
+	uc->tmp_parse.unordered = true;
+	uc->tmp_parse.clearable = true;
+	uc->result.unordered = true;
+
+	uc->warnings.error = &uc->error;
+	uc->warnings.result = &uc->result;
+	uc->warnings.tmp_stack.ator = &uc->ator_tmp;
+	uc->string_pool.warnings = &uc->warnings;
+
+	// Set zero size `swap_arr` to a non-NULL buffer so we can tell the difference between empty
+	// array and an allocation failure.
+	uc->swap_arr = (char*)ufbxi_zero_size_buffer;
+
+	uc->inflate_retain = inflate_retain;
+
+	// Time is attributed to `UFBX_LOAD_PHASE_SETUP` until the first phase switch
+	if (uc->opts.collect_load_stats) {
+		uc->collect_stats = true;
+		uc->stats.enabled = true;
+		uc->stats.has_time = uc->opts.clock_cb.fn != NULL || UFBXI_HAS_CLOCK;
+		uc->stats.bytes_read = uc->data_size;
+		uc->stats.phases[UFBX_LOAD_PHASE_SETUP].count = 1;
+		uc->stats_phase = UFBX_LOAD_PHASE_SETUP;
+		uc->stats_wall_time = ufbxi_clock(uc, false);
+		uc->stats_cpu_time = ufbxi_clock(uc, true);
+	}
+}
+
+static ufbxi_noinline ufbx_scene *ufbxi_end_load(ufbxi_context *uc, int ok, ufbx_error *p_error)
+{
+	if (uc->close_fn) {
+		uc->close_fn(uc->read_user);
+	}
+
+	ufbxi_free_temp(uc);
+
+	// Stream meshes after releasing temporary memory but before unmapping the input
+	if (ok && uc->scene_imp && uc->opts.mesh_stream_cb.fn) {
+		ok = ufbxi_stream_meshes(uc);
+	}
+
+	#if UFBXI_HAS_MMAP
+		if (uc->map_data) {
+			ufbxi_mmap_close(uc->map_data, uc->map_size);
+		}
+	#endif
+
+	if (ok) {
+		if (p_error) {
+			ufbxi_clear_error(p_error);
+		}
+		if (uc->probe) return NULL;
+		return &uc->scene_imp->scene;
+	} else {
+		ufbxi_fix_error_type(&uc->error, "Failed to load", p_error);
+		if (p_error && p_error->type == UFBX_ERROR_UNKNOWN && uc->scene.metadata.file_format == UFBX_FILE_FORMAT_FBX && !ufbxi_supports_version(uc->version)) {
+			p_error->description.data = "Unsupported version";
+			p_error->description.length = strlen("Unsupported version");
+			p_error->type = UFBX_ERROR_UNSUPPORTED_VERSION;
+			ufbxi_fmt_err_info(p_error, "%u", uc->version);
+		}
+		if (uc->scene_imp) {
+			// Result buffers have been moved to the scene already
+			ufbx_free_scene(&uc->scene_imp->scene);
+		} else {
+			ufbxi_free_result(uc);
+		}
+		return NULL;
+	}
+}
+
+static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_opts *user_opts, ufbx_error *p_error)
+{
+	ufbx_inflate_retain inflate_retain; // ufbxi_uninit
+	ufbxi_begin_load(uc, user_opts, &inflate_retain);
+
+	// NOTE: Though `inflate_retain` leaks out of the scope we don't use it outside this function.
+	int ok = ufbxi_load_imp(uc);
+	return ufbxi_end_load(uc, ok, p_error);
+}
+
+// -- Lazy geometry
+
+static ufbxi_noinline const ufbxi_lazy_mesh *ufbxi_find_lazy_mesh(const ufbxi_scene_imp *imp, uint32_t element_id)
+{
+	size_t ix = SIZE_MAX;
+	ufbxi_macro_lower_bound_eq(ufbxi_lazy_mesh, 32, &ix, imp->lazy_meshes, 0, imp->num_lazy_meshes,
+		(a->element_id < element_id),
+		(a->element_id == element_id));
+	return ix != SIZE_MAX ? &imp->lazy_meshes[ix] : NULL;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_retain_lazy_mesh(ufbx_error *error, ufbxi_buf *result, ufbx_scene *scene, const ufbx_mesh *mesh, ufbxi_mesh_imp **p_imp)
+{
+	// The reloaded scene must have identical elements up to the mesh, this only
+	// fails if `ufbx_load_opts.element_filter_cb` returns different results.
+	uint32_t element_id = mesh->element.element_id;
+	ufbxi_check_err_msg(error, element_id < scene->elements.count, "Lazy geometry mismatch");
+	ufbx_element *element = scene->elements.data[element_id];
+	ufbxi_check_err_msg(error, element->type == UFBX_ELEMENT_MESH, "Lazy geometry mismatch");
+	ufbxi_check_err_msg(error, ufbxi_str_equal(element->name, mesh->element.name), "Lazy geometry mismatch");
+
+	ufbxi_mesh_imp *imp = ufbxi_push(result, ufbxi_mesh_imp, 1);
+	ufbxi_check_err(error, imp);
+
+	ufbxi_init_ref(&imp->refcount, UFBXI_MESH_IMP_MAGIC, &(ufbxi_get_imp(ufbxi_scene_imp, scene))->refcount);
+
+	imp->magic = UFBXI_MESH_IMP_MAGIC;
+	imp->mesh = *(ufbx_mesh*)element;
+	imp->mesh.from_lazy_geometry = true;
+
+	*p_imp = imp;
+	return 1;
+}
+
+// Reload the scene loading the geometry of deferred objects `[begin, end)`
+static ufbxi_noinline ufbx_scene *ufbxi_reload_lazy_scene(ufbxi_scene_imp *scene_imp, uint32_t begin, uint32_t end, ufbx_error *p_error)
+{
+	ufbx_load_opts opts = scene_imp->lazy_opts;
+
+	// Animation and embedded content are not needed for geometry
+	opts.ignore_animation = true;
+	opts.ignore_embedded = true;
+	opts.load_external_files = false;
+	opts.lazy_geometry = true;
+	opts.mesh_stream_cb.fn = NULL;
+
+	ufbxi_context uc; // ufbxi_uninit
+	memset(&uc, 0, sizeof(ufbxi_context));
+	uc.data_begin = uc.data = scene_imp->lazy_data;
+	uc.data_size = scene_imp->lazy_size;
+	uc.progress_bytes_total = scene_imp->lazy_size;
+	uc.lazy_reload = true;
+	uc.lazy_target = begin;
+	uc.lazy_target_end = end;
+
+	return ufbxi_load(&uc, &opts, p_error);
+}
+
+// Return a reference to `mesh` in `scene` (original or reloaded), consumes a reference to `scene`
+static ufbxi_noinline ufbx_mesh *ufbxi_make_lazy_mesh(ufbx_scene *scene, const ufbx_mesh *mesh, ufbx_allocator_opts *ator_opts, ufbx_error *p_error)
+{
+	ufbx_error error = { UFBX_ERROR_NONE };
+	ufbxi_allocator ator_result; // ufbxi_uninit
+	memset(&ator_result, 0, sizeof(ator_result));
+	ufbxi_init_ator(&error, &ator_result, ator_opts, "result");
+	ufbxi_buf result = { &ator_result };
+
+	// `imp` retains `scene` on success
+	ufbxi_mesh_imp *imp = NULL;
+	int ok = ufbxi_retain_lazy_mesh(&error, &result, scene, mesh, &imp);
+	ufbx_free_scene(scene);
+
+	if (ok) {
+		ufbxi_clear_error(p_error);
+		imp->refcount.ator = ator_result;
+		imp->refcount.ator.error = NULL;
+		imp->refcount.buf = result;
+		return &imp->mesh;
+	} else {
+		ufbxi_fix_error_type(&error, "Failed to load geometry", p_error);
+		ufbxi_buf_free(&result);
+		ufbxi_free_ator(&ator_result);
+		return NULL;
+	}
+}
+
+static ufbxi_noinline ufbx_mesh *ufbxi_load_mesh_geometry(const ufbx_mesh *mesh, ufbx_error *p_error)
+{
+	ufbxi_scene_imp *scene_imp = ufbxi_get_imp(ufbxi_scene_imp, mesh->element.scene);
+	ufbx_assert(scene_imp->magic == UFBXI_SCENE_IMP_MAGIC);
+	if (scene_imp->magic != UFBXI_SCENE_IMP_MAGIC) return NULL;
+
+	// Meshes returned from other functions already own a reference
+	if (mesh->subdivision_evaluated || mesh->from_tessellated_nurbs || mesh->from_lazy_geometry) {
+		ufbxi_clear_error(p_error);
+		ufbx_retain_mesh((ufbx_mesh*)mesh);
+		return (ufbx_mesh*)mesh;
+	}
+
+	ufbx_scene *scene = NULL;
+	ufbx_allocator_opts ator_opts = scene_imp->lazy_opts.result_allocator;
+
+	const ufbxi_lazy_mesh *lazy = ufbxi_find_lazy_mesh(scene_imp, mesh->element.element_id);
+	if (lazy) {
+		scene = ufbxi_reload_lazy_scene(scene_imp, lazy->index, lazy->index + 1, p_error);
+		if (!scene) return NULL;
+	} else {
+		// Not deferred, return a reference to the mesh that keeps the scene alive
+		scene = &scene_imp->scene;
+		ufbx_retain_scene(scene);
+		ator_opts = scene_imp->refcount.ator.ator;
+	}
+
+	return ufbxi_make_lazy_mesh(scene, mesh, &ator_opts, p_error);
+}
+
+// -- Incremental loading
+
+typedef struct ufbxi_feed_chunk ufbxi_feed_chunk;
+
+// Copy of data passed to `ufbx_load_feed()`, followed by `size` bytes
+struct ufbxi_feed_chunk {
+	ufbxi_feed_chunk *next;
+	size_t size;
+	size_t offset;
+};
+
+struct ufbx_loader {
+	uint32_t magic;
+	bool failed;
+
+	// Allocator for `ufbx_loader` itself, everything else uses `uc.ator_tmp`
+	ufbxi_allocator ator;
+
+	ufbxi_context uc;
+	ufbx_inflate_retain inflate_retain;
+
+	ufbxi_feed_chunk *chunks, *chunks_tail;
+};
+
+static size_t ufbxi_loader_read(void *user, void *data, size_t size)
+{
+	ufbx_loader *loader = (ufbx_loader*)user;
+	size_t num_read = 0;
+
+	while (num_read < size && loader->chunks) {
+		ufbxi_feed_chunk *chunk = loader->chunks;
+		size_t to_read = ufbxi_min_sz(size - num_read, chunk->size - chunk->offset);
+		memcpy((char*)data + num_read, (const char*)(chunk + 1) + chunk->offset, to_read);
+		num_read += to_read;
+		chunk->offset += to_read;
+
+		if (chunk->offset == chunk->size) {
+			loader->chunks = chunk->next;
+			if (!loader->chunks) loader->chunks_tail = NULL;
+			ufbxi_free(&loader->uc.ator_tmp, char, (char*)chunk, sizeof(ufbxi_feed_chunk) + chunk->size);
+		}
+	}
+
+	return num_read;
+}
+
+static void ufbxi_loader_close(void *user)
+{
+	ufbx_loader *loader = (ufbx_loader*)user;
+	while (loader->chunks) {
+		ufbxi_feed_chunk *chunk = loader->chunks;
+		loader->chunks = chunk->next;
+		ufbxi_free(&loader->uc.ator_tmp, char, (char*)chunk, sizeof(ufbxi_feed_chunk) + chunk->size);
+	}
+	loader->chunks_tail = NULL;
+}
+
+// Start loading and parse as far as the data fed so far allows. Only binary FBX files
+// are parsed incrementally, other formats are buffered until `ufbx_load_finish()`.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_feed_imp(ufbxi_context *uc)
+{
+	if (!uc->feed_initialized) {
+		if (uc->feeding && uc->feed_size < uc->opts.file_format_lookahead) return 1;
+
+		ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_SETUP);
+		ufbxi_check(ufbxi_init_load(uc));
+		ufbxi_check(ufbxi_determine_format(uc));
+		uc->feed_initialized = true;
+
+		if (uc->scene.metadata.file_format == UFBX_FILE_FORMAT_FBX) {
+			const char *header = ufbxi_peek_bytes(uc, UFBXI_BINARY_HEADER_SIZE);
+			ufbxi_check(header);
+			if (!memcmp(header, ufbxi_binary_magic, UFBXI_BINARY_MAGIC_SIZE)) {
+				ufbxi_check(ufbxi_begin_parse(uc));
+				uc->feed_parse_begun = true;
+			}
+		}
+	}
+
+	if (uc->feed_parse_begun && uc->version >= 6000) {
+		ufbx_load_phase prev_phase = ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_PARSE);
+		ufbxi_check(ufbxi_feed_parse(uc));
+		ufbxi_leave_phase(uc, prev_phase);
+	}
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_loader_feed(ufbx_loader *loader, const void *data, size_t size)
+{
+	ufbxi_context *uc = &loader->uc;
+	ufbxi_check(size <= SIZE_MAX - sizeof(ufbxi_feed_chunk));
+
+	ufbxi_feed_chunk *chunk = (ufbxi_feed_chunk*)ufbxi_alloc(&uc->ator_tmp, char, sizeof(ufbxi_feed_chunk) + size);
+	ufbxi_check(chunk);
+	chunk->next = NULL;
+	chunk->size = size;
+	chunk->offset = 0;
+	memcpy(chunk + 1, data, size);
+
+	if (loader->chunks_tail) {
+		loader->chunks_tail->next = chunk;
+	} else {
+		loader->chunks = chunk;
+	}
+	loader->chunks_tail = chunk;
+	uc->feed_size += size;
+
+	ufbxi_check(ufbxi_feed_imp(uc));
+
+	// Time until the next call is spent waiting for data
+	ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_IO);
+
+	return 1;
+}
+
+static ufbxi_noinline void ufbxi_free_loader(ufbx_loader *loader)
+{
+	ufbxi_allocator ator = loader->ator;
+	loader->magic = 0;
+	ufbxi_free(&ator, ufbx_loader, loader, 1);
+	ufbxi_free_ator(&ator);
+}
+
+// -- Scene snapshots
+//
+// Snapshots contain the used memory of the scene result buffers as a single
+// contiguous image with every pointer replaced by a tagged offset:
+//
+//   ufbxi_snapshot_header header;
+//   char image[header.image_size];        // < Result memory with encoded pointers
+//   uint64_t bitmap[header.bitmap_words]; // < One bit per pointer-sized word of `image`
+//
+// Pointers are found by walking the public scene structures instead of
+// scanning the memory, so adding a new pointer field to any struct reachable
+// from `ufbx_scene` requires updating `ufbxi_snapshot_element()` and friends.
+// The walker also records the extent of everything it reaches, the rest of the
+// image (allocator state, dead allocations) is written as zeros so snapshots of
+// the same scene are identical and contain no heap addresses.
+
+#define UFBXI_SNAPSHOT_FORMAT_VERSION 1u
+#define UFBXI_SNAPSHOT_ENDIAN_CHECK 0x01020304u
+#define UFBXI_SNAPSHOT_RANGE_ALIGN 16u
+#define UFBXI_SNAPSHOT_BLOCK_SIZE 0x10000u
+
+static const char ufbxi_snapshot_magic[8] = { 'U', 'F', 'B', 'X', 'S', 'N', 'A', 'P' };
+
+// Encoded pointers are `payload << 2 | tag`
+typedef enum {
+	UFBXI_SNAPSHOT_PTR_NULL,   // < `NULL`, the whole encoded word is zero
+	UFBXI_SNAPSHOT_PTR_IMAGE,  // < Offset into the image
+	UFBXI_SNAPSHOT_PTR_ZERO,   // < Offset into `ufbxi_zero_size_buffer`
+	UFBXI_SNAPSHOT_PTR_STRING, // < Index of a static string, see `ufbxi_snapshot_static_string()`
+} ufbxi_snapshot_ptr;
+
+// Static strings that the string pool interns without copying
+#define UFBXI_SNAPSHOT_NUM_STATIC_STRINGS (ufbxi_arraycount(ufbxi_strings) \
+	+ ufbxi_arraycount(ufbxi_prop_type_names) + ufbxi_arraycount(ufbxi_node_prop_names) + 1)
+
+static ufbxi_noinline const char *ufbxi_snapshot_static_string(size_t index)
+{
+	if (index < ufbxi_arraycount(ufbxi_strings)) return ufbxi_strings[index].data;
+	index -= ufbxi_arraycount(ufbxi_strings);
+	if (index < ufbxi_arraycount(ufbxi_prop_type_names)) return ufbxi_prop_type_names[index].name;
+	index -= ufbxi_arraycount(ufbxi_prop_type_names);
+	if (index < ufbxi_arraycount(ufbxi_node_prop_names)) return ufbxi_node_prop_names[index];
+	return ufbxi_empty_char;
+}
+
+typedef struct {
+	char magic[8];
+	uint32_t format_version;
+	uint32_t source_version;
+	uint32_t endian_check;
+	uint32_t pointer_size;
+	uint32_t real_size;
+	uint32_t scene_imp_size;
+	uint64_t opts_hash;
+	uint64_t image_size;
+	uint64_t scene_offset;
+	uint64_t bitmap_words;
+} ufbxi_snapshot_header;
+
+ufbx_static_assert(snapshot_header_size, sizeof(ufbxi_snapshot_header) == 64);
+
+typedef struct {
+	uintptr_t begin; // < Address of the first used byte
+	size_t size;     // < Number of used bytes
+	size_t offset;   // < Offset in the image
+} ufbxi_snapshot_range;
+
+typedef struct {
+	size_t offset; // < Offset in the image
+	size_t size;
+} ufbxi_snapshot_span;
+
+typedef struct {
+	uintptr_t ptr;
+	uint32_t index;
+} ufbxi_snapshot_string;
+
+typedef size_t ufbxi_snapshot_write_fn(void *user, const void *data, size_t size);
+
+typedef struct {
+	ufbx_error error;
+
+	// Sticky failure flag so the walker does not need to propagate errors
+	bool failed;
+
+	ufbxi_allocator ator_tmp;
+
+	const ufbxi_scene_imp *imp;
+
+	// Sorted by `begin`
+	ufbxi_snapshot_range *ranges;
+	size_t num_ranges;
+	size_t image_size;
+
+	uint64_t *bitmap;
+	size_t bitmap_words;
+
+	// Parts of the image reachable from the scene, sorted and merged by
+	// `ufbxi_snapshot_sort_spans()` before writing
+	ufbxi_snapshot_span *spans;
+	size_t num_spans;
+	size_t spans_cap;
+
+	// Static strings sorted by pointer
+	ufbxi_snapshot_string *strings;
+
+	ufbxi_snapshot_write_fn *write_fn;
+	void *write_user;
+	char *block;
+} ufbxi_save_snapshot_context;
+
+static bool ufbxi_snapshot_range_less(void *user, const void *va, const void *vb)
+{
+	(void)user;
+	const ufbxi_snapshot_range *a = (const ufbxi_snapshot_range*)va, *b = (const ufbxi_snapshot_range*)vb;
+	return a->begin < b->begin;
+}
+
+static bool ufbxi_snapshot_span_less(void *user, const void *va, const void *vb)
+{
+	(void)user;
+	const ufbxi_snapshot_span *a = (const ufbxi_snapshot_span*)va, *b = (const ufbxi_snapshot_span*)vb;
+	return a->offset < b->offset;
+}
+
+static bool ufbxi_snapshot_string_less(void *user, const void *va, const void *vb)
+{
+	(void)user;
+	const ufbxi_snapshot_string *a = (const ufbxi_snapshot_string*)va, *b = (const ufbxi_snapshot_string*)vb;
+	return a->ptr < b->ptr;
+}
+
+static ufbxi_forceinline const ufbxi_snapshot_range *ufbxi_snapshot_find_range(const ufbxi_save_snapshot_context *sc, uintptr_t ptr)
+{
+	// Find the last range starting at or before `ptr`, the end is inclusive
+	// as pointers one past the end of an array are valid.
+	size_t lo = 0, hi = sc->num_ranges;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (sc->ranges[mid].begin <= ptr) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	if (lo == 0) return NULL;
+	const ufbxi_snapshot_range *range = &sc->ranges[lo - 1];
+	return ptr - range->begin <= range->size ? range : NULL;
+}
+
+static ufbxi_noinline bool ufbxi_snapshot_encode(const ufbxi_save_snapshot_context *sc, uintptr_t ptr, uintptr_t *p_encoded)
+{
+	if (ptr == 0) {
+		*p_encoded = 0;
+		return true;
+	}
+
+	const ufbxi_snapshot_range *range = ufbxi_snapshot_find_range(sc, ptr);
+	if (range) {
+		*p_encoded = (uintptr_t)(range->offset + (ptr - range->begin)) << 2u | UFBXI_SNAPSHOT_PTR_IMAGE;
+		return true;
+	}
+
+	uintptr_t zero = (uintptr_t)ufbxi_zero_size_buffer;
+	if (ptr - zero <= sizeof(ufbxi_zero_size_buffer)) {
+		*p_encoded = (ptr - zero) << 2u | UFBXI_SNAPSHOT_PTR_ZERO;
+		return true;
+	}
+
+	size_t index = SIZE_MAX;
+	ufbxi_macro_lower_bound_eq(ufbxi_snapshot_string, 16, &index, sc->strings, 0, UFBXI_SNAPSHOT_NUM_STATIC_STRINGS,
+		( a->ptr < ptr ), ( a->ptr == ptr ));
+	if (index != SIZE_MAX) {
+		*p_encoded = (uintptr_t)sc->strings[index].index << 2u | UFBXI_SNAPSHOT_PTR_STRING;
+		return true;
+	}
+
+	return false;
+}
+
+// Mark the pointer stored at `p_ptr` for relocation.
+// Returns `true` only the first time a pointer is marked, can be used to skip
+// walking shared structures multiple times.
+static ufbxi_noinline bool ufbxi_snapshot_mark(ufbxi_save_snapshot_context *sc, const void *p_ptr)
+{
+	if (sc->failed) return false;
+
+	uintptr_t addr = (uintptr_t)p_ptr, value = 0, encoded = 0;
+	const ufbxi_snapshot_range *range = ufbxi_snapshot_find_range(sc, addr);
+	memcpy(&value, p_ptr, sizeof(uintptr_t));
+
+	bool ok = range && range->size - (addr - range->begin) >= sizeof(uintptr_t);
+	if (ok) ok = ufbxi_snapshot_encode(sc, value, &encoded);
+	if (!ok) {
+		sc->failed = true;
+		ufbxi_report_err_msg(&sc->error, "ufbxi_snapshot_encode()", "Scene not self-contained");
+		return false;
+	}
+
+	size_t word = (range->offset + (addr - range->begin)) / sizeof(uintptr_t);
+	uint64_t bit = (uint64_t)1u << (word % 64);
+	if (sc->bitmap[word / 64] & bit) return false;
+	sc->bitmap[word / 64] |= bit;
+	return true;
+}
+
+// Record `size` bytes at `data` as reachable from the scene. Memory outside the
+// image (static strings, `ufbxi_zero_size_buffer`) is not written at all.
+static ufbxi_noinline void ufbxi_snapshot_live(ufbxi_save_snapshot_context *sc, const void *data, size_t size)
+{
+	if (sc->failed || size == 0) return;
+
+	const ufbxi_snapshot_range *range = ufbxi_snapshot_find_range(sc, (uintptr_t)data);
+	if (!range) return;
+	size_t begin = (uintptr_t)data - range->begin;
+	size = ufbxi_min_sz(size, range->size - begin);
+	if (size == 0) return;
+
+	// Consecutive list items and struct fields are often adjacent
+	size_t offset = range->offset + begin;
+	if (sc->num_spans > 0) {
+		ufbxi_snapshot_span *prev = &sc->spans[sc->num_spans - 1];
+		if (prev->offset + prev->size == offset) {
+			prev->size += size;
+			return;
+		}
+	}
+
+	if (!ufbxi_grow_array(&sc->ator_tmp, &sc->spans, &sc->spans_cap, sc->num_spans + 1)) {
+		sc->failed = true;
+		return;
+	}
+	ufbxi_snapshot_span *span = &sc->spans[sc->num_spans++];
+	span->offset = offset;
+	span->size = size;
+}
+
+// Mark the pointer stored at `p_ptr` and record the `size` bytes it points to
+static ufbxi_noinline bool ufbxi_snapshot_data(ufbxi_save_snapshot_context *sc, const void *p_ptr, size_t size)
+{
+	if (!ufbxi_snapshot_mark(sc, p_ptr)) return false;
+	const void *data; // ufbxi_uninit
+	memcpy(&data, p_ptr, sizeof(void*));
+	ufbxi_snapshot_live(sc, data, size);
+	return true;
+}
+
+#define ufbxi_snapshot_list(sc, list) ufbxi_snapshot_data((sc), &(list)->data, (list)->count * sizeof(*(list)->data))
+
+static ufbxi_noinline bool ufbxi_snapshot_str(ufbxi_save_snapshot_context *sc, const ufbx_string *str)
+{
+	// Include the NULL terminator
+	return ufbxi_snapshot_data(sc, &str->data, str->length + 1);
+}
+
+static ufbxi_noinline void ufbxi_snapshot_blob(ufbxi_save_snapshot_context *sc, const ufbx_blob *blob)
+{
+	ufbxi_snapshot_data(sc, &blob->data, blob->size);
+}
+
+static ufbxi_noinline void ufbxi_snapshot_ptr_list(ufbxi_save_snapshot_context *sc, const void *v_list)
+{
+	const ufbx_element_list *list = (const ufbx_element_list*)v_list;
+	ufbxi_snapshot_list(sc, list);
+	ufbxi_for_ptr_list(ufbx_element, p_elem, *list) {
+		ufbxi_snapshot_mark(sc, p_elem);
+	}
+}
+
+static ufbxi_noinline void ufbxi_snapshot_attrib(ufbxi_save_snapshot_context *sc, const void *v_attrib)
+{
+	const ufbx_vertex_attrib *attrib = (const ufbx_vertex_attrib*)v_attrib;
+	ufbxi_snapshot_data(sc, &attrib->values.data, attrib->values.count * attrib->value_reals * sizeof(ufbx_real));
+	ufbxi_snapshot_list(sc, &attrib->indices);
+	ufbxi_snapshot_list(sc, &attrib->values_w);
+	ufbxi_snapshot_list(sc, &attrib->values_float);
+}
+
+static ufbxi_noinline void ufbxi_snapshot_props(ufbxi_save_snapshot_context *sc, const ufbx_props *props)
+{
+	// Defaults are shared between elements
+	if (!ufbxi_snapshot_list(sc, &props->props)) return;
+	ufbxi_for_list(ufbx_prop, prop, props->props) {
+		ufbxi_snapshot_str(sc, &prop->name);
+		ufbxi_snapshot_str(sc, &prop->value_str);
+		ufbxi_snapshot_blob(sc, &prop->value_blob);
+	}
+	ufbxi_snapshot_data(sc, &props->defaults, sizeof(ufbx_props));
+	if (props->defaults) {
+		ufbxi_snapshot_props(sc, props->defaults);
+	}
+}
+
+static ufbxi_noinline void ufbxi_snapshot_dom_node(ufbxi_save_snapshot_context *sc, const ufbx_dom_node *node)
+{
+	if (!ufbxi_snapshot_str(sc, &node->name)) return;
+	ufbxi_snapshot_list(sc, &node->children);
+	ufbxi_for_ptr_list(ufbx_dom_node, p_child, node->children) {
+		ufbxi_snapshot_data(sc, p_child, sizeof(ufbx_dom_node));
+		ufbxi_snapshot_dom_node(sc, *p_child);
+	}
+	ufbxi_snapshot_list(sc, &node->values);
+	ufbxi_for_list(ufbx_dom_value, value, node->values) {
+		ufbxi_snapshot_str(sc, &value->value_str);
+		ufbxi_snapshot_blob(sc, &value->value_blob);
+	}
+}
+
+static ufbxi_noinline void ufbxi_snapshot_anim(ufbxi_save_snapshot_context *sc, const ufbx_anim *anim)
+{
+	// Referred to by the scene, stacks and layers
+	if (!ufbxi_snapshot_list(sc, &anim->layers)) return;
+	ufbxi_snapshot_live(sc, anim, sizeof(ufbx_anim));
+	ufbxi_for_ptr_list(ufbx_anim_layer, p_layer, anim->layers) {
+		ufbxi_snapshot_mark(sc, p_layer);
+	}
+	ufbxi_snapshot_list(sc, &anim->override_layer_weights);
+	ufbxi_snapshot_list(sc, &anim->prop_overrides);
+	ufbxi_for_list(ufbx_prop_override, over, anim->prop_overrides) {
+		ufbxi_snapshot_str(sc, &over->prop_name);
+		ufbxi_snapshot_str(sc, &over->value_str);
+	}
+	ufbxi_snapshot_list(sc, &anim->transform_overrides);
+}
+
+static ufbxi_noinline void ufbxi_snapshot_file_strings(ufbxi_save_snapshot_context *sc, const ufbx_string *filename, const ufbx_blob *raw_filename)
+{
+	// `filename`, `absolute_filename`, `relative_filename` and the matching raw blobs
+	for (size_t i = 0; i < 3; i++) {
+		ufbxi_snapshot_str(sc, &filename[i]);
+		ufbxi_snapshot_blob(sc, &raw_filename[i]);
+	}
+}
+
+static ufbxi_noinline void ufbxi_snapshot_shader_texture(ufbxi_save_snapshot_context *sc, const ufbx_shader_texture *shader)
+{
+	if (!ufbxi_snapshot_str(sc, &shader->shader_name)) return;
+	ufbxi_snapshot_list(sc, &shader->inputs);
+	ufbxi_for_list(ufbx_shader_texture_input, input, shader->inputs) {
+		ufbxi_snapshot_str(sc, &input->name);
+		ufbxi_snapshot_str(sc, &input->value_str);
+		ufbxi_snapshot_blob(sc, &input->value_blob);
+		ufbxi_snapshot_mark(sc, &input->texture);
+		ufbxi_snapshot_mark(sc, &input->prop);
+		ufbxi_snapshot_mark(sc, &input->texture_prop);
+		ufbxi_snapshot_mark(sc, &input->texture_enabled_prop);
+	}
+	ufbxi_snapshot_str(sc, &shader->shader_source);
+	ufbxi_snapshot_blob(sc, &shader->raw_shader_source);
+	ufbxi_snapshot_mark(sc, &shader->main_texture);
+	ufbxi_snapshot_str(sc, &shader->prop_prefix);
+}
+
+static ufbxi_noinline void ufbxi_snapshot_element(ufbxi_save_snapshot_context *sc, const ufbx_element *element)
+{
+	ufbxi_snapshot_live(sc, element, ufbx_element_type_size[element->type]);
+	ufbxi_snapshot_str(sc, &element->name);
+	ufbxi_snapshot_props(sc, &element->props);
+	ufbxi_snapshot_ptr_list(sc, &element->instances);
+	ufbxi_snapshot_list(sc, &element->connections_src);
+	ufbxi_snapshot_list(sc, &element->connections_dst);
+	ufbxi_snapshot_mark(sc, &element->dom_node);
+	if (element->dom_node) {
+		ufbxi_snapshot_dom_node(sc, element->dom_node);
+	}
+	ufbxi_snapshot_mark(sc, &element->scene);
+
+	switch (element->type) {
+
+	case UFBX_ELEMENT_UNKNOWN: {
+		const ufbx_unknown *unknown = (const ufbx_unknown*)element;
+		ufbxi_snapshot_str(sc, &unknown->type);
+		ufbxi_snapshot_str(sc, &unknown->super_type);
+		ufbxi_snapshot_str(sc, &unknown->sub_type);
+	} break;
+
+	case UFBX_ELEMENT_NODE: {
+		const ufbx_node *node = (const ufbx_node*)element;
+		ufbxi_snapshot_mark(sc, &node->parent);
+		ufbxi_snapshot_ptr_list(sc, &node->children);
+		ufbxi_snapshot_mark(sc, &node->mesh);
+		ufbxi_snapshot_mark(sc, &node->light);
+		ufbxi_snapshot_mark(sc, &node->camera);
+		ufbxi_snapshot_mark(sc, &node->bone);
+		ufbxi_snapshot_mark(sc, &node->attrib);
+		ufbxi_snapshot_mark(sc, &node->geometry_transform_helper);
+		ufbxi_snapshot_mark(sc, &node->scale_helper);
+		ufbxi_snapshot_ptr_list(sc, &node->all_attribs);
+		ufbxi_snapshot_mark(sc, &node->inherit_scale_node);
+		ufbxi_snapshot_ptr_list(sc, &node->materials);
+		ufbxi_snapshot_mark(sc, &node->bind_pose);
+	} break;
+
+	case UFBX_ELEMENT_MESH: {
+		const ufbx_mesh *mesh = (const ufbx_mesh*)element;
+		ufbxi_snapshot_list(sc, &mesh->faces);
+		ufbxi_snapshot_list(sc, &mesh->face_smoothing);
+		ufbxi_snapshot_list(sc, &mesh->face_material);
+		ufbxi_snapshot_list(sc, &mesh->face_group);
+		ufbxi_snapshot_list(sc, &mesh->face_hole);
+		ufbxi_snapshot_list(sc, &mesh->edges);
+		ufbxi_snapshot_list(sc, &mesh->edge_smoothing);
+		ufbxi_snapshot_list(sc, &mesh->edge_crease);
+		ufbxi_snapshot_list(sc, &mesh->edge_visibility);
+		ufbxi_snapshot_list(sc, &mesh->vertex_indices);
+		ufbxi_snapshot_list(sc, &mesh->vertices);
+		ufbxi_snapshot_list(sc, &mesh->vertex_first_index);
+		ufbxi_snapshot_attrib(sc, &mesh->vertex_position);
+		ufbxi_snapshot_attrib(sc, &mesh->vertex_normal);
+		ufbxi_snapshot_attrib(sc, &mesh->vertex_uv);
+		ufbxi_snapshot_attrib(sc, &mesh->vertex_tangent);
+		ufbxi_snapshot_attrib(sc, &mesh->vertex_bitangent);
+		ufbxi_snapshot_attrib(sc, &mesh->vertex_color);
+		ufbxi_snapshot_attrib(sc, &mesh->vertex_crease);
+		ufbxi_snapshot_list(sc, &mesh->uv_sets);
+		ufbxi_for_list(ufbx_uv_set, set, mesh->uv_sets) {
+			ufbxi_snapshot_str(sc, &set->name);
+			ufbxi_snapshot_attrib(sc, &set->vertex_uv);
+			ufbxi_snapshot_attrib(sc, &set->vertex_tangent);
+			ufbxi_snapshot_attrib(sc, &set->vertex_bitangent);
+		}
+		ufbxi_snapshot_list(sc, &mesh->color_sets);
+		ufbxi_for_list(ufbx_color_set, set, mesh->color_sets) {
+			ufbxi_snapshot_str(sc, &set->name);
+			ufbxi_snapshot_attrib(sc, &set->vertex_color);
+		}
+		ufbxi_snapshot_ptr_list(sc, &mesh->materials);
+		ufbxi_snapshot_list(sc, &mesh->face_groups);
+		ufbxi_for_list(ufbx_face_group, group, mesh->face_groups) {
+			ufbxi_snapshot_str(sc, &group->name);
+		}
+		ufbxi_snapshot_list(sc, &mesh->material_parts);
+		ufbxi_for_list(ufbx_mesh_part, part, mesh->material_parts) {
+			ufbxi_snapshot_list(sc, &part->face_indices);
+		}
+		ufbxi_snapshot_list(sc, &mesh->face_group_parts);
+		ufbxi_for_list(ufbx_mesh_part, part, mesh->face_group_parts) {
+			ufbxi_snapshot_list(sc, &part->face_indices);
+		}
+		ufbxi_snapshot_list(sc, &mesh->material_part_usage_order);
+		ufbxi_snapshot_attrib(sc, &mesh->skinned_position);
+		ufbxi_snapshot_attrib(sc, &mesh->skinned_normal);
+		ufbxi_snapshot_ptr_list(sc, &mesh->skin_deformers);
+		ufbxi_snapshot_ptr_list(sc, &mesh->blend_deformers);
+		ufbxi_snapshot_ptr_list(sc, &mesh->cache_deformers);
+		ufbxi_snapshot_ptr_list(sc, &mesh->all_deformers);
+		ufbxi_snapshot_data(sc, &mesh->subdivision_result, sizeof(ufbx_subdivision_result));
+		if (mesh->subdivision_result) {
+			const ufbx_subdivision_result *result = mesh->subdivision_result;
+			ufbxi_snapshot_list(sc, &result->source_vertex_ranges);
+			ufbxi_snapshot_list(sc, &result->source_vertex_weights);
+			ufbxi_snapshot_list(sc, &result->skin_cluster_ranges);
+			ufbxi_snapshot_list(sc, &result->skin_cluster_weights);
+		}
+	} break;
+
+	case UFBX_ELEMENT_LINE_CURVE: {
+		const ufbx_line_curve *line = (const ufbx_line_curve*)element;
+		ufbxi_snapshot_list(sc, &line->control_points);
+		ufbxi_snapshot_list(sc, &line->point_indices);
+		ufbxi_snapshot_list(sc, &line->segments);
+	} break;
+
+	case UFBX_ELEMENT_NURBS_CURVE: {
+		const ufbx_nurbs_curve *curve = (const ufbx_nurbs_curve*)element;
+		ufbxi_snapshot_list(sc, &curve->basis.knot_vector);
+		ufbxi_snapshot_list(sc, &curve->basis.spans);
+		ufbxi_snapshot_list(sc, &curve->control_points);
+	} break;
+
+	case UFBX_ELEMENT_NURBS_SURFACE: {
+		const ufbx_nurbs_surface *surface = (const ufbx_nurbs_surface*)element;
+		ufbxi_snapshot_list(sc, &surface->basis_u.knot_vector);
+		ufbxi_snapshot_list(sc, &surface->basis_u.spans);
+		ufbxi_snapshot_list(sc, &surface->basis_v.knot_vector);
+		ufbxi_snapshot_list(sc, &surface->basis_v.spans);
+		ufbxi_snapshot_list(sc, &surface->control_points);
+		ufbxi_snapshot_mark(sc, &surface->material);
+	} break;
+
+	case UFBX_ELEMENT_STEREO_CAMERA: {
+		const ufbx_stereo_camera *stereo = (const ufbx_stereo_camera*)element;
+		ufbxi_snapshot_mark(sc, &stereo->left);
+		ufbxi_snapshot_mark(sc, &stereo->right);
+	} break;
+
+	case UFBX_ELEMENT_LOD_GROUP: {
+		const ufbx_lod_group *lod = (const ufbx_lod_group*)element;
+		ufbxi_snapshot_list(sc, &lod->lod_levels);
+	} break;
+
+	case UFBX_ELEMENT_SKIN_DEFORMER: {
+		const ufbx_skin_deformer *skin = (const ufbx_skin_deformer*)element;
+		ufbxi_snapshot_ptr_list(sc, &skin->clusters);
+		ufbxi_snapshot_list(sc, &skin->vertices);
+		ufbxi_snapshot_list(sc, &skin->weights);
+		ufbxi_snapshot_list(sc, &skin->dq_vertices);
+		ufbxi_snapshot_list(sc, &skin->dq_weights);
+	} break;
+
+	case UFBX_ELEMENT_SKIN_CLUSTER: {
+		const ufbx_skin_cluster *cluster = (const ufbx_skin_cluster*)element;
+		ufbxi_snapshot_mark(sc, &cluster->bone_node);
+		ufbxi_snapshot_list(sc, &cluster->vertices);
+		ufbxi_snapshot_list(sc, &cluster->weights);
+	} break;
+
+	case UFBX_ELEMENT_BLEND_DEFORMER: {
+		const ufbx_blend_deformer *blend = (const ufbx_blend_deformer*)element;
+		ufbxi_snapshot_ptr_list(sc, &blend->channels);
+	} break;
+
+	case UFBX_ELEMENT_BLEND_CHANNEL: {
+		const ufbx_blend_channel *channel = (const ufbx_blend_channel*)element;
+		ufbxi_snapshot_list(sc, &channel->keyframes);
+		ufbxi_for_list(ufbx_blend_keyframe, key, channel->keyframes) {
+			ufbxi_snapshot_mark(sc, &key->shape);
+		}
+		ufbxi_snapshot_mark(sc, &channel->target_shape);
+	} break;
+
+	case UFBX_ELEMENT_BLEND_SHAPE: {
+		const ufbx_blend_shape *shape = (const ufbx_blend_shape*)element;
+		ufbxi_snapshot_list(sc, &shape->offset_vertices);
+		ufbxi_snapshot_list(sc, &shape->position_offsets);
+		ufbxi_snapshot_list(sc, &shape->normal_offsets);
+		ufbxi_snapshot_list(sc, &shape->position_offsets_float);
+		ufbxi_snapshot_list(sc, &shape->normal_offsets_float);
+		ufbxi_snapshot_list(sc, &shape->offset_weights);
+	} break;
+
+	case UFBX_ELEMENT_CACHE_DEFORMER: {
+		const ufbx_cache_deformer *deformer = (const ufbx_cache_deformer*)element;
+		ufbxi_snapshot_str(sc, &deformer->channel);
+		ufbxi_snapshot_mark(sc, &deformer->file);
+		// Loaded external caches are separate allocations and fail here
+		ufbxi_snapshot_mark(sc, &deformer->external_cache);
+		ufbxi_snapshot_mark(sc, &deformer->external_channel);
+	} break;
+
+	case UFBX_ELEMENT_CACHE_FILE: {
+		const ufbx_cache_file *file = (const ufbx_cache_file*)element;
+		ufbxi_snapshot_file_strings(sc, &file->filename, &file->raw_filename);
+		ufbxi_snapshot_mark(sc, &file->external_cache);
+	} break;
+
+	case UFBX_ELEMENT_MATERIAL: {
+		const ufbx_material *material = (const ufbx_material*)element;
+		for (size_t i = 0; i < UFBX_MATERIAL_FBX_MAP_COUNT; i++) {
+			ufbxi_snapshot_mark(sc, &material->fbx.maps[i].texture);
+		}
+		for (size_t i = 0; i < UFBX_MATERIAL_PBR_MAP_COUNT; i++) {
+			ufbxi_snapshot_mark(sc, &material->pbr.maps[i].texture);
+		}
+		ufbxi_snapshot_mark(sc, &material->shader);
+		ufbxi_snapshot_str(sc, &material->shading_model_name);
+		ufbxi_snapshot_str(sc, &material->shader_prop_prefix);
+		ufbxi_snapshot_list(sc, &material->textures);
+		ufbxi_for_list(ufbx_material_texture, tex, material->textures) {
+			ufbxi_snapshot_str(sc, &tex->material_prop);
+			ufbxi_snapshot_str(sc, &tex->shader_prop);
+			ufbxi_snapshot_mark(sc, &tex->texture);
+		}
+	} break;
+
+	case UFBX_ELEMENT_TEXTURE: {
+		const ufbx_texture *texture = (const ufbx_texture*)element;
+		ufbxi_snapshot_file_strings(sc, &texture->filename, &texture->raw_filename);
+		ufbxi_snapshot_blob(sc, &texture->content);
+		ufbxi_snapshot_mark(sc, &texture->video);
+		ufbxi_snapshot_list(sc, &texture->layers);
+		ufbxi_for_list(ufbx_texture_layer, layer, texture->layers) {
+			ufbxi_snapshot_mark(sc, &layer->texture);
+		}
+		ufbxi_snapshot_data(sc, &texture->shader, sizeof(ufbx_shader_texture));
+		if (texture->shader) {
+			ufbxi_snapshot_shader_texture(sc, texture->shader);
+		}
+		ufbxi_snapshot_ptr_list(sc, &texture->file_textures);
+		ufbxi_snapshot_str(sc, &texture->uv_set);
+	} break;
+
+	case UFBX_ELEMENT_VIDEO: {
+		const ufbx_video *video = (const ufbx_video*)element;
+		ufbxi_snapshot_file_strings(sc, &video->filename, &video->raw_filename);
+		ufbxi_snapshot_blob(sc, &video->content);
+	} break;
+
+	case UFBX_ELEMENT_SHADER: {
+		const ufbx_shader *shader = (const ufbx_shader*)element;
+		ufbxi_snapshot_ptr_list(sc, &shader->bindings);
+	} break;
+
+	case UFBX_ELEMENT_SHADER_BINDING: {
+		const ufbx_shader_binding *binding = (const ufbx_shader_binding*)element;
+		ufbxi_snapshot_list(sc, &binding->prop_bindings);
+		ufbxi_for_list(ufbx_shader_prop_binding, prop, binding->prop_bindings) {
+			ufbxi_snapshot_str(sc, &prop->shader_prop);
+			ufbxi_snapshot_str(sc, &prop->material_prop);
+		}
+	} break;
+
+	case UFBX_ELEMENT_ANIM_STACK: {
+		const ufbx_anim_stack *stack = (const ufbx_anim_stack*)element;
+		ufbxi_snapshot_ptr_list(sc, &stack->layers);
+		ufbxi_snapshot_mark(sc, &stack->anim);
+		if (stack->anim) {
+			ufbxi_snapshot_anim(sc, stack->anim);
+		}
+	} break;
+
+	case UFBX_ELEMENT_ANIM_LAYER: {
+		const ufbx_anim_layer *layer = (const ufbx_anim_layer*)element;
+		ufbxi_snapshot_ptr_list(sc, &layer->anim_values);
+		ufbxi_snapshot_list(sc, &layer->anim_props);
+		ufbxi_for_list(ufbx_anim_prop, prop, layer->anim_props) {
+			ufbxi_snapshot_mark(sc, &prop->element);
+			ufbxi_snapshot_str(sc, &prop->prop_name);
+			ufbxi_snapshot_mark(sc, &prop->anim_value);
+		}
+		ufbxi_snapshot_mark(sc, &layer->anim);
+		if (layer->anim) {
+			ufbxi_snapshot_anim(sc, layer->anim);
+		}
+	} break;
+
+	case UFBX_ELEMENT_ANIM_VALUE: {
+		const ufbx_anim_value *value = (const ufbx_anim_value*)element;
+		for (size_t i = 0; i < 3; i++) {
+			ufbxi_snapshot_mark(sc, &value->curves[i]);
+		}
+	} break;
+
+	case UFBX_ELEMENT_ANIM_CURVE: {
+		const ufbx_anim_curve *curve = (const ufbx_anim_curve*)element;
+		ufbxi_snapshot_list(sc, &curve->keyframes);
+	} break;
+
+	case UFBX_ELEMENT_DISPLAY_LAYER: {
+		const ufbx_display_layer *layer = (const ufbx_display_layer*)element;
+		ufbxi_snapshot_ptr_list(sc, &layer->nodes);
+	} break;
+
+	case UFBX_ELEMENT_SELECTION_SET: {
+		const ufbx_selection_set *set = (const ufbx_selection_set*)element;
+		ufbxi_snapshot_ptr_list(sc, &set->nodes);
+	} break;
+
+	case UFBX_ELEMENT_SELECTION_NODE: {
+		const ufbx_selection_node *node = (const ufbx_selection_node*)element;
+		ufbxi_snapshot_mark(sc, &node->target_node);
+		ufbxi_snapshot_mark(sc, &node->target_mesh);
+		ufbxi_snapshot_list(sc, &node->vertices);
+		ufbxi_snapshot_list(sc, &node->edges);
+		ufbxi_snapshot_list(sc, &node->faces);
+	} break;
+
+	case UFBX_ELEMENT_CONSTRAINT: {
+		const ufbx_constraint *constraint = (const ufbx_constraint*)element;
+		ufbxi_snapshot_str(sc, &constraint->type_name);
+		ufbxi_snapshot_mark(sc, &constraint->node);
+		ufbxi_snapshot_list(sc, &constraint->targets);
+		ufbxi_for_list(ufbx_constraint_target, target, constraint->targets) {
+			ufbxi_snapshot_mark(sc, &target->node);
+		}
+		ufbxi_snapshot_mark(sc, &constraint->aim_up_node);
+		ufbxi_snapshot_mark(sc, &constraint->ik_effector);
+		ufbxi_snapshot_mark(sc, &constraint->ik_end_node);
+	} break;
+
+	case UFBX_ELEMENT_AUDIO_LAYER: {
+		const ufbx_audio_layer *layer = (const ufbx_audio_layer*)element;
+		ufbxi_snapshot_ptr_list(sc, &layer->clips);
+	} break;
+
+	case UFBX_ELEMENT_AUDIO_CLIP: {
+		const ufbx_audio_clip *clip = (const ufbx_audio_clip*)element;
+		ufbxi_snapshot_file_strings(sc, &clip->filename, &clip->raw_filename);
+		ufbxi_snapshot_blob(sc, &clip->content);
+	} break;
+
+	case UFBX_ELEMENT_POSE: {
+		const ufbx_pose *pose = (const ufbx_pose*)element;
+		ufbxi_snapshot_list(sc, &pose->bone_poses);
+		ufbxi_for_list(ufbx_bone_pose, bone, pose->bone_poses) {
+			ufbxi_snapshot_mark(sc, &bone->bone_node);
+		}
+	} break;
+
+	default:
+		// No pointers besides `ufbx_element`
+		break;
+
+	}
+}
+
+static ufbxi_noinline void ufbxi_snapshot_scene(ufbxi_save_snapshot_context *sc, const ufbx_scene *scene)
+{
+	const ufbx_metadata *metadata = &scene->metadata;
+	ufbxi_snapshot_list(sc, &metadata->warnings);
+	ufbxi_for_list(ufbx_warning, warning, metadata->warnings) {
+		ufbxi_snapshot_str(sc, &warning->description);
+	}
+	ufbxi_snapshot_str(sc, &metadata->creator);
+	ufbxi_snapshot_str(sc, &metadata->filename);
+	ufbxi_snapshot_str(sc, &metadata->relative_root);
+	ufbxi_snapshot_blob(sc, &metadata->raw_filename);
+	ufbxi_snapshot_blob(sc, &metadata->raw_relative_root);
+	ufbxi_snapshot_props(sc, &metadata->scene_props);
+	const ufbx_application *apps[] = { &metadata->original_application, &metadata->latest_application };
+	for (size_t i = 0; i < ufbxi_arraycount(apps); i++) {
+		ufbxi_snapshot_str(sc, &apps[i]->vendor);
+		ufbxi_snapshot_str(sc, &apps[i]->name);
+		ufbxi_snapshot_str(sc, &apps[i]->version);
+	}
+	ufbxi_snapshot_props(sc, &metadata->thumbnail.props);
+	ufbxi_snapshot_blob(sc, &metadata->thumbnail.data);
+	ufbxi_snapshot_str(sc, &metadata->original_file_path);
+	ufbxi_snapshot_blob(sc, &metadata->raw_original_file_path);
+
+	ufbxi_snapshot_props(sc, &scene->settings.props);
+	ufbxi_snapshot_str(sc, &scene->settings.default_camera);
+
+	ufbxi_snapshot_mark(sc, &scene->root_node);
+	ufbxi_snapshot_mark(sc, &scene->anim);
+	if (scene->anim) {
+		ufbxi_snapshot_anim(sc, scene->anim);
+	}
+
+	for (size_t i = 0; i < UFBX_ELEMENT_TYPE_COUNT; i++) {
+		ufbxi_snapshot_ptr_list(sc, &scene->elements_by_type[i]);
+	}
+
+	ufbxi_snapshot_list(sc, &scene->texture_files);
+	ufbxi_for_list(ufbx_texture_file, file, scene->texture_files) {
+		ufbxi_snapshot_file_strings(sc, &file->filename, &file->raw_filename);
+		ufbxi_snapshot_blob(sc, &file->content);
+	}
+
+	ufbxi_snapshot_ptr_list(sc, &scene->elements);
+	ufbxi_for_ptr_list(ufbx_element, p_elem, scene->elements) {
+		ufbxi_snapshot_element(sc, *p_elem);
+	}
+
+	const ufbx_connection_list *conn_lists[] = { &scene->connections_src, &scene->connections_dst };
+	for (size_t i = 0; i < ufbxi_arraycount(conn_lists); i++) {
+		ufbxi_snapshot_list(sc, conn_lists[i]);
+		ufbxi_for_list(ufbx_connection, conn, *conn_lists[i]) {
+			ufbxi_snapshot_mark(sc, &conn->src);
+			ufbxi_snapshot_mark(sc, &conn->dst);
+			ufbxi_snapshot_str(sc, &conn->src_prop);
+			ufbxi_snapshot_str(sc, &conn->dst_prop);
+		}
+	}
+
+	ufbxi_snapshot_list(sc, &scene->elements_by_name);
+	ufbxi_for_list(ufbx_name_element, entry, scene->elements_by_name) {
+		ufbxi_snapshot_str(sc, &entry->name);
+		ufbxi_snapshot_mark(sc, &entry->element);
+	}
+
+	ufbxi_snapshot_data(sc, &scene->dom_root, sizeof(ufbx_dom_node));
+	if (scene->dom_root) {
+		ufbxi_snapshot_dom_node(sc, scene->dom_root);
+	}
+}
+
+static ufbxi_noinline void ufbxi_snapshot_add_chunks(ufbxi_save_snapshot_context *sc, const ufbxi_buf *buf, size_t *p_count)
+{
+	for (size_t list = 0; list < 2; list++) {
+		ufbxi_buf_chunk *chunk = buf->chunks[list];
+		if (!chunk) continue;
+		for (chunk = chunk->root; chunk; chunk = chunk->next) {
+			// The active normal chunk tracks its size in `ufbxi_buf.pos`
+			bool active = list == 0 && chunk == buf->chunks[0];
+			size_t size = active ? buf->pos : chunk->pushed_pos;
+			if (size > 0) {
+				if (sc->ranges) {
+					ufbxi_snapshot_range *range = &sc->ranges[*p_count];
+					range->begin = (uintptr_t)chunk->data;
+					range->size = size;
+					range->offset = 0;
+				}
+				++*p_count;
+			}
+			if (active) break;
+		}
+	}
+}
+
+// Gather the used memory of the scene into sorted `sc->ranges` and lay them out in the image
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_snapshot_layout(ufbxi_save_snapshot_context *sc)
+{
+	const ufbxi_scene_imp *imp = sc->imp;
+
+	// Deferred geometry would need the original file to be loaded
+	ufbxi_check_err_msg(&sc->error, !imp->scene.metadata.geometry_deferred, "Scene not self-contained");
+	ufbxi_check_err_msg(&sc->error, imp->refcount.parent == NULL, "Scene not self-contained");
+
+	size_t num_ranges = 0;
+	ufbxi_snapshot_add_chunks(sc, &imp->refcount.buf, &num_ranges);
+	ufbxi_snapshot_add_chunks(sc, &imp->string_buf, &num_ranges);
+
+	sc->ranges = ufbxi_alloc(&sc->ator_tmp, ufbxi_snapshot_range, num_ranges);
+	ufbxi_check_err(&sc->error, sc->ranges);
+
+	sc->num_ranges = 0;
+	ufbxi_snapshot_add_chunks(sc, &imp->refcount.buf, &sc->num_ranges);
+	ufbxi_snapshot_add_chunks(sc, &imp->string_buf, &sc->num_ranges);
+	ufbx_assert(sc->num_ranges == num_ranges);
+
+	ufbxi_unstable_sort(sc->ranges, sc->num_ranges, sizeof(ufbxi_snapshot_range), &ufbxi_snapshot_range_less, NULL);
+
+	size_t offset = 0;
+	ufbxi_for(ufbxi_snapshot_range, range, sc->ranges, sc->num_ranges) {
+		range->offset = offset;
+		ufbxi_check_err(&sc->error, range->size <= SIZE_MAX - offset - UFBXI_SNAPSHOT_RANGE_ALIGN);
+		offset = ufbxi_align_to_mask(offset + range->size, UFBXI_SNAPSHOT_RANGE_ALIGN - 1);
+	}
+
+	// Image offsets must fit in encoded pointers
+	ufbxi_check_err(&sc->error, offset <= UINTPTR_MAX >> 2u);
+	sc->image_size = offset;
+	sc->bitmap_words = (offset / sizeof(uintptr_t) + 63) / 64;
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_snapshot_write(ufbxi_save_snapshot_context *sc, const void *data, size_t size)
+{
+	ufbxi_check_err_msg(&sc->error, sc->write_fn(sc->write_user, data, size) == size, "IO error");
+	return 1;
+}
+
+// Sort the spans and merge overlapping ones, eg. sub-lists of `ufbx_scene.connections_src`
+static ufbxi_noinline void ufbxi_snapshot_sort_spans(ufbxi_save_snapshot_context *sc)
+{
+	if (sc->num_spans == 0) return;
+	ufbxi_unstable_sort(sc->spans, sc->num_spans, sizeof(ufbxi_snapshot_span), &ufbxi_snapshot_span_less, NULL);
+
+	size_t num_merged = 1;
+	for (size_t i = 1; i < sc->num_spans; i++) {
+		ufbxi_snapshot_span *prev = &sc->spans[num_merged - 1];
+		const ufbxi_snapshot_span *span = &sc->spans[i];
+		size_t prev_end = prev->offset + prev->size;
+		if (span->offset <= prev_end) {
+			prev->size = ufbxi_max_sz(prev_end, span->offset + span->size) - prev->offset;
+		} else {
+			sc->spans[num_merged++] = *span;
+		}
+	}
+	sc->num_spans = num_merged;
+}
+
+// Write the image in blocks, encoding the marked pointers on the fly. Only the
+// spans reachable from the scene are copied, the rest of the used chunk memory
+// contains allocator state and dead allocations that are written as zeros.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_snapshot_write_image(ufbxi_save_snapshot_context *sc)
+{
+	char *block = sc->block;
+	size_t pos = 0;
+	const ufbxi_snapshot_span *span = sc->spans, *span_end = sc->spans + sc->num_spans;
+
+	ufbxi_for(ufbxi_snapshot_range, range, sc->ranges, sc->num_ranges) {
+		if (pos < range->offset) {
+			size_t padding = range->offset - pos;
+			ufbx_assert(padding < UFBXI_SNAPSHOT_RANGE_ALIGN);
+			memset(block, 0, padding);
+			ufbxi_check_err(&sc->error, ufbxi_snapshot_write(sc, block, padding));
+		}
+
+		for (size_t begin = 0; begin < range->size; begin += UFBXI_SNAPSHOT_BLOCK_SIZE) {
+			size_t size = ufbxi_min_sz(range->size - begin, UFBXI_SNAPSHOT_BLOCK_SIZE);
+			size_t block_offset = range->offset + begin;
+			size_t block_end = block_offset + size;
+			const char *src = (const char*)range->begin + begin;
+
+			memset(block, 0, size);
+			while (span != span_end && span->offset + span->size <= block_offset) span++;
+			for (const ufbxi_snapshot_span *s = span; s != span_end && s->offset < block_end; s++) {
+				size_t copy_begin = ufbxi_max_sz(s->offset, block_offset) - block_offset;
+				size_t copy_end = ufbxi_min_sz(s->offset + s->size, block_end) - block_offset;
+				memcpy(block + copy_begin, src + copy_begin, copy_end - copy_begin);
+			}
+
+			// Words partially past the end of the range can never be marked
+			size_t word_begin = block_offset / sizeof(uintptr_t);
+			size_t word_end = (block_offset + size) / sizeof(uintptr_t);
+			for (size_t bitmap_ix = word_begin / 64; bitmap_ix * 64 < word_end; bitmap_ix++) {
+				uint64_t bits = sc->bitmap[bitmap_ix];
+				while (bits) {
+					uint64_t low_bit = bits & (~bits + 1u);
+					bits ^= low_bit;
+					size_t word = bitmap_ix * 64 + (63 - ufbxi_lzcnt64(low_bit));
+					if (word < word_begin || word >= word_end) continue;
+
+					size_t word_offset = word * sizeof(uintptr_t) - block_offset;
+					uintptr_t value, encoded; // ufbxi_uninit
+					memcpy(&value, src + word_offset, sizeof(uintptr_t));
+					ufbxi_check_err(&sc->error, ufbxi_snapshot_encode(sc, value, &encoded));
+					memcpy(block + word_offset, &encoded, sizeof(uintptr_t));
+				}
+			}
+
+			ufbxi_check_err(&sc->error, ufbxi_snapshot_write(sc, block, size));
+		}
+		pos = range->offset + range->size;
+	}
+
+	if (pos < sc->image_size) {
+		memset(block, 0, sc->image_size - pos);
+		ufbxi_check_err(&sc->error, ufbxi_snapshot_write(sc, block, sc->image_size - pos));
+	}
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_save_snapshot_imp(ufbxi_save_snapshot_context *sc)
+{
+	const ufbxi_scene_imp *imp = sc->imp;
+
+	// Static strings sorted by address for `ufbxi_snapshot_encode()`
+	size_t num_strings = UFBXI_SNAPSHOT_NUM_STATIC_STRINGS;
+	sc->strings = ufbxi_alloc(&sc->ator_tmp, ufbxi_snapshot_string, num_strings);
+	ufbxi_check_err(&sc->error, sc->strings);
+	for (size_t i = 0; i < num_strings; i++) {
+		sc->strings[i].ptr = (uintptr_t)ufbxi_snapshot_static_string(i);
+		sc->strings[i].index = (uint32_t)i;
+	}
+	ufbxi_unstable_sort(sc->strings, num_strings, sizeof(ufbxi_snapshot_string), &ufbxi_snapshot_string_less, NULL);
+
+	sc->bitmap = ufbxi_alloc(&sc->ator_tmp, uint64_t, sc->bitmap_words);
+	ufbxi_check_err(&sc->error, sc->bitmap);
+	memset(sc->bitmap, 0, sc->bitmap_words * sizeof(uint64_t));
+
+	// The rest of `ufbxi_scene_imp` is rebuilt by `ufbxi_load_snapshot_imp()`, as are the
+	// memory and load statistics in `ufbx_metadata` which are left zero so that saving
+	// a restored scene results in an identical snapshot.
+	const char *scene_begin = (const char*)&imp->scene;
+	const char *stats_begin = (const char*)&imp->scene.metadata.result_memory_used;
+	const char *stats_end = (const char*)(&imp->scene.metadata.loaded_from_cache + 1);
+	ufbxi_snapshot_live(sc, scene_begin, ufbxi_to_size(stats_begin - scene_begin));
+	ufbxi_snapshot_live(sc, stats_end, sizeof(ufbx_scene) - ufbxi_to_size(stats_end - scene_begin));
+	ufbxi_snapshot_live(sc, &imp->magic, sizeof(imp->magic));
+	ufbxi_snapshot_live(sc, &imp->opts_hash, sizeof(imp->opts_hash));
+	ufbxi_snapshot_scene(sc, &imp->scene);
+	if (sc->failed) return 0;
+	ufbxi_snapshot_sort_spans(sc);
+
+	ufbxi_snapshot_header header; // ufbxi_uninit
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, ufbxi_snapshot_magic, sizeof(header.magic));
+	header.format_version = UFBXI_SNAPSHOT_FORMAT_VERSION;
+	header.source_version = ufbx_source_version;
+	header.endian_check = UFBXI_SNAPSHOT_ENDIAN_CHECK;
+	header.pointer_size = (uint32_t)sizeof(void*);
+	header.real_size = (uint32_t)sizeof(ufbx_real);
+	header.scene_imp_size = (uint32_t)sizeof(ufbxi_scene_imp);
+	header.opts_hash = imp->opts_hash;
+	header.image_size = sc->image_size;
+	header.scene_offset = 0;
+	header.bitmap_words = sc->bitmap_words;
+
+	const ufbxi_snapshot_range *imp_range = ufbxi_snapshot_find_range(sc, (uintptr_t)imp);
+	ufbxi_check_err(&sc->error, imp_range);
+	header.scene_offset = imp_range->offset + ((uintptr_t)imp - imp_range->begin);
+
+	sc->block = ufbxi_alloc(&sc->ator_tmp, char, UFBXI_SNAPSHOT_BLOCK_SIZE);
+	ufbxi_check_err(&sc->error, sc->block);
+
+	ufbxi_check_err(&sc->error, ufbxi_snapshot_write(sc, &header, sizeof(header)));
+	ufbxi_check_err(&sc->error, ufbxi_snapshot_write_image(sc));
+	ufbxi_check_err(&sc->error, ufbxi_snapshot_write(sc, sc->bitmap, sc->bitmap_words * sizeof(uint64_t)));
+
+	return 1;
+}
+
+static ufbxi_noinline size_t ufbxi_snapshot_size(const ufbxi_save_snapshot_context *sc)
+{
+	return sizeof(ufbxi_snapshot_header) + sc->image_size + sc->bitmap_words * sizeof(uint64_t);
+}
+
+static ufbxi_noinline void ufbxi_begin_save_snapshot(ufbxi_save_snapshot_context *sc, const ufbx_scene *scene)
+{
+	memset(sc, 0, sizeof(ufbxi_save_snapshot_context));
+	ufbxi_init_ator(&sc->error, &sc->ator_tmp, NULL, "temp");
+	sc->imp = ufbxi_get_imp(ufbxi_scene_imp, scene);
+}
+
+static ufbxi_noinline bool ufbxi_end_save_snapshot(ufbxi_save_snapshot_context *sc, ufbx_error *p_error, bool ok)
+{
+	size_t num_strings = UFBXI_SNAPSHOT_NUM_STATIC_STRINGS;
+	if (sc->block) ufbxi_free(&sc->ator_tmp, char, sc->block, UFBXI_SNAPSHOT_BLOCK_SIZE);
+	if (sc->bitmap) ufbxi_free(&sc->ator_tmp, uint64_t, sc->bitmap, sc->bitmap_words);
+	if (sc->spans) ufbxi_free(&sc->ator_tmp, ufbxi_snapshot_span, sc->spans, sc->spans_cap);
+	if (sc->strings) ufbxi_free(&sc->ator_tmp, ufbxi_snapshot_string, sc->strings, num_strings);
+	if (sc->ranges) ufbxi_free(&sc->ator_tmp, ufbxi_snapshot_range, sc->ranges, sc->num_ranges);
+	ufbxi_free_ator(&sc->ator_tmp);
+
+	if (ok) {
+		ufbxi_clear_error(p_error);
+	} else {
+		ufbxi_fix_error_type(&sc->error, "Failed to save snapshot", p_error);
+	}
+	return ok;
+}
+
+typedef struct {
+	char *dst;
+	size_t pos;
+} ufbxi_snapshot_memory_writer;
+
+static size_t ufbxi_snapshot_memory_write(void *user, const void *data, size_t size)
+{
+	ufbxi_snapshot_memory_writer *writer = (ufbxi_snapshot_memory_writer*)user;
+	memcpy(writer->dst + writer->pos, data, size);
+	writer->pos += size;
+	return size;
+}
+
+#if !defined(UFBX_NO_STDIO) && !defined(UFBX_EXTERNAL_STDIO)
+
+static size_t ufbxi_snapshot_file_write(void *user, const void *data, size_t size)
+{
+	return fwrite(data, 1, size, (FILE*)user);
+}
+
+#endif
+
+typedef struct {
+	ufbx_error error;
+
+	ufbx_load_opts opts;
+	ufbxi_allocator ator_tmp;
+	ufbxi_allocator ator_result;
+
+	// Input, either `data` or `stream`
+	const char *data;
+	size_t data_size;
+	ufbx_stream stream;
+
+	ufbxi_buf_chunk *chunk;
+	size_t chunk_size;
+
+	uint64_t *bitmap;
+	size_t bitmap_words;
+	uint64_t bytes_read;
+
+	ufbxi_scene_imp *imp;
+} ufbxi_load_snapshot_context;
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_snapshot_read(ufbxi_load_snapshot_context *lc, void *dst, size_t size)
+{
+	lc->bytes_read += size;
+	if (lc->stream.read_fn) {
+		char *ptr = (char*)dst;
+		while (size > 0) {
+			size_t num_read = lc->stream.read_fn(lc->stream.user, ptr, size);
+			ufbxi_check_err_msg(&lc->error, num_read != SIZE_MAX, "IO error");
+			ufbxi_check_err_msg(&lc->error, num_read != 0 && num_read <= size, "Truncated file");
+			ptr += num_read;
+			size -= num_read;
+		}
+	} else {
+		ufbxi_check_err_msg(&lc->error, size <= lc->data_size, "Truncated file");
+		memcpy(dst, lc->data, size);
+		lc->data += size;
+		lc->data_size -= size;
+	}
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_snapshot_relocate(ufbxi_load_snapshot_context *lc, char *image, size_t image_size)
+{
+	size_t num_strings = UFBXI_SNAPSHOT_NUM_STATIC_STRINGS;
+	for (size_t bitmap_ix = 0; bitmap_ix < lc->bitmap_words; bitmap_ix++) {
+		uint64_t bits = lc->bitmap[bitmap_ix];
+		while (bits) {
+			uint64_t low_bit = bits & (~bits + 1u);
+			bits ^= low_bit;
+			size_t word = bitmap_ix * 64 + (63 - ufbxi_lzcnt64(low_bit));
+			ufbxi_check_err_msg(&lc->error, word < image_size / sizeof(uintptr_t), "Bad snapshot");
+
+			char *ptr = image + word * sizeof(uintptr_t);
+			uintptr_t encoded, value; // ufbxi_uninit
+			memcpy(&encoded, ptr, sizeof(uintptr_t));
+
+			uintptr_t payload = encoded >> 2u;
+			switch (encoded & 0x3) {
+			case UFBXI_SNAPSHOT_PTR_NULL:
+				ufbxi_check_err_msg(&lc->error, encoded == 0, "Bad snapshot");
+				value = 0;
+				break;
+			case UFBXI_SNAPSHOT_PTR_IMAGE:
+				ufbxi_check_err_msg(&lc->error, payload <= image_size, "Bad snapshot");
+				value = (uintptr_t)(image + payload);
+				break;
+			case UFBXI_SNAPSHOT_PTR_ZERO:
+				ufbxi_check_err_msg(&lc->error, payload <= sizeof(ufbxi_zero_size_buffer), "Bad snapshot");
+				value = (uintptr_t)(ufbxi_zero_size_buffer + payload);
+				break;
+			default:
+				ufbxi_check_err_msg(&lc->error, payload < num_strings, "Bad snapshot");
+				value = (uintptr_t)ufbxi_snapshot_static_string(payload);
+				break;
+			}
+			memcpy(ptr, &value, sizeof(uintptr_t));
+		}
+	}
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_snapshot_imp(ufbxi_load_snapshot_context *lc)
+{
+	ufbxi_snapshot_header header; // ufbxi_uninit
+	ufbxi_check_err(&lc->error, ufbxi_snapshot_read(lc, &header, sizeof(header)));
+	ufbxi_check_err_msg(&lc->error, !memcmp(header.magic, ufbxi_snapshot_magic, sizeof(header.magic)), "Unrecognized file format");
+
+	// Snapshots are only valid for the exact same build and load options
+	ufbxi_check_err_msg(&lc->error, header.format_version == UFBXI_SNAPSHOT_FORMAT_VERSION, "Snapshot mismatch");
+	ufbxi_check_err_msg(&lc->error, header.source_version == ufbx_source_version, "Snapshot mismatch");
+	ufbxi_check_err_msg(&lc->error, header.endian_check == UFBXI_SNAPSHOT_ENDIAN_CHECK, "Snapshot mismatch");
+	ufbxi_check_err_msg(&lc->error, header.pointer_size == sizeof(void*), "Snapshot mismatch");
+	ufbxi_check_err_msg(&lc->error, header.real_size == sizeof(ufbx_real), "Snapshot mismatch");
+	ufbxi_check_err_msg(&lc->error, header.scene_imp_size == sizeof(ufbxi_scene_imp), "Snapshot mismatch");
+	ufbxi_check_err_msg(&lc->error, header.opts_hash == ufbxi_hash_load_opts(&lc->opts), "Snapshot mismatch");
+
+	ufbxi_check_err_msg(&lc->error, header.image_size <= (UINTPTR_MAX >> 2u) && header.image_size <= SIZE_MAX - sizeof(ufbxi_buf_chunk), "Bad snapshot");
+	size_t image_size = (size_t)header.image_size;
+	ufbxi_check_err_msg(&lc->error, header.bitmap_words == (image_size / sizeof(uintptr_t) + 63) / 64, "Bad snapshot");
+	ufbxi_check_err_msg(&lc->error, image_size >= sizeof(ufbxi_scene_imp) && header.scene_offset <= image_size - sizeof(ufbxi_scene_imp), "Bad snapshot");
+	ufbxi_check_err_msg(&lc->error, header.scene_offset % UFBX_MAXIMUM_ALIGNMENT == 0, "Bad snapshot");
+
+	// Read the image directly into what becomes the only chunk of the scene buffer
+	lc->chunk_size = sizeof(ufbxi_buf_chunk) + image_size;
+	lc->chunk = (ufbxi_buf_chunk*)ufbxi_alloc(&lc->ator_result, char, lc->chunk_size);
+	ufbxi_check_err(&lc->error, lc->chunk);
+	ufbxi_buf_chunk *chunk = lc->chunk;
+	ufbxi_check_err(&lc->error, ufbxi_snapshot_read(lc, chunk->data, image_size));
+
+	lc->bitmap_words = (size_t)header.bitmap_words;
+	lc->bitmap = ufbxi_alloc(&lc->ator_tmp, uint64_t, lc->bitmap_words);
+	ufbxi_check_err(&lc->error, lc->bitmap);
+	ufbxi_check_err(&lc->error, ufbxi_snapshot_read(lc, lc->bitmap, lc->bitmap_words * sizeof(uint64_t)));
+
+	ufbxi_check_err(&lc->error, ufbxi_snapshot_relocate(lc, chunk->data, image_size));
+
+	ufbxi_scene_imp *imp = (ufbxi_scene_imp*)(chunk->data + header.scene_offset);
+	ufbxi_check_err_msg(&lc->error, imp->magic == UFBXI_SCENE_IMP_MAGIC, "Bad snapshot");
+
+	chunk->root = chunk;
+	chunk->prev = NULL;
+	chunk->next = NULL;
+	chunk->magic = UFBXI_BUF_CHUNK_IMP_MAGIC;
+	chunk->size = image_size;
+	chunk->pushed_pos = image_size;
+	chunk->next_size = image_size;
+	chunk->padding_pos = 0;
+
+	// Rebuild the runtime state of the scene, the allocator now owns the chunk
+	ufbxi_init_ref(&imp->refcount, UFBXI_SCENE_IMP_MAGIC, NULL);
+	imp->refcount.ator = lc->ator_result;
+	imp->refcount.ator.error = NULL;
+	memset(&imp->refcount.buf, 0, sizeof(ufbxi_buf));
+	imp->refcount.buf.ator = &imp->refcount.ator;
+	imp->refcount.buf.chunks[0] = chunk;
+	imp->refcount.buf.pos = image_size;
+	imp->refcount.buf.size = image_size;
+	imp->refcount.buf.unordered = true;
+	memset(&imp->string_buf, 0, sizeof(ufbxi_buf));
+	imp->string_buf.ator = &imp->refcount.ator;
+
+	imp->lazy_meshes = NULL;
+	imp->num_lazy_meshes = 0;
+	imp->lazy_data = NULL;
+	imp->lazy_size = 0;
+	memset(&imp->lazy_opts, 0, sizeof(imp->lazy_opts));
+
+	imp->scene.metadata.result_memory_used = imp->refcount.ator.current_size;
+	imp->scene.metadata.temp_memory_used = lc->ator_tmp.current_size;
+	imp->scene.metadata.result_allocs = imp->refcount.ator.num_allocs;
+	imp->scene.metadata.temp_allocs = lc->ator_tmp.num_allocs;
+
+	lc->imp = imp;
+	return 1;
+}
+
+static ufbxi_noinline ufbx_scene *ufbxi_load_snapshot(ufbxi_load_snapshot_context *lc, const char *filename, size_t filename_len, const ufbx_load_opts *opts, ufbx_error *p_error)
+{
+	if (opts) {
+		lc->opts = *opts;
+	} else {
+		memset(&lc->opts, 0, sizeof(ufbx_load_opts));
+	}
+	ufbxi_init_ator(&lc->error, &lc->ator_tmp, &lc->opts.temp_allocator, "temp");
+	ufbxi_init_ator(&lc->error, &lc->ator_result, &lc->opts.result_allocator, "result");
+
+	double wall_begin = 0.0, cpu_begin = 0.0;
+	if (lc->opts.collect_load_stats) {
+		wall_begin = ufbxi_read_clock(&lc->opts.clock_cb, false);
+		cpu_begin = ufbxi_read_clock(&lc->opts.clock_cb, true);
+	}
+
+	bool ok = true;
+	if (filename) {
+		if (filename_len == SIZE_MAX) filename_len = strlen(filename);
+		ufbx_open_file_cb cb = lc->opts.open_file_cb;
+		if (!cb.fn || cb.fn == &ufbx_default_open_file) {
+			ufbx_error error;
+			error.type = UFBX_ERROR_NONE;
+			ok = ufbx_open_file_ctx(&lc->stream, (ufbx_open_file_context)&lc->ator_tmp, filename, filename_len, NULL, &error);
+			if (!ok && error.type != UFBX_ERROR_NONE) {
+				lc->error = error;
+			}
+		} else {
+			ok = ufbxi_open_file(&cb, &lc->stream, filename, filename_len, NULL, &lc->ator_tmp, UFBX_OPEN_FILE_MAIN_MODEL);
+		}
+		if (!ok && lc->error.type == UFBX_ERROR_NONE) {
+			ufbxi_set_err_info(&lc->error, filename, filename_len);
+			ufbxi_report_err_msg(&lc->error, "open_file_fn()", "File not found");
+		}
+	}
+
+	if (ok) {
+		ok = ufbxi_load_snapshot_imp(lc) != 0;
+	}
+
+	if (lc->stream.close_fn) {
+		lc->stream.close_fn(lc->stream.user);
+	}
+	if (lc->bitmap) ufbxi_free(&lc->ator_tmp, uint64_t, lc->bitmap, lc->bitmap_words);
+
+	// Statistics of the original load are not saved, report reading the snapshot instead
+	if (ok && lc->opts.collect_load_stats) {
+		ufbx_load_stats *stats = &lc->imp->scene.metadata.load_stats;
+		stats->enabled = true;
+		stats->has_time = lc->opts.clock_cb.fn != NULL || UFBXI_HAS_CLOCK;
+
+		ufbx_load_phase_stats *io = &stats->phases[UFBX_LOAD_PHASE_IO];
+		io->wall_time = ufbxi_read_clock(&lc->opts.clock_cb, false) - wall_begin;
+		io->cpu_time = ufbxi_read_clock(&lc->opts.clock_cb, true) - cpu_begin;
+		io->count = 1;
+		stats->total_wall_time = io->wall_time;
+		stats->total_cpu_time = io->cpu_time;
+
+		stats->bytes_read = lc->bytes_read;
+		stats->peak_temp_memory_used = lc->ator_tmp.peak_size;
+	}
+
+	ufbxi_free_ator(&lc->ator_tmp);
+
+	if (ok) {
+		ufbxi_clear_error(p_error);
+		return &lc->imp->scene;
+	} else {
+		if (lc->chunk) ufbxi_free(&lc->ator_result, char, lc->chunk, lc->chunk_size);
+		ufbxi_free_ator(&lc->ator_result);
+		ufbxi_fix_error_type(&lc->error, "Failed to load snapshot", p_error);
+		return NULL;
+	}
+}
+
+// -- Load cache
+
+#if !defined(UFBX_NO_STDIO) && !defined(UFBX_EXTERNAL_STDIO)
+
+#define UFBXI_LOAD_CACHE_SUFFIX ".ufbxcache"
+
+typedef struct {
+	ufbx_error error;
+	ufbxi_allocator ator_tmp;
+	ufbx_load_opts opts;
+
+	// Contents of the main file, either read to `data` or mapped
+	char *data;
+	size_t data_size;
+	size_t data_cap;
+	const void *map_data;
+	size_t map_size;
+
+	// NULL-terminated `<cache_dir>/<key>.ufbxcache`
+	char *path;
+	size_t path_len;
+	size_t dir_len;
+} ufbxi_load_cache_context;
+
+typedef struct {
+	char *path;
+	size_t path_len;
+	uint64_t size;
+	int64_t mtime;
+} ufbxi_load_cache_entry;
+
+static ufbxi_noinline bool ufbxi_load_cache_read_main(ufbxi_load_cache_context *cc, const char *filename, size_t filename_len)
+{
+	bool use_default = cc->opts.open_main_file_with_default || !cc->opts.open_file_cb.fn || cc->opts.open_file_cb.fn == &ufbx_default_open_file;
+
+	#if UFBXI_HAS_MMAP
+		if (use_default && ufbxi_mmap_open(&cc->ator_tmp, filename, filename_len, false, &cc->map_data, &cc->map_size)) {
+			return true;
+		}
+	#endif
+
+	ufbx_stream stream = { 0 };
+	bool ok = false;
+	if (use_default) {
+		ok = ufbx_open_file_ctx(&stream, (ufbx_open_file_context)&cc->ator_tmp, filename, filename_len, NULL, NULL);
+	} else {
+		ok = ufbxi_open_file(&cc->opts.open_file_cb, &stream, filename, filename_len, NULL, &cc->ator_tmp, UFBX_OPEN_FILE_MAIN_MODEL);
+	}
+	if (!ok) return false;
+
+	size_t read_size = cc->opts.read_buffer_size ? cc->opts.read_buffer_size : 0x10000;
+	if (stream.size_fn) {
+		uint64_t size = stream.size_fn(stream.user);
+		if (size > 0 && size < SIZE_MAX) read_size = (size_t)size + 1;
+	}
+
+	for (;;) {
+		if (cc->data_cap - cc->data_size < read_size) {
+			ok = ufbxi_grow_array(&cc->ator_tmp, &cc->data, &cc->data_cap, cc->data_size + read_size);
+			if (!ok) break;
+		}
+		size_t num_read = stream.read_fn(stream.user, cc->data + cc->data_size, cc->data_cap - cc->data_size);
+		if (num_read == SIZE_MAX || num_read > cc->data_cap - cc->data_size) {
+			ok = false;
+			break;
+		}
+		if (num_read == 0) break;
+		cc->data_size += num_read;
+	}
+
+	if (stream.close_fn) {
+		stream.close_fn(stream.user);
+	}
+	return ok;
+}
+
+static ufbxi_forceinline uint64_t ufbxi_load_cache_mix(uint64_t h, uint64_t v, uint64_t k)
+{
+	h = (h ^ v) * k;
+	return h ^ (h >> 29);
+}
+
+// Hash the contents of the main file with two independent 64-bit lanes, this is not
+// a cryptographic hash but 128 bits make accidental collisions practically impossible.
+static ufbxi_noinline void ufbxi_load_cache_hash(uint64_t hash[2], const void *data, size_t size)
+{
+	const uint64_t k0 = UINT64_C(0x9e3779b97f4a7c15), k1 = UINT64_C(0xc2b2ae3d27d4eb4f);
+	uint64_t h0 = hash[0], h1 = hash[1];
+	const char *ptr = (const char*)data, *end = ptr + size;
+	for (; end - ptr >= 16; ptr += 16) {
+		h0 = ufbxi_load_cache_mix(h0, ufbxi_read_u64(ptr), k0);
+		h1 = ufbxi_load_cache_mix(h1, ufbxi_read_u64(ptr + 8), k1);
+	}
+	uint64_t tail[2] = { 0, 0 };
+	memcpy(tail, ptr, (size_t)(end - ptr));
+	h0 = ufbxi_load_cache_mix(h0, tail[0] ^ (uint64_t)size, k0);
+	h1 = ufbxi_load_cache_mix(h1, tail[1] ^ h0, k1);
+	h0 = ufbxi_load_cache_mix(h0, h1, k1);
+	hash[0] = h0;
+	hash[1] = h1;
+}
+
+static ufbxi_noinline void ufbxi_load_cache_format_hex(char *dst, const uint64_t *words, size_t num_words)
+{
+	const char *digits = "0123456789abcdef";
+	for (size_t i = 0; i < num_words; i++) {
+		for (size_t j = 0; j < 16; j++) {
+			*dst++ = digits[(words[i] >> (60 - j * 4)) & 0xf];
+		}
+	}
+}
+
+// Build the path of the cache entry from the contents of the main file, the name it's
+// loaded as (affects `ufbx_metadata.filename` and external files) and the options.
+static ufbxi_noinline bool ufbxi_load_cache_init_path(ufbxi_load_cache_context *cc)
+{
+	const void *data = cc->map_data ? cc->map_data : cc->data;
+	size_t data_size = cc->map_data ? cc->map_size : cc->data_size;
+
+	uint64_t opts_hash = ufbxi_hash_load_opts(&cc->opts);
+	uint64_t version = ufbx_source_version;
+	uint64_t key[2] = { opts_hash, ufbxi_hash_bytes64(UINT64_C(0xcbf29ce484222325), &version, sizeof(version)) };
+	ufbxi_load_cache_hash(key, cc->opts.filename.data, cc->opts.filename.length);
+	ufbxi_load_cache_hash(key, data, data_size);
+
+	const char *dir = cc->opts.cache_dir.data;
+	size_t dir_len = cc->opts.cache_dir.length;
+	if (dir_len == SIZE_MAX) dir_len = strlen(dir);
+	if (dir_len == 0) return false;
+
+	char sep = cc->opts.path_separator ? cc->opts.path_separator : UFBX_PATH_SEPARATOR;
+	bool has_sep = dir[dir_len - 1] == sep || dir[dir_len - 1] == '/';
+	size_t path_len = dir_len + (has_sep ? 0 : 1) + 32 + (sizeof(UFBXI_LOAD_CACHE_SUFFIX) - 1);
+
+	char *path = ufbxi_alloc(&cc->ator_tmp, char, path_len + 1);
+	if (!path) return false;
+
+	char *dst = path;
+	memcpy(dst, dir, dir_len);
+	dst += dir_len;
+	if (!has_sep) *dst++ = sep;
+	cc->dir_len = (size_t)(dst - path);
+	ufbxi_load_cache_format_hex(dst, key, 2);
+	dst += 32;
+	memcpy(dst, UFBXI_LOAD_CACHE_SUFFIX, sizeof(UFBXI_LOAD_CACHE_SUFFIX));
+
+	cc->path = path;
+	cc->path_len = path_len;
+	return true;
+}
+
+#if UFBXI_HAS_DIRENT
+
+// Modification time in nanoseconds, `st_mtime` alone only has a resolution of one second.
+static int64_t ufbxi_load_cache_mtime(const struct stat *st)
+{
+#if defined(__APPLE__)
+	return (int64_t)st->st_mtimespec.tv_sec * INT64_C(1000000000) + (int64_t)st->st_mtimespec.tv_nsec;
+#elif defined(st_mtime)
+	// `st_mtime` is defined as `st_mtim.tv_sec` when `st_mtim` is available
+	return (int64_t)st->st_mtim.tv_sec * INT64_C(1000000000) + (int64_t)st->st_mtim.tv_nsec;
+#else
+	return (int64_t)st->st_mtime * INT64_C(1000000000);
+#endif
+}
+
+static bool ufbxi_load_cache_entry_less(void *user, const void *va, const void *vb)
+{
+	(void)user;
+	const ufbxi_load_cache_entry *a = (const ufbxi_load_cache_entry*)va, *b = (const ufbxi_load_cache_entry*)vb;
+	if (a->mtime != b->mtime) return a->mtime < b->mtime;
+	return strcmp(a->path, b->path) < 0;
+}
+
+// Remove the least recently used entries until the cache fits in `cache_max_size`.
+// Hits update the modification time of the entry so it doubles as the access time,
+// ties are broken by path so that concurrent processes agree on the order.
+// The entry that was just written is never removed even if it alone exceeds the limit.
+static ufbxi_noinline void ufbxi_load_cache_evict(ufbxi_load_cache_context *cc)
+{
+	char *dir = ufbxi_alloc(&cc->ator_tmp, char, cc->dir_len + 1);
+	if (!dir) return;
+	memcpy(dir, cc->path, cc->dir_len);
+	dir[cc->dir_len] = '\0';
+
+	ufbxi_load_cache_entry *entries = NULL;
+	size_t num_entries = 0, entries_cap = 0;
+	uint64_t total_size = 0;
+
+	DIR *dp = opendir(dir);
+	if (dp) {
+		struct dirent *ent;
+		const size_t suffix_len = sizeof(UFBXI_LOAD_CACHE_SUFFIX) - 1;
+		while ((ent = readdir(dp)) != NULL) {
+			size_t name_len = strlen(ent->d_name);
+			if (name_len <= suffix_len || memcmp(ent->d_name + name_len - suffix_len, UFBXI_LOAD_CACHE_SUFFIX, suffix_len) != 0) continue;
+			if (!ufbxi_grow_array(&cc->ator_tmp, &entries, &entries_cap, num_entries + 1)) break;
+
+			size_t path_len = cc->dir_len + name_len;
+			char *path = ufbxi_alloc(&cc->ator_tmp, char, path_len + 1);
+			if (!path) break;
+			memcpy(path, dir, cc->dir_len);
+			memcpy(path + cc->dir_len, ent->d_name, name_len + 1);
+
+			struct stat st; // ufbxi_uninit
+			if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) {
+				ufbxi_free(&cc->ator_tmp, char, path, path_len + 1);
+				continue;
+			}
+
+			ufbxi_load_cache_entry *entry = &entries[num_entries++];
+			entry->path = path;
+			entry->path_len = path_len;
+			entry->size = (uint64_t)st.st_size;
+			entry->mtime = ufbxi_load_cache_mtime(&st);
+			total_size += entry->size;
+		}
+		closedir(dp);
+	}
+
+	if (total_size > cc->opts.cache_max_size) {
+		ufbxi_unstable_sort(entries, num_entries, sizeof(ufbxi_load_cache_entry), &ufbxi_load_cache_entry_less, NULL);
+		for (size_t i = 0; i < num_entries && total_size > cc->opts.cache_max_size; i++) {
+			if (entries[i].path_len == cc->path_len && !memcmp(entries[i].path, cc->path, cc->path_len)) continue;
+
+			// Another process may have removed the entry already
+			ufbxi_ignore(unlink(entries[i].path));
+			total_size -= entries[i].size;
+		}
+	}
+
+	for (size_t i = 0; i < num_entries; i++) {
+		ufbxi_free(&cc->ator_tmp, char, entries[i].path, entries[i].path_len + 1);
+	}
+	if (entries) ufbxi_free(&cc->ator_tmp, ufbxi_load_cache_entry, entries, entries_cap);
+	ufbxi_free(&cc->ator_tmp, char, dir, cc->dir_len + 1);
+}
+
+#endif
+
+// Write the scene to a temporary file and rename it in place so that concurrent
+// loads never see a partially written entry.
+static ufbxi_noinline void ufbxi_load_cache_store(ufbxi_load_cache_context *cc, const ufbx_scene *scene)
+{
+	// The temporary name is unique between processes by the process ID, between threads
+	// by the address of `cc` on the loading thread's stack and between successive loads
+	// by the current time.
+	uint64_t unique[3] = { 0, (uint64_t)(uintptr_t)cc, 0 };
+	#if UFBXI_HAS_DIRENT
+		unique[0] = (uint64_t)getpid();
+	#endif
+	#if UFBXI_HAS_CLOCK
+		struct timespec ts; // ufbxi_uninit
+		if (clock_gettime(CLOCK_REALTIME, &ts) == 0) {
+			unique[2] = (uint64_t)ts.tv_sec * UINT64_C(1000000000) + (uint64_t)ts.tv_nsec;
+		}
+	#endif
+
+	const char tmp_suffix[] = ".tmp";
+	size_t tmp_len = cc->path_len + 1 + 48 + (sizeof(tmp_suffix) - 1);
+	char *tmp = ufbxi_alloc(&cc->ator_tmp, char, tmp_len + 1);
+	if (!tmp) return;
+	memcpy(tmp, cc->path, cc->path_len);
+	tmp[cc->path_len] = '.';
+	ufbxi_load_cache_format_hex(tmp + cc->path_len + 1, unique, 3);
+	memcpy(tmp + cc->path_len + 1 + 48, tmp_suffix, sizeof(tmp_suffix));
+
+	bool ok = ufbx_save_scene_snapshot_len(scene, tmp, tmp_len, NULL);
+	if (ok) {
+		ok = rename(tmp, cc->path) == 0;
+	}
+	if (!ok) {
+		ufbxi_ignore(remove(tmp));
+	}
+	ufbxi_free(&cc->ator_tmp, char, tmp, tmp_len + 1);
+
+	#if UFBXI_HAS_DIRENT
+		if (ok && cc->opts.cache_max_size > 0) {
+			ufbxi_load_cache_evict(cc);
+		}
+	#endif
+}
+
+static ufbxi_noinline ufbx_scene *ufbxi_load_file_cached(const char *filename, size_t filename_len, const ufbx_load_opts *opts, ufbx_error *p_error)
+{
+	ufbxi_load_cache_context cc; // ufbxi_uninit
+	memset(&cc, 0, sizeof(cc));
+	cc.opts = *opts;
+	ufbxi_init_ator(&cc.error, &cc.ator_tmp, &cc.opts.temp_allocator, "cache");
+
+	// Load the file with the cache disabled, either from memory or normally as a fallback
+	ufbx_load_opts load_opts = *opts;
+	memset(&load_opts.cache_dir, 0, sizeof(load_opts.cache_dir));
+	load_opts.cache_max_size = 0;
+
+	if (filename_len == SIZE_MAX) filename_len = strlen(filename);
+	if (!ufbxi_load_cache_read_main(&cc, filename, filename_len)) {
+		if (cc.data) ufbxi_free(&cc.ator_tmp, char, cc.data, cc.data_cap);
+		ufbxi_free_ator(&cc.ator_tmp);
+		return ufbx_load_file_len(filename, filename_len, &load_opts, p_error);
+	}
+
+	// Match `ufbx_load_file()` which loads relative to `filename` unless overridden
+	if (cc.opts.filename.length == 0 || cc.opts.filename.data == NULL) {
+		cc.opts.filename.data = filename;
+		cc.opts.filename.length = filename_len;
+	} else if (cc.opts.filename.length == SIZE_MAX) {
+		cc.opts.filename.length = strlen(cc.opts.filename.data);
+	}
+	load_opts.filename = cc.opts.filename;
+
+	ufbx_scene *scene = NULL;
+	if (ufbxi_load_cache_init_path(&cc)) {
+		ufbx_load_opts snapshot_opts = load_opts;
+		memset(&snapshot_opts.open_file_cb, 0, sizeof(snapshot_opts.open_file_cb));
+		ufbx_error snapshot_error; // ufbxi_uninit
+		scene = ufbx_load_scene_snapshot_len(cc.path, cc.path_len, &snapshot_opts, &snapshot_error);
+		if (scene) {
+			scene->metadata.loaded_from_cache = true;
+			#if UFBXI_HAS_DIRENT
+				ufbxi_ignore(utime(cc.path, NULL));
+			#endif
+			ufbxi_clear_error(p_error);
+		}
+	}
+
+	if (!scene) {
+		const void *data = cc.map_data ? cc.map_data : cc.data;
+		size_t data_size = cc.map_data ? cc.map_size : cc.data_size;
+		scene = ufbx_load_memory(data, data_size, &load_opts, p_error);
+		if (scene && cc.path) {
+			ufbxi_load_cache_store(&cc, scene);
+		}
+	}
+
+	#if UFBXI_HAS_MMAP
+		if (cc.map_data) ufbxi_mmap_close(cc.map_data, cc.map_size);
+	#endif
+	if (cc.data) ufbxi_free(&cc.ator_tmp, char, cc.data, cc.data_cap);
+	if (cc.path) ufbxi_free(&cc.ator_tmp, char, cc.path, cc.path_len + 1);
+	ufbxi_free_ator(&cc.ator_tmp);
+
+	return scene;
+}
+
+#endif
+
+// -- Batch loading
+//
+// `ufbx_load_files()` loads files on worker threads shared by the whole batch. Each load
+// gets the workers through the `ufbx_thread_pool` interface and its task ranges are queued
+// to a single FIFO in `ufbxi_batch`. Idle workers run queued tasks before starting new
+// files so that a large file gets the whole pool once there are no files left to start.
+// A load waiting for a group only runs its own tasks so it can never block on another
+// file, tasks never wait so this can't deadlock.
+//
+// Loads in progress charge a shared `ufbxi_memory_budget`. Files that don't fit in the
+// remaining budget are not started while other loads are running, and files that run out
+// of memory anyway are retried once nothing else is loading.
+
+typedef struct ufbxi_batch ufbxi_batch;
+typedef struct ufbxi_batch_range ufbxi_batch_range;
+
+// Tasks of a single group of a load, linked to `ufbxi_batch.queue` while `count > 0`.
+struct ufbxi_batch_range {
+	ufbxi_batch_range *prev, *next;
+	ufbx_thread_pool_context ctx;
+	uint32_t index;
+	uint32_t count;
+	size_t num_submitted;
+	size_t num_done;
+};
+
+typedef struct {
+	ufbxi_batch *batch;
+	ufbxi_batch_range ranges[UFBX_THREAD_GROUP_COUNT];
+} ufbxi_batch_client;
 
-	ufbxi_for_ptr_list(ufbx_element, p_elem, imp->scene.elements) {
-		(*p_elem)->scene = &imp->scene;
-	}
+typedef struct {
+	const char *filename;
+	size_t index;
+	uint64_t size;
 
-	uc->scene_imp = imp;
+	// `ufbxi_batch.num_starts` when the load was started, used to detect if the load
+	// was running alone the whole time.
+	size_t start_count;
+	bool start_alone;
+	bool exclusive;
+} ufbxi_batch_file;
 
-	return 1;
+struct ufbxi_batch {
+	ufbx_error error;
+	ufbxi_allocator ator;
+	ufbx_load_opts load_opts;
+	ufbx_load_files_cb result_cb;
+
+	// Files sorted from largest to smallest if the sizes are available
+	ufbxi_batch_file *files;
+	size_t num_files;
+	size_t next_file;
+
+	// Files that ran out of memory while loading concurrently
+	ufbxi_batch_file **deferred;
+	size_t num_deferred;
+
+	size_t num_active;
+	size_t max_active;
+	size_t num_starts;
+	bool exclusive; // < Retrying a deferred file, don't start anything else
+	size_t num_loaded;
+
+	bool use_budget;
+	ufbxi_memory_budget budget;
+
+	bool use_shared_strings;
+	ufbxi_string_pool shared_strings;
+
+#if UFBXI_HAS_PTHREADS
+	pthread_mutex_t mutex;
+	pthread_cond_t work_cond;
+	pthread_cond_t done_cond;
+	pthread_mutex_t result_mutex;
+	bool sync_initialized;
+	bool budget_initialized;
+
+	ufbxi_batch_range queue; // < Sentinel of the task range FIFO
+	bool use_pool;
+
+	pthread_t *threads;
+	size_t num_threads;
+	size_t num_started;
+#endif
+};
+
+static ufbxi_noinline ufbx_scene *ufbxi_load_file_shared(const char *filename, size_t filename_len, const ufbx_load_opts *opts, ufbxi_memory_budget *budget, ufbxi_map *shared_strings, ufbx_error *error)
+{
+#if !defined(UFBX_NO_STDIO) && !defined(UFBX_EXTERNAL_STDIO)
+	if (opts && opts->cache_dir.data && opts->cache_dir.length > 0) {
+		if (!opts->lazy_geometry && !opts->borrow_input_arrays && !opts->mesh_stream_cb.fn && !opts->element_filter_cb.fn) {
+			return ufbxi_load_file_cached(filename, filename_len, opts, error);
+		}
+	}
+#endif
+	ufbxi_context uc; // ufbxi_uninit
+	memset(&uc, 0, sizeof(ufbxi_context));
+	uc.deferred_load = true;
+	uc.load_filename = filename;
+	uc.load_filename_len = filename_len;
+	uc.memory_budget = budget;
+	uc.shared_strings = shared_strings;
+	return ufbxi_load(&uc, opts, error);
 }
 
-static ufbxi_noinline void ufbxi_free_temp(ufbxi_context *uc)
+static ufbxi_forceinline void ufbxi_batch_lock(ufbxi_batch *batch)
 {
-	ufbxi_thread_pool_free(&uc->thread_pool);
+#if UFBXI_HAS_PTHREADS
+	pthread_mutex_lock(&batch->mutex);
+#else
+	(void)batch;
+#endif
+}
 
-	ufbxi_string_pool_temp_free(&uc->string_pool);
-	ufbxi_buf_free(&uc->warnings.tmp_stack);
+static ufbxi_forceinline void ufbxi_batch_unlock(ufbxi_batch *batch)
+{
+#if UFBXI_HAS_PTHREADS
+	pthread_mutex_unlock(&batch->mutex);
+#else
+	(void)batch;
+#endif
+}
 
-	ufbxi_map_free(&uc->prop_type_map);
-	ufbxi_map_free(&uc->fbx_id_map);
-	ufbxi_map_free(&uc->ptr_fbx_id_map);
-	ufbxi_map_free(&uc->texture_file_map);
-	ufbxi_map_free(&uc->anim_stack_map);
-	ufbxi_map_free(&uc->fbx_attr_map);
-	ufbxi_map_free(&uc->node_prop_set);
-	ufbxi_map_free(&uc->dom_node_map);
+#if UFBXI_HAS_PTHREADS
 
-	ufbxi_buf_free(&uc->tmp);
-	ufbxi_buf_free(&uc->tmp_parse);
-	for (size_t i = 0; i < UFBX_THREAD_GROUP_COUNT; i++) {
-		ufbxi_buf_free(&uc->tmp_thread_parse[i]);
-	}
-	ufbxi_buf_free(&uc->tmp_stack);
-	ufbxi_buf_free(&uc->tmp_connections);
-	ufbxi_buf_free(&uc->tmp_node_ids);
-	ufbxi_buf_free(&uc->tmp_elements);
-	ufbxi_buf_free(&uc->tmp_element_offsets);
-	ufbxi_buf_free(&uc->tmp_element_fbx_ids);
-	ufbxi_buf_free(&uc->tmp_element_ptrs);
-	for (size_t i = 0; i < UFBX_ELEMENT_TYPE_COUNT; i++) {
-		ufbxi_buf_free(&uc->tmp_typed_element_offsets[i]);
+// Run the next task of `range`, called and returns with `batch->mutex` locked.
+static void ufbxi_batch_run_task(ufbxi_batch *batch, ufbxi_batch_range *range)
+{
+	uint32_t index = range->index++;
+	if (--range->count == 0) {
+		range->prev->next = range->next;
+		range->next->prev = range->prev;
+		range->prev = range->next = NULL;
 	}
-	ufbxi_buf_free(&uc->tmp_mesh_textures);
-	ufbxi_buf_free(&uc->tmp_full_weights);
-	ufbxi_buf_free(&uc->tmp_dom_nodes);
-	ufbxi_buf_free(&uc->tmp_element_id);
-	ufbxi_buf_free(&uc->tmp_ascii_spans);
 
-	ufbxi_free(&uc->ator_tmp, ufbxi_node, uc->top_nodes, uc->top_nodes_cap);
-	ufbxi_free(&uc->ator_tmp, void*, uc->element_extra_arr, uc->element_extra_cap);
+	// `range` stays valid until all of its tasks are done, see `ufbxi_batch_pool_wait()`.
+	pthread_mutex_unlock(&batch->mutex);
+	ufbx_thread_pool_run_task(range->ctx, index);
+	pthread_mutex_lock(&batch->mutex);
 
-	ufbxi_free(&uc->ator_tmp, char, uc->ascii.token.str_data, uc->ascii.token.str_cap);
-	ufbxi_free(&uc->ator_tmp, char, uc->ascii.prev_token.str_data, uc->ascii.prev_token.str_cap);
+	if (++range->num_done == range->num_submitted) {
+		pthread_cond_broadcast(&batch->done_cond);
+	}
+}
 
-	ufbxi_free(&uc->ator_tmp, char, uc->read_buffer, uc->read_buffer_size);
-	ufbxi_free(&uc->ator_tmp, char, uc->tmp_arr, uc->tmp_arr_size);
-	ufbxi_free(&uc->ator_tmp, char, uc->swap_arr, uc->swap_arr_size);
+static void ufbxi_batch_pool_run(void *user, ufbx_thread_pool_context ctx, uint32_t group, uint32_t start_index, uint32_t count)
+{
+	ufbxi_batch_client *client = (ufbxi_batch_client*)user;
+	ufbxi_batch *batch = client->batch;
+	ufbxi_batch_range *range = &client->ranges[group];
+	if (count == 0) return;
 
-	ufbxi_obj_free(uc);
+	pthread_mutex_lock(&batch->mutex);
+	ufbx_assert(range->count == 0);
+	range->ctx = ctx;
+	range->index = start_index;
+	range->count = count;
+	range->num_submitted += count;
 
-	ufbxi_free_ator(&uc->ator_tmp);
+	range->prev = batch->queue.prev;
+	range->next = &batch->queue;
+	range->prev->next = range;
+	batch->queue.prev = range;
+
+	pthread_cond_broadcast(&batch->work_cond);
+	pthread_mutex_unlock(&batch->mutex);
 }
 
-static ufbxi_noinline void ufbxi_free_result(ufbxi_context *uc)
+static void ufbxi_batch_pool_wait(void *user, ufbx_thread_pool_context ctx, uint32_t group, uint32_t max_index)
 {
-	ufbxi_buf_free(&uc->result);
-	ufbxi_buf_free(&uc->string_pool.buf);
+	(void)ctx;
+	(void)max_index;
+	ufbxi_batch_client *client = (ufbxi_batch_client*)user;
+	ufbxi_batch *batch = client->batch;
+	ufbxi_batch_range *range = &client->ranges[group];
 
-	ufbxi_free_ator(&uc->ator_result);
+	pthread_mutex_lock(&batch->mutex);
+	while (range->count > 0) {
+		ufbxi_batch_run_task(batch, range);
+	}
+	while (range->num_done != range->num_submitted) {
+		pthread_cond_wait(&batch->done_cond, &batch->mutex);
+	}
+	pthread_mutex_unlock(&batch->mutex);
 }
 
-static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_opts *user_opts, ufbx_error *p_error)
+#endif
+
+static ufbxi_noinline size_t ufbxi_budget_available(ufbxi_memory_budget *budget)
 {
-	// Test endianness
-	{
-		uint8_t buf[2];
-		uint16_t val = 0xbbaa;
-		memcpy(buf, &val, 2);
-		uc->local_big_endian = buf[0] == 0xbb;
-	}
+#if UFBXI_HAS_PTHREADS
+	pthread_mutex_lock(&budget->mutex);
+#endif
+	size_t available = budget->limit - budget->used;
+#if UFBXI_HAS_PTHREADS
+	pthread_mutex_unlock(&budget->mutex);
+#endif
+	return available;
+}
 
-	uc->double_parse_flags = ufbxi_parse_double_init_flags();
+// Pick the next file to load, called with `batch->mutex` locked.
+static ufbxi_noinline ufbxi_batch_file *ufbxi_batch_next_file(ufbxi_batch *batch)
+{
+	if (batch->exclusive) return NULL;
 
-	if (user_opts) {
-		uc->opts = *user_opts;
+	ufbxi_batch_file *file = NULL;
+	if (batch->num_deferred > 0) {
+		// Let the running loads finish and retry the file alone
+		if (batch->num_active > 0) return NULL;
+		file = batch->deferred[--batch->num_deferred];
+		batch->exclusive = true;
 	} else {
-		memset(&uc->opts, 0, sizeof(uc->opts));
-	}
-
-	if (uc->opts.file_size_estimate) {
-		uc->progress_bytes_total = uc->opts.file_size_estimate;
-	}
+		if (batch->next_file >= batch->num_files || batch->num_active >= batch->max_active) return NULL;
+		file = &batch->files[batch->next_file];
 
-	if (uc->opts.ignore_all_content) {
-		uc->opts.ignore_geometry = true;
-		uc->opts.ignore_animation = true;
-		uc->opts.ignore_embedded = true;
+		// The file size is a lower bound for the memory needed, don't start loads that
+		// are bound to fail while others are running.
+		if (batch->use_budget && batch->num_active > 0) {
+			if (file->size > ufbxi_budget_available(&batch->budget)) return NULL;
+		}
+		batch->next_file++;
 	}
 
-	ufbx_inflate_retain inflate_retain;
-	inflate_retain.initialized = false;
+	file->exclusive = batch->exclusive;
+	file->start_alone = batch->num_active == 0;
+	file->start_count = ++batch->num_starts;
+	batch->num_active++;
+	return file;
+}
 
-	ufbxi_init_ator(&uc->error, &uc->ator_tmp, &uc->opts.temp_allocator, "temp");
-	ufbxi_init_ator(&uc->error, &uc->ator_result, &uc->opts.result_allocator, "result");
+static ufbxi_noinline void ufbxi_batch_load(ufbxi_batch *batch, ufbxi_batch_file *file)
+{
+	ufbx_load_opts opts = batch->load_opts;
 
-	if (uc->opts.read_buffer_size == 0) {
-		uc->opts.read_buffer_size = 0x4000;
-	}
-	if (uc->opts.read_buffer_size <= 32) {
-		uc->opts.read_buffer_size = 32;
+#if UFBXI_HAS_PTHREADS
+	ufbxi_batch_client client; // ufbxi_uninit
+	memset(&client, 0, sizeof(client));
+	client.batch = batch;
+	if (batch->use_pool) {
+		opts.thread_opts.pool.run_fn = &ufbxi_batch_pool_run;
+		opts.thread_opts.pool.wait_fn = &ufbxi_batch_pool_wait;
+		opts.thread_opts.pool.user = &client;
 	}
+#endif
 
-	if (uc->opts.file_format_lookahead == 0) {
-		uc->opts.file_format_lookahead = 0x4000;
-	} else if (uc->opts.file_format_lookahead < UFBXI_MIN_FILE_FORMAT_LOOKAHEAD) {
-		uc->opts.file_format_lookahead = UFBXI_MIN_FILE_FORMAT_LOOKAHEAD;
+	ufbx_error error; // ufbxi_uninit
+	ufbxi_memory_budget *budget = batch->use_budget ? &batch->budget : NULL;
+	ufbxi_map *shared_strings = batch->use_shared_strings ? &batch->shared_strings.map : NULL;
+	ufbx_scene *scene = ufbxi_load_file_shared(file->filename, SIZE_MAX, &opts, budget, shared_strings, &error);
+
+	// Finished scenes don't count towards the budget
+	if (scene) {
+		ufbxi_scene_imp *imp = ufbxi_get_imp(ufbxi_scene_imp, scene);
+		if (imp->refcount.ator.budget) {
+			ufbxi_budget_release(imp->refcount.ator.budget, imp->refcount.ator.current_size);
+			imp->refcount.ator.budget = NULL;
+		}
 	}
 
-	if (!uc->opts.path_separator) {
-		uc->opts.path_separator = UFBX_PATH_SEPARATOR;
+	ufbxi_batch_lock(batch);
+	bool alone = file->start_alone && batch->num_starts == file->start_count;
+	batch->num_active--;
+	if (file->exclusive) batch->exclusive = false;
+
+	bool defer = !scene && !alone && batch->use_budget && error.type == UFBX_ERROR_MEMORY_LIMIT;
+	if (defer) {
+		batch->deferred[batch->num_deferred++] = file;
+	} else if (scene) {
+		batch->num_loaded++;
 	}
 
-	if (!uc->opts.progress_cb.fn || uc->opts.progress_interval_hint >= SIZE_MAX) {
-		uc->progress_interval = SIZE_MAX;
-	} else if (uc->opts.progress_interval_hint > 0) {
-		uc->progress_interval = (size_t)uc->opts.progress_interval_hint;
+#if UFBXI_HAS_PTHREADS
+	pthread_cond_broadcast(&batch->work_cond);
+#endif
+	ufbxi_batch_unlock(batch);
+	if (defer) return;
+
+	if (batch->result_cb.fn) {
+#if UFBXI_HAS_PTHREADS
+		pthread_mutex_lock(&batch->result_mutex);
+#endif
+		batch->result_cb.fn(batch->result_cb.user, file->index, scene, &error);
+#if UFBXI_HAS_PTHREADS
+		pthread_mutex_unlock(&batch->result_mutex);
+#endif
 	} else {
-		uc->progress_interval = 0x4000;
+		ufbx_free_scene(scene);
 	}
+}
 
-	if (!uc->opts.open_file_cb.fn) {
-		uc->opts.open_file_cb.fn = &ufbx_default_open_file;
-	}
+// Run queued tasks and load files until the batch is finished.
+static ufbxi_noinline void ufbxi_batch_work(ufbxi_batch *batch)
+{
+	ufbxi_batch_lock(batch);
+	for (;;) {
+#if UFBXI_HAS_PTHREADS
+		if (batch->queue.next != &batch->queue) {
+			ufbxi_batch_run_task(batch, batch->queue.next);
+			continue;
+		}
+#endif
 
-	if (!uc->opts.thread_opts.memory_limit) {
-		uc->opts.thread_opts.memory_limit = 32*1024*1024;
+		ufbxi_batch_file *file = ufbxi_batch_next_file(batch);
+		if (file) {
+			ufbxi_batch_unlock(batch);
+			ufbxi_batch_load(batch, file);
+			ufbxi_batch_lock(batch);
+			continue;
+		}
+
+		if (batch->num_active == 0 && batch->num_deferred == 0 && batch->next_file >= batch->num_files) break;
+
+#if UFBXI_HAS_PTHREADS
+		pthread_cond_wait(&batch->work_cond, &batch->mutex);
+#else
+		ufbxi_unreachable("Nothing to wait for without threads");
+		break;
+#endif
 	}
+	ufbxi_batch_unlock(batch);
+}
 
-	uc->synthetic_id_counter = UFBXI_SYNTHETIC_ID_START;
+#if UFBXI_HAS_PTHREADS
+static void *ufbxi_batch_thread_entry(void *user)
+{
+	ufbxi_batch_work((ufbxi_batch*)user);
+	return NULL;
+}
+#endif
 
-	uc->string_pool.error = &uc->error;
-	ufbxi_map_init(&uc->string_pool.map, &uc->ator_tmp, &ufbxi_map_cmp_string, NULL);
-	uc->string_pool.buf.ator = &uc->ator_result;
-	uc->string_pool.buf.unordered = true;
-	uc->string_pool.initial_size = 1024;
-	uc->string_pool.error_handling = uc->opts.unicode_error_handling;
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_batch_init(ufbxi_batch *batch, const char *const *filenames, size_t num_files, const ufbx_load_files_opts *opts)
+{
+	ufbx_error *error = &batch->error;
 
-	ufbxi_map_init(&uc->prop_type_map, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
-	ufbxi_map_init(&uc->fbx_id_map, &uc->ator_tmp, &ufbxi_map_cmp_uint64, NULL);
-	ufbxi_map_init(&uc->ptr_fbx_id_map, &uc->ator_tmp, &ufbxi_map_cmp_ptr_id, NULL);
-	ufbxi_map_init(&uc->texture_file_map, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
-	ufbxi_map_init(&uc->anim_stack_map, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
-	ufbxi_map_init(&uc->fbx_attr_map, &uc->ator_tmp, &ufbxi_map_cmp_uint64, NULL);
-	ufbxi_map_init(&uc->node_prop_set, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
-	ufbxi_map_init(&uc->dom_node_map, &uc->ator_tmp, &ufbxi_map_cmp_uintptr, NULL);
+	batch->load_opts = opts->load_opts;
+	memset(&batch->load_opts.thread_opts.pool, 0, sizeof(ufbx_thread_pool));
+	batch->load_opts.thread_opts.num_threads = 0;
+	batch->result_cb = opts->result_cb;
 
-	uc->tmp.ator = &uc->ator_tmp;
-	uc->tmp_parse.ator = &uc->ator_tmp;
-	uc->tmp_stack.ator = &uc->ator_tmp;
-	uc->tmp_connections.ator = &uc->ator_tmp;
-	uc->tmp_node_ids.ator = &uc->ator_tmp;
-	uc->tmp_elements.ator = &uc->ator_tmp;
-	uc->tmp_element_offsets.ator = &uc->ator_tmp;
-	uc->tmp_element_fbx_ids.ator = &uc->ator_tmp;
-	uc->tmp_element_ptrs.ator = &uc->ator_tmp;
-	for (size_t i = 0; i < UFBX_ELEMENT_TYPE_COUNT; i++) {
-		uc->tmp_typed_element_offsets[i].ator = &uc->ator_tmp;
+	batch->num_files = num_files;
+	batch->files = ufbxi_alloc(&batch->ator, ufbxi_batch_file, num_files);
+	ufbxi_check_err(error, batch->files);
+	memset(batch->files, 0, sizeof(ufbxi_batch_file) * num_files);
+	batch->deferred = ufbxi_alloc(&batch->ator, ufbxi_batch_file*, num_files);
+	ufbxi_check_err(error, batch->deferred);
+
+	for (size_t i = 0; i < num_files; i++) {
+		ufbxi_batch_file *file = &batch->files[i];
+		file->filename = filenames[i];
+		file->index = i;
+		#if UFBXI_HAS_MMAP
+		{
+			struct stat st;
+			if (stat(file->filename, &st) == 0 && st.st_size > 0) {
+				file->size = (uint64_t)st.st_size;
+			}
+		}
+		#endif
 	}
-	uc->tmp_mesh_textures.ator = &uc->ator_tmp;
-	uc->tmp_full_weights.ator = &uc->ator_tmp;
-	uc->tmp_dom_nodes.ator = &uc->ator_tmp;
-	uc->tmp_element_id.ator = &uc->ator_tmp;
-	uc->tmp_ascii_spans.ator = &uc->ator_tmp;
 
-	for (size_t i = 0; i < UFBX_THREAD_GROUP_COUNT; i++) {
-		uc->tmp_thread_parse[i].ator = &uc->ator_tmp;
-		uc->tmp_thread_parse[i].unordered = true;
-		uc->tmp_thread_parse[i].clearable = true;
+	#if UFBXI_HAS_MMAP
+	{
+		// Start from the largest files so the small ones can fill in at the end
+		ufbxi_batch_file *tmp = ufbxi_alloc(&batch->ator, ufbxi_batch_file, num_files);
+		ufbxi_check_err(error, tmp);
+		ufbxi_macro_stable_sort(ufbxi_batch_file, 32, batch->files, tmp, num_files, ( a->size > b->size ));
+		ufbxi_free(&batch->ator, ufbxi_batch_file, tmp, num_files);
 	}
+	#endif
 
-	uc->result.ator = &uc->ator_result;
+	if (!opts->no_shared_strings) {
+		ufbxi_string_pool *pool = &batch->shared_strings;
+		pool->error = error;
+		pool->initial_size = 1024;
+		pool->buf.ator = &batch->ator;
+		ufbxi_map_init(&pool->map, &batch->ator, &ufbxi_map_cmp_string, NULL);
+		batch->use_shared_strings = true;
+		ufbxi_check_err(error, ufbxi_init_shared_strings(pool));
+	}
 
-	uc->tmp.unordered = true;
-	uc->tmp_parse.unordered = true;
-	uc->tmp_parse.clearable = true;
-	uc->result.unordered = true;
+	size_t num_threads = 0;
+	#if UFBXI_HAS_PTHREADS
+		num_threads = opts->num_threads;
+		if (num_threads == SIZE_MAX) {
+			num_threads = ufbxi_os_pool_default_threads();
+		}
+		num_threads = ufbxi_min_sz(num_threads, UFBXI_MAX_POOL_THREADS);
+	#endif
 
-	uc->warnings.error = &uc->error;
-	uc->warnings.result = &uc->result;
-	uc->warnings.tmp_stack.ator = &uc->ator_tmp;
-	uc->string_pool.warnings = &uc->warnings;
+	batch->max_active = opts->max_concurrent_files ? opts->max_concurrent_files : num_threads + 1;
 
-	// Set zero size `swap_arr` to a non-NULL buffer so we can tell the difference between empty
-	// array and an allocation failure.
-	uc->swap_arr = (char*)ufbxi_zero_size_buffer;
+	#if UFBXI_HAS_PTHREADS
+	{
+		ufbxi_check_err(error, pthread_mutex_init(&batch->mutex, NULL) == 0);
+		if (pthread_cond_init(&batch->work_cond, NULL) != 0) {
+			pthread_mutex_destroy(&batch->mutex);
+			ufbxi_fail_err(error, "pthread_cond_init()");
+		}
+		if (pthread_cond_init(&batch->done_cond, NULL) != 0) {
+			pthread_cond_destroy(&batch->work_cond);
+			pthread_mutex_destroy(&batch->mutex);
+			ufbxi_fail_err(error, "pthread_cond_init()");
+		}
+		if (pthread_mutex_init(&batch->result_mutex, NULL) != 0) {
+			pthread_cond_destroy(&batch->done_cond);
+			pthread_cond_destroy(&batch->work_cond);
+			pthread_mutex_destroy(&batch->mutex);
+			ufbxi_fail_err(error, "pthread_mutex_init()");
+		}
+		batch->sync_initialized = true;
+		batch->queue.prev = batch->queue.next = &batch->queue;
+	}
+	#endif
 
-	// NOTE: Though `inflate_retain` leaks out of the scope we don't use it outside this function.
-	// cppcheck-suppress autoVariables
-	uc->inflate_retain = &inflate_retain;
+	if (opts->memory_limit > 0) {
+		#if UFBXI_HAS_PTHREADS
+			ufbxi_check_err(error, pthread_mutex_init(&batch->budget.mutex, NULL) == 0);
+			batch->budget_initialized = true;
+		#endif
+		batch->budget.limit = opts->memory_limit;
+		batch->use_budget = true;
+	}
 
-	int ok = ufbxi_load_imp(uc);
+	#if UFBXI_HAS_PTHREADS
+	if (num_threads > 0) {
+		batch->threads = ufbxi_alloc(&batch->ator, pthread_t, num_threads);
+		ufbxi_check_err(error, batch->threads);
+		batch->num_threads = num_threads;
+		batch->use_pool = true;
 
-	if (uc->close_fn) {
-		uc->close_fn(uc->read_user);
+		// If some of the threads fail to start the rest of the workers pick up the files
+		for (size_t i = 0; i < num_threads; i++) {
+			if (pthread_create(&batch->threads[i], NULL, &ufbxi_batch_thread_entry, batch) != 0) break;
+			batch->num_started++;
+		}
 	}
+	#endif
 
-	ufbxi_free_temp(uc);
+	return 1;
+}
 
-	if (ok) {
-		if (p_error) {
-			ufbxi_clear_error(p_error);
-		}
-		return &uc->scene_imp->scene;
-	} else {
-		ufbxi_fix_error_type(&uc->error, "Failed to load", p_error);
-		if (p_error && p_error->type == UFBX_ERROR_UNKNOWN && uc->scene.metadata.file_format == UFBX_FILE_FORMAT_FBX && !ufbxi_supports_version(uc->version)) {
-			p_error->description.data = "Unsupported version";
-			p_error->description.length = strlen("Unsupported version");
-			p_error->type = UFBX_ERROR_UNSUPPORTED_VERSION;
-			ufbxi_fmt_err_info(p_error, "%u", uc->version);
-		}
-		ufbxi_free_result(uc);
-		return NULL;
+static ufbxi_noinline void ufbxi_batch_free(ufbxi_batch *batch)
+{
+#if UFBXI_HAS_PTHREADS
+	for (size_t i = 0; i < batch->num_started; i++) {
+		pthread_join(batch->threads[i], NULL);
+	}
+	if (batch->threads) ufbxi_free(&batch->ator, pthread_t, batch->threads, batch->num_threads);
+
+	if (batch->budget_initialized) {
+		pthread_mutex_destroy(&batch->budget.mutex);
+	}
+	if (batch->sync_initialized) {
+		pthread_mutex_destroy(&batch->result_mutex);
+		pthread_cond_destroy(&batch->done_cond);
+		pthread_cond_destroy(&batch->work_cond);
+		pthread_mutex_destroy(&batch->mutex);
+	}
+#endif
+
+	if (batch->use_shared_strings) {
+		ufbxi_string_pool_temp_free(&batch->shared_strings);
 	}
+	if (batch->deferred) ufbxi_free(&batch->ator, ufbxi_batch_file*, batch->deferred, batch->num_files);
+	if (batch->files) ufbxi_free(&batch->ator, ufbxi_batch_file, batch->files, batch->num_files);
+	ufbxi_free_ator(&batch->ator);
 }
 
 // -- Animation evaluation
@@ -26406,6 +32000,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_imp(ufbxi_eval_context
 	if (ec->opts.evaluate_skinning) {
 		ufbx_geometry_cache_data_opts cache_opts = { 0 };
 		cache_opts.open_file_cb = ec->opts.open_file_cb;
+		cache_opts.reader = ec->opts.cache_reader;
 		ufbxi_check_err(&ec->error, ufbxi_evaluate_skinning(&ec->scene, &ec->error, &ec->result, &ec->tmp,
 			ec->time, ec->opts.load_external_files && ec->opts.evaluate_caches, &cache_opts));
 	}
@@ -28242,6 +33837,21 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_tessellate_nurbs_surface_imp(ufb
 
 // -- Topology
 
+// Read a position (or other `ufbx_vertex_vec3`) for geometry utilities, also handles
+// `ufbx_load_opts.float_geometry`.
+ufbxi_forceinline static ufbx_vec3 ufbxi_get_vertex_position(const ufbx_vertex_vec3 *positions, size_t index)
+{
+	int32_t ix = (int32_t)positions->indices.data[index];
+	if (positions->values.count > 0) return positions->values.data[ix];
+
+	const float *src = positions->values_float.data + (ptrdiff_t)ix * 3;
+	ufbx_vec3 v;
+	v.x = (ufbx_real)src[0];
+	v.y = (ufbx_real)src[1];
+	v.z = (ufbx_real)src[2];
+	return v;
+}
+
 #if UFBXI_FEATURE_KD
 
 typedef struct {
@@ -28273,7 +33883,7 @@ typedef struct {
 
 ufbxi_noinline static ufbx_vec2 ufbxi_ngon_project(ufbxi_ngon_context *nc, uint32_t index)
 {
-	ufbx_vec3 point = nc->positions.values.data[nc->positions.indices.data[nc->face.index_begin + index]];
+	ufbx_vec3 point = ufbxi_get_vertex_position(&nc->positions, nc->face.index_begin + index);
 
 	ufbx_vec2 p;
 	p.x = ufbxi_dot3(nc->axes[0], point);
@@ -28314,7 +33924,7 @@ ufbxi_noinline static bool ufbxi_kd_check_slow(ufbxi_ngon_context *nc, const ufb
 		uint32_t num_right = count - (num_left + 1);
 
 		uint32_t index = kd_indices[begin + num_left];
-		ufbx_vec3 point = pos.values.data[pos.indices.data[nc->face.index_begin + index]];
+		ufbx_vec3 point = ufbxi_get_vertex_position(&pos, nc->face.index_begin + index);
 		ufbx_real split = ufbxi_dot3(point, nc->axes[axis]);
 		bool hit_left = tri->min_t[axis] <= split;
 		bool hit_right = tri->max_t[axis] >= split;
@@ -28410,8 +34020,8 @@ ufbxi_noinline static bool ufbxi_kd_index_less(void *user, const void *va, const
 	ufbxi_ngon_context *nc = (ufbxi_ngon_context*)user;
 	ufbx_vertex_vec3 *pos = &nc->positions;
 	const uint32_t a = *(const uint32_t*)va, b = *(const uint32_t*)vb;
-	ufbx_real da = ufbxi_dot3(nc->cur_axis_dir, pos->values.data[pos->indices.data[nc->cur_face.index_begin + a]]);
-	ufbx_real db = ufbxi_dot3(nc->cur_axis_dir, pos->values.data[pos->indices.data[nc->cur_face.index_begin + b]]);
+	ufbx_real da = ufbxi_dot3(nc->cur_axis_dir, ufbxi_get_vertex_position(pos, nc->cur_face.index_begin + a));
+	ufbx_real db = ufbxi_dot3(nc->cur_axis_dir, ufbxi_get_vertex_position(pos, nc->cur_face.index_begin + b));
 	return da < db;
 }
 
@@ -28443,7 +34053,7 @@ ufbxi_noinline static void ufbxi_kd_build(ufbxi_ngon_context *nc, uint32_t *indi
 		uint32_t index = indices[num_left];
 		ufbxi_kd_node *kd = &nc->kd_nodes[fast_index];
 
-		kd->split = ufbxi_dot3(axis_dir, pos.values.data[pos.indices.data[face.index_begin + index]]);
+		kd->split = ufbxi_dot3(axis_dir, ufbxi_get_vertex_position(&pos, face.index_begin + index));
 		kd->index_plus_one = index + 1;
 
 		if (depth + 1 == UFBXI_KD_FAST_DEPTH) {
@@ -28804,10 +34414,10 @@ static bool ufbxi_is_edge_smooth(const ufbx_mesh *mesh, const ufbx_topo_edge *to
 		uint32_t twin = topo[index].twin;
 		if (twin != UFBX_NO_INDEX && mesh->vertex_normal.exists) {
 			ufbx_assert((size_t)twin < num_topo);
-			ufbx_vec3 a0 = ufbx_get_vertex_vec3(&mesh->vertex_normal, index);
-			ufbx_vec3 a1 = ufbx_get_vertex_vec3(&mesh->vertex_normal, topo[index].next);
-			ufbx_vec3 b0 = ufbx_get_vertex_vec3(&mesh->vertex_normal, topo[twin].next);
-			ufbx_vec3 b1 = ufbx_get_vertex_vec3(&mesh->vertex_normal, twin);
+			ufbx_vec3 a0 = ufbxi_get_vertex_position(&mesh->vertex_normal, index);
+			ufbx_vec3 a1 = ufbxi_get_vertex_position(&mesh->vertex_normal, topo[index].next);
+			ufbx_vec3 b0 = ufbxi_get_vertex_position(&mesh->vertex_normal, topo[twin].next);
+			ufbx_vec3 b1 = ufbxi_get_vertex_position(&mesh->vertex_normal, twin);
 			if (a0.x == b0.x && a0.y == b0.y && a0.z == b0.z) return true;
 			if (a1.x == b1.x && a1.y == b1.y && a1.z == b1.z) return true;
 		}
@@ -29937,6 +35547,9 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_subdivide_mesh_imp(ufbxi_subdivi
 	ufbxi_init_ator(&sc->error, &sc->ator_tmp, &sc->opts.temp_allocator, "temp");
 	ufbxi_init_ator(&sc->error, &sc->ator_result, &sc->opts.result_allocator, "result");
 
+	// Positions are only available as `float` with `ufbx_load_opts.float_geometry`
+	ufbxi_check_err_msg(&sc->error, sc->src_mesh.num_vertices == 0 || sc->src_mesh.vertices.count > 0, "Unsupported float geometry");
+
 	sc->result.unordered = true;
 	sc->source.unordered = true;
 	sc->tmp.unordered = true;
@@ -30240,12 +35853,375 @@ static ufbxi_noinline size_t ufbxi_generate_indices(const ufbx_vertex_stream *us
 
 #endif
 
+// -- Vertex packing
+
+typedef struct {
+	ufbxi_refcount refcount;
+	ufbx_packed_mesh packed;
+	uint32_t magic;
+} ufbxi_packed_mesh_imp;
+
+ufbx_static_assert(packed_mesh_imp_offset, offsetof(ufbxi_packed_mesh_imp, packed) == sizeof(ufbxi_refcount));
+
+#if UFBXI_FEATURE_TRIANGULATION && UFBXI_FEATURE_INDEX_GENERATION
+
+typedef struct {
+	ufbx_error error;
+
+	ufbx_pack_mesh_opts opts;
+
+	const ufbx_mesh *mesh;
+	const ufbx_mesh_part *part;
+
+	ufbxi_allocator ator_tmp;
+	ufbxi_allocator ator_result;
+
+	ufbxi_buf tmp;
+	ufbxi_buf result;
+
+	ufbx_packed_mesh packed;
+
+	ufbxi_packed_mesh_imp *imp;
+
+} ufbxi_pack_context;
+
+// Read `num_components` of an attribute value, supports `ufbx_load_opts.float_geometry`.
+static ufbxi_noinline ufbx_vec4 ufbxi_pack_get_value(const ufbx_vertex_attrib *attrib, size_t num_components, size_t index)
+{
+	ufbx_vec4 value = { 0.0f };
+	uint32_t ix = attrib->indices.data[index];
+	if (attrib->values.count > 0) {
+		if (ix < attrib->values.count) {
+			const ufbx_real *src = (const ufbx_real*)attrib->values.data + ix * num_components;
+			for (size_t i = 0; i < num_components; i++) value.v[i] = src[i];
+		}
+	} else if (ix < attrib->values_float.count / num_components) {
+		const float *src = attrib->values_float.data + ix * num_components;
+		for (size_t i = 0; i < num_components; i++) value.v[i] = (ufbx_real)src[i];
+	}
+	return value;
+}
+
+static ufbxi_forceinline int32_t ufbxi_pack_round(double value)
+{
+	return (int32_t)ufbx_floor(value + 0.5);
+}
+
+static ufbxi_forceinline uint16_t ufbxi_pack_unorm16(double value)
+{
+	if (!(value > 0.0)) return 0;
+	if (value >= 1.0) return UINT16_MAX;
+	return (uint16_t)ufbxi_pack_round(value * 65535.0);
+}
+
+static ufbxi_forceinline uint8_t ufbxi_pack_unorm8(double value)
+{
+	if (!(value > 0.0)) return 0;
+	if (value >= 1.0) return UINT8_MAX;
+	return (uint8_t)ufbxi_pack_round(value * 255.0);
+}
+
+static ufbxi_forceinline int16_t ufbxi_pack_snorm16(double value)
+{
+	if (!(value > -1.0)) return -INT16_MAX;
+	if (value >= 1.0) return INT16_MAX;
+	return (int16_t)ufbxi_pack_round(value * 32767.0);
+}
+
+static ufbxi_noinline void ufbxi_pack_octahedral(int16_t *dst, ufbx_vec4 v)
+{
+	double x = v.x, y = v.y, z = v.z;
+	double len = ufbx_fabs(x) + ufbx_fabs(y) + ufbx_fabs(z);
+	if (!(len > 0.0)) {
+		x = 0.0; y = 0.0; z = 1.0; len = 1.0;
+	}
+	x /= len;
+	y /= len;
+	if (z < 0.0) {
+		double ox = (1.0 - ufbx_fabs(y)) * (x >= 0.0 ? 1.0 : -1.0);
+		double oy = (1.0 - ufbx_fabs(x)) * (y >= 0.0 ? 1.0 : -1.0);
+		x = ox;
+		y = oy;
+	}
+	dst[0] = ufbxi_pack_snorm16(x);
+	dst[1] = ufbxi_pack_snorm16(y);
+}
+
+// Convert to IEEE 754 half precision rounding to nearest even.
+static ufbxi_noinline uint16_t ufbxi_pack_half(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(uint32_t));
+	uint32_t sign = (bits >> 16u) & 0x8000u;
+	uint32_t abs = bits & 0x7fffffffu;
+	if (abs > 0x7f800000u) return (uint16_t)(sign | 0x7e00u);
+	if (abs >= 0x477ff000u) return (uint16_t)(sign | 0x7c00u);
+	if (abs >= 0x38800000u) {
+		uint32_t rebias = abs - 0x38000000u;
+		return (uint16_t)(sign | ((rebias + 0xfffu + ((rebias >> 13u) & 1u)) >> 13u));
+	}
+	uint32_t exponent = abs >> 23u;
+	if (exponent < 102) return (uint16_t)sign;
+	uint32_t mantissa = (abs & 0x7fffffu) | 0x800000u;
+	uint32_t shift = 126u - exponent;
+	uint32_t result = mantissa >> shift;
+	uint32_t rem = mantissa & ((1u << shift) - 1u), half = 1u << (shift - 1u);
+	if (rem > half || (rem == half && (result & 1u) != 0)) result++;
+	return (uint16_t)(sign | result);
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_pack_mesh_imp(ufbxi_pack_context *pc)
+{
+	const ufbx_mesh *mesh = pc->mesh;
+	ufbx_packed_mesh *packed = &pc->packed;
+
+	ufbxi_init_ator(&pc->error, &pc->ator_tmp, &pc->opts.temp_allocator, "temp");
+	ufbxi_init_ator(&pc->error, &pc->ator_result, &pc->opts.result_allocator, "result");
+
+	pc->tmp.unordered = true;
+	pc->result.unordered = true;
+
+	pc->tmp.ator = &pc->ator_tmp;
+	pc->result.ator = &pc->ator_result;
+
+	const uint32_t *face_indices = NULL;
+	size_t num_faces = mesh->faces.count;
+	if (pc->part) {
+		face_indices = pc->part->face_indices.data;
+		num_faces = pc->part->face_indices.count;
+	}
+
+	size_t num_indices = 0;
+	for (size_t i = 0; i < num_faces; i++) {
+		uint32_t face_ix = face_indices ? face_indices[i] : (uint32_t)i;
+		ufbxi_check_err_msg(&pc->error, face_ix < mesh->faces.count, "Bad mesh part");
+		ufbx_face face = mesh->faces.data[face_ix];
+		ufbxi_check_err_msg(&pc->error, face.index_begin <= mesh->num_indices && mesh->num_indices - face.index_begin >= face.num_indices, "Bad mesh face");
+		if (face.num_indices >= 3) {
+			num_indices += ((size_t)face.num_indices - 2) * 3;
+		}
+	}
+	ufbxi_check_err(&pc->error, num_indices <= UINT32_MAX);
+
+	// Interleaved layout, every attribute is aligned to four bytes
+	ufbx_skin_deformer *skin = NULL;
+	if (!pc->opts.ignore_skinning) {
+		skin = pc->opts.skin_deformer;
+		if (!skin && mesh->skin_deformers.count > 0) {
+			skin = mesh->skin_deformers.data[0];
+		}
+		if (skin && skin->vertices.count < mesh->num_vertices) {
+			skin = NULL;
+		}
+	}
+
+	bool has_normals = mesh->vertex_normal.exists && !pc->opts.ignore_normals;
+	bool has_tangents = has_normals && mesh->vertex_tangent.exists && !pc->opts.ignore_tangents;
+	bool has_bitangents = has_tangents && mesh->vertex_bitangent.exists;
+
+	uint32_t stride = 0;
+	packed->position.format = UFBX_PACKED_FORMAT_UNORM16X4;
+	packed->position.offset = stride;
+	stride += 8;
+	if (has_normals) {
+		packed->normal.format = UFBX_PACKED_FORMAT_SNORM16X2_OCT;
+		packed->normal.offset = stride;
+		stride += 4;
+	}
+	if (has_tangents) {
+		packed->tangent.format = UFBX_PACKED_FORMAT_SNORM16X2_OCT;
+		packed->tangent.offset = stride;
+		stride += 4;
+	}
+	if (mesh->vertex_uv.exists && !pc->opts.ignore_uvs) {
+		packed->uv.format = UFBX_PACKED_FORMAT_HALF2;
+		packed->uv.offset = stride;
+		stride += 4;
+	}
+	if (mesh->vertex_color.exists && !pc->opts.ignore_colors) {
+		packed->color.format = UFBX_PACKED_FORMAT_UNORM8X4;
+		packed->color.offset = stride;
+		stride += 4;
+	}
+	if (skin) {
+		bool wide = pc->opts.wide_joint_indices || skin->clusters.count > 256;
+		packed->joints.format = wide ? UFBX_PACKED_FORMAT_UINT16X4 : UFBX_PACKED_FORMAT_UINT8X4;
+		packed->joints.offset = stride;
+		stride += wide ? 8 : 4;
+		packed->weights.format = UFBX_PACKED_FORMAT_UNORM8X4;
+		packed->weights.offset = stride;
+		stride += 4;
+	}
+
+	ufbxi_check_err(&pc->error, !ufbxi_does_overflow(num_indices * stride, num_indices, stride));
+
+	// Bounding box of the positions referenced by the packed faces
+	ufbx_vec3 min_pos = { 0.0f }, max_pos = { 0.0f };
+	bool first_pos = true;
+	for (size_t i = 0; i < num_faces; i++) {
+		ufbx_face face = mesh->faces.data[face_indices ? face_indices[i] : i];
+		if (face.num_indices < 3) continue;
+		for (uint32_t j = 0; j < face.num_indices; j++) {
+			ufbx_vec4 p = ufbxi_pack_get_value((const ufbx_vertex_attrib*)&mesh->vertex_position, 3, face.index_begin + j);
+			if (first_pos) {
+				min_pos.x = max_pos.x = p.x;
+				min_pos.y = max_pos.y = p.y;
+				min_pos.z = max_pos.z = p.z;
+				first_pos = false;
+			} else {
+				min_pos.x = ufbxi_min_real(min_pos.x, p.x); max_pos.x = ufbxi_max_real(max_pos.x, p.x);
+				min_pos.y = ufbxi_min_real(min_pos.y, p.y); max_pos.y = ufbxi_max_real(max_pos.y, p.y);
+				min_pos.z = ufbxi_min_real(min_pos.z, p.z); max_pos.z = ufbxi_max_real(max_pos.z, p.z);
+			}
+		}
+	}
+
+	double pos_extent[3] = { max_pos.x - min_pos.x, max_pos.y - min_pos.y, max_pos.z - min_pos.z };
+	double pos_rcp[3]; // ufbxi_uninit
+	for (size_t i = 0; i < 3; i++) {
+		pos_rcp[i] = pos_extent[i] > 0.0 ? 1.0 / pos_extent[i] : 0.0;
+		packed->position_scale.v[i] = (ufbx_real)(pos_extent[i] / 65535.0);
+	}
+	packed->position_offset = min_pos;
+
+	size_t num_tri_indices = ufbxi_max_sz(mesh->max_face_triangles * 3, 3);
+	uint32_t *tri_indices = ufbxi_push(&pc->tmp, uint32_t, num_tri_indices);
+	char *vertices = ufbxi_push_zero(&pc->tmp, char, ufbxi_max_sz(num_indices * stride, 1));
+	uint32_t *indices = ufbxi_push(&pc->result, uint32_t, ufbxi_max_sz(num_indices, 1));
+	ufbxi_check_err(&pc->error, tri_indices && vertices && indices);
+
+	char *dst = vertices;
+	for (size_t i = 0; i < num_faces; i++) {
+		ufbx_face face = mesh->faces.data[face_indices ? face_indices[i] : i];
+		uint32_t num_tris = ufbx_triangulate_face(tri_indices, num_tri_indices, mesh, face);
+		for (size_t corner = 0; corner < (size_t)num_tris * 3; corner++) {
+			uint32_t index = tri_indices[corner];
+
+			ufbx_vec4 pos = ufbxi_pack_get_value((const ufbx_vertex_attrib*)&mesh->vertex_position, 3, index);
+			uint16_t *dst_pos = (uint16_t*)(dst + packed->position.offset);
+			for (size_t c = 0; c < 3; c++) {
+				dst_pos[c] = ufbxi_pack_unorm16((pos.v[c] - min_pos.v[c]) * pos_rcp[c]);
+			}
+			dst_pos[3] = UINT16_MAX;
+
+			if (has_normals) {
+				ufbx_vec4 normal = ufbxi_pack_get_value((const ufbx_vertex_attrib*)&mesh->vertex_normal, 3, index);
+				ufbxi_pack_octahedral((int16_t*)(dst + packed->normal.offset), normal);
+				if (has_tangents) {
+					ufbx_vec4 tangent = ufbxi_pack_get_value((const ufbx_vertex_attrib*)&mesh->vertex_tangent, 3, index);
+					ufbxi_pack_octahedral((int16_t*)(dst + packed->tangent.offset), tangent);
+					if (has_bitangents) {
+						ufbx_vec4 bitangent = ufbxi_pack_get_value((const ufbx_vertex_attrib*)&mesh->vertex_bitangent, 3, index);
+						ufbx_vec3 n = { normal.x, normal.y, normal.z }, t = { tangent.x, tangent.y, tangent.z };
+						ufbx_vec3 nt = ufbxi_cross3(n, t);
+						if (nt.x*bitangent.x + nt.y*bitangent.y + nt.z*bitangent.z < 0.0f) {
+							dst_pos[3] = 0;
+						}
+					}
+				}
+			}
+
+			if (packed->uv.format) {
+				ufbx_vec4 uv = ufbxi_pack_get_value((const ufbx_vertex_attrib*)&mesh->vertex_uv, 2, index);
+				uint16_t *dst_uv = (uint16_t*)(dst + packed->uv.offset);
+				dst_uv[0] = ufbxi_pack_half((float)uv.x);
+				dst_uv[1] = ufbxi_pack_half((float)uv.y);
+			}
+
+			if (packed->color.format) {
+				ufbx_vec4 color = ufbxi_pack_get_value((const ufbx_vertex_attrib*)&mesh->vertex_color, 4, index);
+				uint8_t *dst_color = (uint8_t*)(dst + packed->color.offset);
+				for (size_t c = 0; c < 4; c++) {
+					dst_color[c] = ufbxi_pack_unorm8(color.v[c]);
+				}
+			}
+
+			if (skin) {
+				uint32_t vertex = mesh->vertex_indices.data[index];
+				ufbx_skin_vertex skin_vertex = skin->vertices.data[vertex];
+				size_t num_weights = ufbxi_min_sz(skin_vertex.num_weights, 4);
+				if (skin_vertex.weight_begin > skin->weights.count || skin->weights.count - skin_vertex.weight_begin < num_weights) {
+					num_weights = 0;
+				}
+
+				// Weights are sorted by decreasing weight, quantize and fix the total to 255 by
+				// adjusting the largest weight. Vertices without influences are left all zero.
+				const ufbx_skin_weight *weights = skin->weights.data + skin_vertex.weight_begin;
+				double total = 0.0;
+				for (size_t w = 0; w < num_weights; w++) {
+					total += ufbxi_max_real(weights[w].weight, 0.0f);
+				}
+				uint8_t *dst_weights = (uint8_t*)(dst + packed->weights.offset);
+				if (total > 0.0) {
+					int32_t sum = 0;
+					for (size_t w = 0; w < num_weights; w++) {
+						uint8_t q = ufbxi_pack_unorm8(ufbxi_max_real(weights[w].weight, 0.0f) / total);
+						dst_weights[w] = q;
+						sum += q;
+					}
+					dst_weights[0] = (uint8_t)(dst_weights[0] + (255 - sum));
+				} else {
+					num_weights = 0;
+				}
+
+				for (size_t w = 0; w < num_weights; w++) {
+					uint32_t cluster = weights[w].cluster_index;
+					if (packed->joints.format == UFBX_PACKED_FORMAT_UINT16X4) {
+						((uint16_t*)(dst + packed->joints.offset))[w] = (uint16_t)cluster;
+					} else {
+						((uint8_t*)(dst + packed->joints.offset))[w] = (uint8_t)cluster;
+					}
+				}
+			}
+
+			dst += stride;
+		}
+	}
+
+	size_t num_vertices = 0;
+	if (num_indices > 0) {
+		ufbx_vertex_stream stream = { vertices, num_indices, stride };
+		num_vertices = ufbxi_generate_indices(&stream, 1, indices, num_indices, &pc->opts.temp_allocator, &pc->error);
+		ufbxi_check_err(&pc->error, num_vertices > 0);
+	}
+
+	void *vertex_data = ufbxi_push_copy(&pc->result, char, ufbxi_max_sz(num_vertices * stride, 1), vertices);
+	ufbxi_check_err(&pc->error, vertex_data);
+
+	packed->vertex_data.data = vertex_data;
+	packed->vertex_data.size = num_vertices * stride;
+	packed->num_vertices = num_vertices;
+	packed->vertex_stride = stride;
+	packed->indices.data = indices;
+	packed->indices.count = num_indices;
+
+	pc->imp = ufbxi_push(&pc->result, ufbxi_packed_mesh_imp, 1);
+	ufbxi_check_err(&pc->error, pc->imp);
+
+	ufbxi_init_ref(&pc->imp->refcount, UFBXI_PACKED_MESH_IMP_MAGIC, NULL);
+
+	pc->imp->magic = UFBXI_PACKED_MESH_IMP_MAGIC;
+	pc->imp->packed = pc->packed;
+	pc->imp->refcount.ator = pc->ator_result;
+	pc->imp->refcount.buf = pc->result;
+
+	return 1;
+}
+
+#endif
+
 static ufbxi_noinline void ufbxi_free_scene_imp(ufbxi_scene_imp *imp)
 {
 	ufbx_assert(imp->magic == UFBXI_SCENE_IMP_MAGIC);
 	ufbxi_buf_free(&imp->string_buf);
 }
 
+static ufbxi_noinline void ufbxi_free_probe_imp(ufbxi_probe_imp *imp)
+{
+	ufbx_assert(imp->magic == UFBXI_PROBE_IMP_MAGIC);
+	ufbxi_buf_free(&imp->string_buf);
+}
+
 static ufbxi_noinline void ufbxi_init_ref(ufbxi_refcount *refcount, uint32_t magic, ufbxi_refcount *parent)
 {
 	if (parent) {
@@ -30283,6 +36259,7 @@ static ufbxi_noinline void ufbxi_release_ref(ufbxi_refcount *refcount)
 		switch (type_magic) {
 		case UFBXI_SCENE_IMP_MAGIC: ufbxi_free_scene_imp((ufbxi_scene_imp*)refcount); break;
 		case UFBXI_CACHE_IMP_MAGIC: ufbxi_free_geometry_cache_imp((ufbxi_geometry_cache_imp*)refcount); break;
+		case UFBXI_PROBE_IMP_MAGIC: ufbxi_free_probe_imp((ufbxi_probe_imp*)refcount); break;
 		default: break;
 		}
 
@@ -30510,6 +36487,13 @@ ufbx_abi ufbx_scene *ufbx_load_memory(const void *data, size_t size, const ufbx_
 	return ufbxi_load(&uc, opts, error);
 }
 
+ufbx_abi ufbx_mesh *ufbx_load_mesh_geometry(const ufbx_mesh *mesh, ufbx_error *error)
+{
+	ufbx_assert(mesh);
+	if (!mesh) return NULL;
+	return ufbxi_load_mesh_geometry(mesh, error);
+}
+
 ufbx_abi ufbx_scene *ufbx_load_file(const char *filename, const ufbx_load_opts *opts, ufbx_error *error)
 {
 	return ufbx_load_file_len(filename, SIZE_MAX, opts, error);
@@ -30518,12 +36502,37 @@ ufbx_abi ufbx_scene *ufbx_load_file(const char *filename, const ufbx_load_opts *
 ufbx_abi ufbx_scene *ufbx_load_file_len(const char *filename, size_t filename_len, const ufbx_load_opts *opts, ufbx_error *error)
 {
 	ufbxi_check_opts_ptr(ufbx_scene, opts, error);
-	ufbxi_context uc; // ufbxi_uninit
-	memset(&uc, 0, sizeof(ufbxi_context));
-	uc.deferred_load = true;
-	uc.load_filename = filename;
-	uc.load_filename_len = filename_len;
-	return ufbxi_load(&uc, opts, error);
+	return ufbxi_load_file_shared(filename, filename_len, opts, NULL, NULL, error);
+}
+
+ufbx_abi size_t ufbx_load_files(const char *const *filenames, size_t num_files, const ufbx_load_files_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_return(0, opts, error);
+	ufbx_load_files_opts zero_opts;
+	if (!opts) {
+		memset(&zero_opts, 0, sizeof(zero_opts));
+		opts = &zero_opts;
+	}
+	const ufbx_load_opts *load_opts = &opts->load_opts;
+	ufbxi_check_opts_return(0, load_opts, error);
+
+	ufbxi_batch batch; // ufbxi_uninit
+	memset(&batch, 0, sizeof(batch));
+	ufbxi_init_ator(&batch.error, &batch.ator, &load_opts->temp_allocator, "batch");
+
+	int ok = ufbxi_batch_init(&batch, filenames, num_files, opts);
+	if (ok) {
+		ufbxi_batch_work(&batch);
+	}
+	ufbxi_batch_free(&batch);
+
+	if (ok) {
+		ufbxi_clear_error(error);
+		return batch.num_loaded;
+	} else {
+		ufbxi_fix_error_type(&batch.error, "Failed to load files", error);
+		return 0;
+	}
 }
 
 ufbx_abi ufbx_scene *ufbx_load_stdio(void *file_void, const ufbx_load_opts *opts, ufbx_error *error)
@@ -30575,6 +36584,140 @@ ufbx_abi ufbx_scene *ufbx_load_stream_prefix(const ufbx_stream *stream, const vo
 	return scene;
 }
 
+ufbx_abi ufbx_loader *ufbx_load_begin(const ufbx_load_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_ptr(ufbx_loader, opts, error);
+
+	ufbx_error local_error = { UFBX_ERROR_NONE };
+	ufbxi_allocator ator; // ufbxi_uninit
+	memset(&ator, 0, sizeof(ator));
+	ufbxi_init_ator(&local_error, &ator, opts ? &opts->temp_allocator : NULL, "loader");
+
+	ufbx_loader *loader = ufbxi_alloc(&ator, ufbx_loader, 1);
+	if (!loader) {
+		ufbxi_fix_error_type(&local_error, "Failed to load", error);
+		ufbxi_free_ator(&ator);
+		return NULL;
+	}
+
+	memset(loader, 0, sizeof(ufbx_loader));
+	loader->magic = UFBXI_LOADER_MAGIC;
+	loader->ator = ator;
+	loader->ator.error = NULL;
+
+	ufbxi_context *uc = &loader->uc;
+	uc->read_fn = &ufbxi_loader_read;
+	uc->close_fn = &ufbxi_loader_close;
+	uc->read_user = loader;
+	uc->feeding = true;
+	uc->feed_top_index = SIZE_MAX;
+	ufbxi_begin_load(uc, opts, &loader->inflate_retain);
+	ufbxi_enter_phase(uc, UFBX_LOAD_PHASE_IO);
+
+	ufbxi_clear_error(error);
+	return loader;
+}
+
+ufbx_abi bool ufbx_load_feed(ufbx_loader *loader, const void *data, size_t data_size, ufbx_error *error)
+{
+	ufbx_assert(loader && loader->magic == UFBXI_LOADER_MAGIC);
+	if (!loader || loader->magic != UFBXI_LOADER_MAGIC) return false;
+
+	ufbxi_context *uc = &loader->uc;
+	if (!loader->failed && data_size > 0) {
+		loader->failed = !ufbxi_loader_feed(loader, data, data_size);
+	}
+
+	if (loader->failed) {
+		ufbxi_fix_error_type(&uc->error, "Failed to load", error);
+		return false;
+	}
+
+	ufbxi_clear_error(error);
+	return true;
+}
+
+ufbx_abi ufbx_scene *ufbx_load_finish(ufbx_loader *loader, ufbx_error *error)
+{
+	ufbx_assert(loader && loader->magic == UFBXI_LOADER_MAGIC);
+	if (!loader || loader->magic != UFBXI_LOADER_MAGIC) return NULL;
+
+	// All data is available from now on, running out of it means the file is truncated
+	ufbxi_context *uc = &loader->uc;
+	uc->feeding = false;
+
+	int ok = !loader->failed && ufbxi_feed_imp(uc) && ufbxi_load_imp(uc);
+	ufbx_scene *scene = ufbxi_end_load(uc, ok, error);
+	ufbxi_free_loader(loader);
+	return scene;
+}
+
+ufbx_abi void ufbx_free_loader(ufbx_loader *loader)
+{
+	if (!loader) return;
+	ufbx_assert(loader->magic == UFBXI_LOADER_MAGIC);
+	if (loader->magic != UFBXI_LOADER_MAGIC) return;
+
+	ufbxi_end_load(&loader->uc, 0, NULL);
+	ufbxi_free_loader(loader);
+}
+
+ufbx_abi ufbx_probe_info *ufbx_probe_memory(const void *data, size_t size, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_ptr(ufbx_probe_info, opts, error);
+	ufbxi_context uc; // ufbxi_uninit
+	memset(&uc, 0, sizeof(ufbxi_context));
+	uc.probe = true;
+	uc.data_begin = uc.data = (const char *)data;
+	uc.data_size = size;
+	uc.progress_bytes_total = size;
+	ufbxi_ignore(ufbxi_load(&uc, opts, error));
+	return uc.probe_imp ? &uc.probe_imp->info : NULL;
+}
+
+ufbx_abi ufbx_probe_info *ufbx_probe_file(const char *filename, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	return ufbx_probe_file_len(filename, SIZE_MAX, opts, error);
+}
+
+ufbx_abi ufbx_probe_info *ufbx_probe_file_len(const char *filename, size_t filename_len, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_ptr(ufbx_probe_info, opts, error);
+	ufbxi_context uc; // ufbxi_uninit
+	memset(&uc, 0, sizeof(ufbxi_context));
+	uc.probe = true;
+	uc.deferred_load = true;
+	uc.load_filename = filename;
+	uc.load_filename_len = filename_len;
+	ufbxi_ignore(ufbxi_load(&uc, opts, error));
+	return uc.probe_imp ? &uc.probe_imp->info : NULL;
+}
+
+ufbx_abi ufbx_probe_info *ufbx_probe_stream(const ufbx_stream *stream, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_ptr(ufbx_probe_info, opts, error);
+	ufbxi_context uc; // ufbxi_uninit
+	memset(&uc, 0, sizeof(ufbxi_context));
+	uc.probe = true;
+	uc.read_fn = stream->read_fn;
+	uc.skip_fn = stream->skip_fn;
+	uc.size_fn = stream->size_fn;
+	uc.close_fn = stream->close_fn;
+	uc.read_user = stream->user;
+	ufbxi_ignore(ufbxi_load(&uc, opts, error));
+	return uc.probe_imp ? &uc.probe_imp->info : NULL;
+}
+
+ufbx_abi void ufbx_free_probe_info(ufbx_probe_info *info)
+{
+	if (!info) return;
+
+	ufbxi_probe_imp *imp = ufbxi_get_imp(ufbxi_probe_imp, info);
+	ufbx_assert(imp->magic == UFBXI_PROBE_IMP_MAGIC);
+	if (imp->magic != UFBXI_PROBE_IMP_MAGIC) return;
+	ufbxi_release_ref(&imp->refcount);
+}
+
 ufbx_abi void ufbx_free_scene(ufbx_scene *scene)
 {
 	if (!scene) return;
@@ -30595,6 +36738,97 @@ ufbx_abi void ufbx_retain_scene(ufbx_scene *scene)
 	ufbxi_retain_ref(&imp->refcount);
 }
 
+ufbx_abi bool ufbx_save_scene_snapshot(const ufbx_scene *scene, const char *filename, ufbx_error *error)
+{
+	return ufbx_save_scene_snapshot_len(scene, filename, SIZE_MAX, error);
+}
+
+ufbx_abi bool ufbx_save_scene_snapshot_len(const ufbx_scene *scene, const char *filename, size_t filename_len, ufbx_error *error)
+{
+	ufbx_assert(scene);
+	ufbxi_save_snapshot_context sc; // ufbxi_uninit
+	ufbxi_begin_save_snapshot(&sc, scene);
+	if (filename_len == SIZE_MAX) filename_len = strlen(filename);
+
+#if !defined(UFBX_NO_STDIO) && !defined(UFBX_EXTERNAL_STDIO)
+	bool ok = ufbxi_snapshot_layout(&sc) != 0;
+	if (ok) {
+		ufbxi_file_context fc; // ufbxi_uninit
+		ufbxi_begin_file_context(&fc, (ufbx_open_file_context)&sc.ator_tmp, NULL);
+		FILE *file = ufbxi_fopen(&fc, filename, filename_len, false, true);
+		if (!file) sc.error = fc.error;
+		ufbxi_end_file_context(&fc, NULL, file != NULL);
+
+		if (file) {
+			sc.write_fn = &ufbxi_snapshot_file_write;
+			sc.write_user = file;
+			ok = ufbxi_save_snapshot_imp(&sc) != 0;
+			if (fclose(file) != 0 && ok) {
+				ufbxi_set_err_info(&sc.error, filename, filename_len);
+				ufbxi_report_err_msg(&sc.error, "fclose()", "IO error");
+				ok = false;
+			}
+		} else {
+			ok = false;
+		}
+	}
+#else
+	(void)filename;
+	(void)filename_len;
+	ufbxi_fmt_err_info(&sc.error, "UFBX_NO_STDIO");
+	ufbxi_report_err_msg(&sc.error, "UFBX_NO_STDIO", "Feature disabled");
+	bool ok = false;
+#endif
+
+	return ufbxi_end_save_snapshot(&sc, error, ok);
+}
+
+ufbx_abi size_t ufbx_save_scene_snapshot_to_memory(const ufbx_scene *scene, void *dst, size_t dst_size, ufbx_error *error)
+{
+	ufbx_assert(scene);
+	ufbxi_save_snapshot_context sc; // ufbxi_uninit
+	ufbxi_begin_save_snapshot(&sc, scene);
+
+	size_t size = 0;
+	bool ok = ufbxi_snapshot_layout(&sc) != 0;
+	if (ok) {
+		size = ufbxi_snapshot_size(&sc);
+		if (dst && size <= dst_size) {
+			ufbxi_snapshot_memory_writer writer = { (char*)dst, 0 };
+			sc.write_fn = &ufbxi_snapshot_memory_write;
+			sc.write_user = &writer;
+			ok = ufbxi_save_snapshot_imp(&sc) != 0;
+			ufbx_assert(!ok || writer.pos == size);
+		}
+	}
+
+	ok = ufbxi_end_save_snapshot(&sc, error, ok);
+	return ok ? size : 0;
+}
+
+ufbx_abi ufbx_scene *ufbx_load_scene_snapshot(const char *filename, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	return ufbx_load_scene_snapshot_len(filename, SIZE_MAX, opts, error);
+}
+
+ufbx_abi ufbx_scene *ufbx_load_scene_snapshot_len(const char *filename, size_t filename_len, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_ptr(ufbx_scene, opts, error);
+	ufbxi_load_snapshot_context lc; // ufbxi_uninit
+	memset(&lc, 0, sizeof(ufbxi_load_snapshot_context));
+	return ufbxi_load_snapshot(&lc, filename, filename_len, opts, error);
+}
+
+ufbx_abi ufbx_scene *ufbx_load_scene_snapshot_memory(const void *data, size_t data_size, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	ufbxi_check_opts_ptr(ufbx_scene, opts, error);
+	ufbxi_load_snapshot_context lc; // ufbxi_uninit
+	memset(&lc, 0, sizeof(ufbxi_load_snapshot_context));
+	lc.data = (const char*)data;
+	lc.data_size = data_size;
+	return ufbxi_load_snapshot(&lc, NULL, 0, opts, error);
+}
+
 ufbx_abi ufbxi_noinline size_t ufbx_format_error(char *dst, size_t dst_size, const ufbx_error *error)
 {
 	if (!dst || !dst_size) return 0;
@@ -30782,7 +37016,7 @@ ufbx_abi ufbx_anim_prop *ufbx_find_anim_prop_len(const ufbx_anim_layer *layer, c
 
 	size_t index = SIZE_MAX;
 	ufbxi_macro_lower_bound_eq(ufbx_anim_prop, 16, &index, layer->anim_props.data, 0, layer->anim_props.count,
-		( a->element != element ? a->element < element : ufbxi_str_less(a->prop_name, prop_str) ),
+		( a->element != element ? a->element->element_id < element->element_id : ufbxi_str_less(a->prop_name, prop_str) ),
 		( a->element == element && ufbxi_str_equal(a->prop_name, prop_str) ));
 
 	if (index == SIZE_MAX) return NULL;
@@ -30798,7 +37032,7 @@ ufbx_abi ufbxi_noinline ufbx_anim_prop_list ufbx_find_anim_props(const ufbx_anim
 
 	size_t begin = layer->anim_props.count, end = begin;
 	ufbxi_macro_lower_bound_eq(ufbx_anim_prop, 16, &begin, layer->anim_props.data, 0, layer->anim_props.count,
-		( a->element < element ), ( a->element == element ));
+		( a->element->element_id < element->element_id ), ( a->element == element ));
 
 	ufbxi_macro_upper_bound_eq(ufbx_anim_prop, 16, &end, layer->anim_props.data, begin, layer->anim_props.count,
 		( a->element == element ));
@@ -32032,11 +38266,30 @@ ufbx_abi ufbxi_noinline uint32_t ufbx_get_blend_shape_offset_index(const ufbx_bl
 	return (uint32_t)index;
 }
 
+// Read a blend shape offset, also handles `ufbx_load_opts.float_geometry`.
+static ufbxi_forceinline ufbx_vec3 ufbxi_get_blend_shape_offset(const ufbx_blend_shape *shape, size_t index)
+{
+	if (shape->position_offsets.count > 0) return shape->position_offsets.data[index];
+
+	const float *src = shape->position_offsets_float.data + index * 3;
+	ufbx_vec3 v;
+	v.x = (ufbx_real)src[0];
+	v.y = (ufbx_real)src[1];
+	v.z = (ufbx_real)src[2];
+	return v;
+}
+
+static ufbxi_forceinline size_t ufbxi_num_blend_shape_offsets(const ufbx_blend_shape *shape)
+{
+	size_t count = shape->position_offsets.count > 0 ? shape->position_offsets.count : shape->position_offsets_float.count / 3;
+	return ufbxi_min_sz(shape->num_offsets, count);
+}
+
 ufbx_abi ufbxi_noinline ufbx_vec3 ufbx_get_blend_shape_vertex_offset(const ufbx_blend_shape *shape, size_t vertex)
 {
 	uint32_t index = ufbx_get_blend_shape_offset_index(shape, vertex);
-	if (index == UFBX_NO_INDEX) return ufbx_zero_vec3;
-	return shape->position_offsets.data[index];
+	if (index >= ufbxi_num_blend_shape_offsets(shape)) return ufbx_zero_vec3;
+	return ufbxi_get_blend_shape_offset(shape, index);
 }
 
 ufbx_abi ufbxi_noinline ufbx_vec3 ufbx_get_blend_vertex_offset(const ufbx_blend_deformer *blend, size_t vertex)
@@ -32064,9 +38317,8 @@ ufbx_abi void ufbx_add_blend_shape_vertex_offsets(const ufbx_blend_shape *shape,
 	if (weight == 0.0f) return;
 	if (!vertices) return;
 
-	size_t num_offsets = shape->num_offsets;
+	size_t num_offsets = ufbxi_num_blend_shape_offsets(shape);
 	uint32_t *vertex_indices = shape->offset_vertices.data;
-	ufbx_vec3 *offsets = shape->position_offsets.data;
 	ufbx_real_list weights = shape->offset_weights;
 	for (size_t i = 0; i < num_offsets; i++) {
 		uint32_t index = vertex_indices[i];
@@ -32075,7 +38327,7 @@ ufbx_abi void ufbx_add_blend_shape_vertex_offsets(const ufbx_blend_shape *shape,
 			if (i < weights.count) {
 				vertex_weight *= weights.data[i];
 			}
-			ufbxi_add_weighted_vec3(&vertices[index], offsets[i], vertex_weight);
+			ufbxi_add_weighted_vec3(&vertices[index], ufbxi_get_blend_shape_offset(shape, i), vertex_weight);
 		}
 	}
 }
@@ -32411,10 +38663,10 @@ ufbx_abi ufbxi_noinline uint32_t ufbx_catch_triangulate_face(ufbx_panic *panic,
 		uint32_t i1 = face.index_begin + 1;
 		uint32_t i2 = face.index_begin + 2;
 		uint32_t i3 = face.index_begin + 3;
-		ufbx_vec3 v0 = mesh->vertex_position.values.data[mesh->vertex_position.indices.data[i0]];
-		ufbx_vec3 v1 = mesh->vertex_position.values.data[mesh->vertex_position.indices.data[i1]];
-		ufbx_vec3 v2 = mesh->vertex_position.values.data[mesh->vertex_position.indices.data[i2]];
-		ufbx_vec3 v3 = mesh->vertex_position.values.data[mesh->vertex_position.indices.data[i3]];
+		ufbx_vec3 v0 = ufbxi_get_vertex_position(&mesh->vertex_position, i0);
+		ufbx_vec3 v1 = ufbxi_get_vertex_position(&mesh->vertex_position, i1);
+		ufbx_vec3 v2 = ufbxi_get_vertex_position(&mesh->vertex_position, i2);
+		ufbx_vec3 v3 = ufbxi_get_vertex_position(&mesh->vertex_position, i3);
 
 		ufbx_vec3 a = ufbxi_sub3(v2, v0);
 		ufbx_vec3 b = ufbxi_sub3(v3, v1);
@@ -32506,23 +38758,23 @@ ufbx_abi ufbxi_noinline ufbx_vec3 ufbx_catch_get_weighted_face_normal(ufbx_panic
 	if (face.num_indices < 3) {
 		return ufbx_zero_vec3;
 	} else if (face.num_indices == 3) {
-		ufbx_vec3 a = ufbx_get_vertex_vec3(positions, face.index_begin + 0);
-		ufbx_vec3 b = ufbx_get_vertex_vec3(positions, face.index_begin + 1);
-		ufbx_vec3 c = ufbx_get_vertex_vec3(positions, face.index_begin + 2);
+		ufbx_vec3 a = ufbxi_get_vertex_position(positions, face.index_begin + 0);
+		ufbx_vec3 b = ufbxi_get_vertex_position(positions, face.index_begin + 1);
+		ufbx_vec3 c = ufbxi_get_vertex_position(positions, face.index_begin + 2);
 		return ufbxi_cross3(ufbxi_sub3(b, a), ufbxi_sub3(c, a));
 	} else if (face.num_indices == 4) {
-		ufbx_vec3 a = ufbx_get_vertex_vec3(positions, face.index_begin + 0);
-		ufbx_vec3 b = ufbx_get_vertex_vec3(positions, face.index_begin + 1);
-		ufbx_vec3 c = ufbx_get_vertex_vec3(positions, face.index_begin + 2);
-		ufbx_vec3 d = ufbx_get_vertex_vec3(positions, face.index_begin + 3);
+		ufbx_vec3 a = ufbxi_get_vertex_position(positions, face.index_begin + 0);
+		ufbx_vec3 b = ufbxi_get_vertex_position(positions, face.index_begin + 1);
+		ufbx_vec3 c = ufbxi_get_vertex_position(positions, face.index_begin + 2);
+		ufbx_vec3 d = ufbxi_get_vertex_position(positions, face.index_begin + 3);
 		return ufbxi_cross3(ufbxi_sub3(c, a), ufbxi_sub3(d, b));
 	} else {
 		// Newell's Method
 		ufbx_vec3 result = ufbx_zero_vec3;
 		for (size_t i = 0; i < face.num_indices; i++) {
 			size_t next = i + 1 < face.num_indices ? i + 1 : 0;
-			ufbx_vec3 a = ufbx_get_vertex_vec3(positions, face.index_begin + i);
-			ufbx_vec3 b = ufbx_get_vertex_vec3(positions, face.index_begin + next);
+			ufbx_vec3 a = ufbxi_get_vertex_position(positions, face.index_begin + i);
+			ufbx_vec3 b = ufbxi_get_vertex_position(positions, face.index_begin + next);
 			result.x += (a.y - b.y) * (a.z + b.z);
 			result.y += (a.z - b.z) * (a.x + b.x);
 			result.z += (a.x - b.x) * (a.y + b.y);
@@ -32627,7 +38879,7 @@ ufbx_abi ufbx_mesh *ufbx_subdivide_mesh(const ufbx_mesh *mesh, size_t level, con
 ufbx_abi void ufbx_free_mesh(ufbx_mesh *mesh)
 {
 	if (!mesh) return;
-	if (!mesh->subdivision_evaluated && !mesh->from_tessellated_nurbs) return;
+	if (!mesh->subdivision_evaluated && !mesh->from_tessellated_nurbs && !mesh->from_lazy_geometry) return;
 
 	ufbxi_mesh_imp *imp = ufbxi_get_imp(ufbxi_mesh_imp, mesh);
 	ufbx_assert(imp->magic == UFBXI_MESH_IMP_MAGIC);
@@ -32638,7 +38890,7 @@ ufbx_abi void ufbx_free_mesh(ufbx_mesh *mesh)
 ufbx_abi void ufbx_retain_mesh(ufbx_mesh *mesh)
 {
 	if (!mesh) return;
-	if (!mesh->subdivision_evaluated && !mesh->from_tessellated_nurbs) return;
+	if (!mesh->subdivision_evaluated && !mesh->from_tessellated_nurbs && !mesh->from_lazy_geometry) return;
 
 	ufbxi_mesh_imp *imp = ufbxi_get_imp(ufbxi_mesh_imp, mesh);
 	ufbx_assert(imp->magic == UFBXI_MESH_IMP_MAGIC);
@@ -32646,6 +38898,65 @@ ufbx_abi void ufbx_retain_mesh(ufbx_mesh *mesh)
 	ufbxi_retain_ref(&imp->refcount);
 }
 
+ufbx_abi ufbx_packed_mesh *ufbx_pack_mesh(const ufbx_mesh *mesh, const ufbx_mesh_part *part, const ufbx_pack_mesh_opts *opts, ufbx_error *error)
+{
+#if UFBXI_FEATURE_TRIANGULATION && UFBXI_FEATURE_INDEX_GENERATION
+	ufbxi_check_opts_ptr(ufbx_packed_mesh, opts, error);
+	ufbx_assert(mesh);
+	if (!mesh) return NULL;
+
+	ufbxi_pack_context pc = { UFBX_ERROR_NONE };
+	if (opts) {
+		pc.opts = *opts;
+	}
+
+	pc.mesh = mesh;
+	pc.part = part;
+
+	int ok = ufbxi_pack_mesh_imp(&pc);
+
+	ufbxi_buf_free(&pc.tmp);
+	ufbxi_free_ator(&pc.ator_tmp);
+
+	if (ok) {
+		ufbxi_clear_error(error);
+		ufbxi_packed_mesh_imp *imp = pc.imp;
+		return &imp->packed;
+	} else {
+		ufbxi_fix_error_type(&pc.error, "Failed to pack mesh", error);
+		ufbxi_buf_free(&pc.result);
+		ufbxi_free_ator(&pc.ator_result);
+		return NULL;
+	}
+#else
+	if (error) {
+		memset(error, 0, sizeof(ufbx_error));
+		ufbxi_report_err_msg(error, "UFBXI_FEATURE_TRIANGULATION && UFBXI_FEATURE_INDEX_GENERATION", "Feature disabled");
+	}
+	return NULL;
+#endif
+}
+
+ufbx_abi void ufbx_free_packed_mesh(ufbx_packed_mesh *packed)
+{
+	if (!packed) return;
+
+	ufbxi_packed_mesh_imp *imp = ufbxi_get_imp(ufbxi_packed_mesh_imp, packed);
+	ufbx_assert(imp->magic == UFBXI_PACKED_MESH_IMP_MAGIC);
+	if (imp->magic != UFBXI_PACKED_MESH_IMP_MAGIC) return;
+	ufbxi_release_ref(&imp->refcount);
+}
+
+ufbx_abi void ufbx_retain_packed_mesh(ufbx_packed_mesh *packed)
+{
+	if (!packed) return;
+
+	ufbxi_packed_mesh_imp *imp = ufbxi_get_imp(ufbxi_packed_mesh_imp, packed);
+	ufbx_assert(imp->magic == UFBXI_PACKED_MESH_IMP_MAGIC);
+	if (imp->magic != UFBXI_PACKED_MESH_IMP_MAGIC) return;
+	ufbxi_retain_ref(&imp->refcount);
+}
+
 ufbx_abi ufbx_geometry_cache *ufbx_load_geometry_cache(
 	const char *filename,
 	const ufbx_geometry_cache_opts *opts, ufbx_error *error)
@@ -32685,33 +38996,11 @@ ufbx_abi void ufbx_retain_geometry_cache(ufbx_geometry_cache *cache)
 	ufbxi_retain_ref(&imp->refcount);
 }
 
-typedef struct {
-	union {
-		double f64[UFBXI_GEOMETRY_CACHE_BUFFER_SIZE];
-		float f32[UFBXI_GEOMETRY_CACHE_BUFFER_SIZE];
-	} src;
-	ufbx_real dst[UFBXI_GEOMETRY_CACHE_BUFFER_SIZE];
-} ufbxi_geometry_cache_buffer;
-
-ufbx_abi ufbxi_noinline size_t ufbx_read_geometry_cache_real(const ufbx_cache_frame *frame, ufbx_real *data, size_t count, const ufbx_geometry_cache_data_opts *user_opts)
-{
 #if UFBXI_FEATURE_GEOMETRY_CACHE
-	ufbxi_check_opts_return_no_error(0, user_opts);
-	if (!frame || count == 0) return 0;
-	ufbx_assert(data);
-	if (!data) return 0;
-
-	ufbx_geometry_cache_data_opts opts; // ufbxi_uninit
-	if (user_opts) {
-		opts = *user_opts;
-	} else {
-		memset(&opts, 0, sizeof(opts));
-	}
-
-	if (!opts.open_file_cb.fn) {
-		opts.open_file_cb.fn = ufbx_default_open_file;
-	}
 
+// Returns the number of values stored in `frame`, zero if the data cannot be decoded.
+static ufbxi_noinline size_t ufbxi_cache_frame_values(const ufbx_cache_frame *frame, bool *p_use_double, bool *p_swap)
+{
 	bool use_double = false;
 
 	size_t src_count = 0;
@@ -32742,27 +39031,95 @@ ufbx_abi ufbxi_noinline size_t ufbx_read_geometry_cache_real(const ufbx_cache_fr
 		dst_big_endian = buf[0] == 0xbb;
 	}
 
-	if (src_count == 0) return 0;
-	src_count = ufbxi_min_sz(src_count, count);
+	*p_use_double = use_double;
+	*p_swap = src_big_endian != dst_big_endian;
+	return src_count;
+}
 
-	ufbx_stream stream = { 0 };
-	if (!ufbxi_open_file(&opts.open_file_cb, &stream, frame->filename.data, frame->filename.length, NULL, NULL, UFBX_OPEN_FILE_GEOMETRY_CACHE)) {
-		return 0;
+// Decode `count` raw `float` or `double` values from `src` to `dst`.
+static ufbxi_noinline void ufbxi_decode_cache_values(ufbx_real *dst, const void *src, size_t count, bool use_double, bool swap)
+{
+	union {
+		double f64[UFBXI_GEOMETRY_CACHE_BUFFER_SIZE];
+		float f32[UFBXI_GEOMETRY_CACHE_BUFFER_SIZE];
+	} buffer; // ufbxi_uninit
+
+	size_t elem_size = use_double ? sizeof(double) : sizeof(float);
+	const char *src_data = (const char*)src;
+	while (count > 0) {
+		size_t num = ufbxi_min_sz(count, UFBXI_GEOMETRY_CACHE_BUFFER_SIZE);
+		if (swap) {
+			ufbxi_swap_endian_to(&buffer, src_data, num, elem_size);
+		} else {
+			memcpy(&buffer, src_data, num * elem_size);
+		}
+		if (use_double) {
+			ufbxi_nounroll for (size_t i = 0; i < num; i++) {
+				dst[i] = (ufbx_real)buffer.f64[i];
+			}
+		} else {
+			ufbxi_nounroll for (size_t i = 0; i < num; i++) {
+				dst[i] = (ufbx_real)buffer.f32[i];
+			}
+		}
+		src_data += num * elem_size;
+		dst += num;
+		count -= num;
+	}
+}
+
+// Write or accumulate decoded values to `dst` applying the transform of `frame` and
+// the weight in `opts`, `first_index` is the index of `src[0]` within the frame.
+static ufbxi_noinline void ufbxi_blend_cache_values(ufbx_real *dst, const ufbx_real *src, size_t count, size_t first_index, const ufbx_cache_frame *frame, const ufbx_geometry_cache_data_opts *opts)
+{
+	ufbx_real weight = opts->use_weight ? opts->weight : 1.0f;
+	ufbx_real scale = 1.0f;
+
+	// Mirroring is folded into the weights, negation is exact so this is equal to
+	// scaling, mirroring and weighting the values in separate passes.
+	ufbx_real weights[3]; // ufbxi_uninit
+	weights[0] = weights[1] = weights[2] = weight;
+	if (!opts->ignore_transform) {
+		scale = frame->scale_factor;
+		if (frame->mirror_axis) {
+			weights[(size_t)frame->mirror_axis - 1] = -weight;
+		}
+	}
+
+	size_t axis = first_index % 3;
+	if (opts->additive) {
+		ufbxi_nounroll for (size_t i = 0; i < count; i++) {
+			dst[i] += (src[i] * scale) * weights[axis];
+			if (++axis == 3) axis = 0;
+		}
+	} else {
+		ufbxi_nounroll for (size_t i = 0; i < count; i++) {
+			dst[i] = (src[i] * scale) * weights[axis];
+			if (++axis == 3) axis = 0;
+		}
+	}
+}
+
+// Open the file containing `frame` and skip to the beginning of its data.
+static ufbxi_noinline bool ufbxi_open_cache_frame(const ufbx_open_file_cb *cb, ufbx_stream *stream, const ufbx_cache_frame *frame)
+{
+	if (!ufbxi_open_file(cb, stream, frame->filename.data, frame->filename.length, NULL, NULL, UFBX_OPEN_FILE_GEOMETRY_CACHE)) {
+		return false;
 	}
 
 	// Skip to the correct point in the file
 	uint64_t offset = frame->data_offset;
-	if (stream.skip_fn) {
+	if (stream->skip_fn) {
 		while (offset > 0) {
 			size_t to_skip = (size_t)ufbxi_min64(offset, UFBXI_MAX_SKIP_SIZE);
-			if (!stream.skip_fn(stream.user, to_skip)) break;
+			if (!stream->skip_fn(stream->user, to_skip)) break;
 			offset -= to_skip;
 		}
 	} else {
 		char buffer[4096]; // ufbxi_uninit
 		while (offset > 0) {
 			size_t to_skip = (size_t)ufbxi_min64(offset, sizeof(buffer));
-			size_t num_read = stream.read_fn(stream.user, buffer, to_skip);
+			size_t num_read = stream->read_fn(stream->user, buffer, to_skip);
 			if (num_read != to_skip) break;
 			offset -= to_skip;
 		}
@@ -32770,81 +39127,524 @@ ufbx_abi ufbxi_noinline size_t ufbx_read_geometry_cache_real(const ufbx_cache_fr
 
 	// Failed to skip all the way
 	if (offset > 0) {
-		if (stream.close_fn) {
-			stream.close_fn(stream.user);
+		if (stream->close_fn) {
+			stream->close_fn(stream->user);
 		}
-		return 0;
+		return false;
 	}
 
-	ufbx_real *dst = data;
-	size_t mirror_ix = (size_t)frame->mirror_axis - 1;
-	ufbxi_geometry_cache_buffer buffer; // ufbxi_uninit
-	while (src_count > 0) {
-		size_t to_read = ufbxi_min_sz(src_count, UFBXI_GEOMETRY_CACHE_BUFFER_SIZE);
-		src_count -= to_read;
-		size_t num_read = 0;
-		if (use_double) {
-			size_t bytes_read = stream.read_fn(stream.user, buffer.src.f64, to_read * sizeof(double));
-			if (bytes_read == SIZE_MAX) bytes_read = 0;
-			num_read = bytes_read / sizeof(double);
-			if (src_big_endian != dst_big_endian) {
-				for (size_t i = 0; i < num_read; i++) {
-					char t, *v = (char*)&buffer.src.f64[i];
-					t = v[0]; v[0] = v[7]; v[7] = t;
-					t = v[1]; v[1] = v[6]; v[6] = t;
-					t = v[2]; v[2] = v[5]; v[5] = t;
-					t = v[3]; v[3] = v[4]; v[4] = t;
-				}
-			}
-			ufbxi_nounroll for (size_t i = 0; i < num_read; i++) {
-				buffer.dst[i] = (ufbx_real)buffer.src.f64[i];
-			}
-		} else {
-			size_t bytes_read = stream.read_fn(stream.user, buffer.src.f32, to_read * sizeof(float));
-			if (bytes_read == SIZE_MAX) bytes_read = 0;
-			num_read = bytes_read / sizeof(float);
-			if (src_big_endian != dst_big_endian) {
-				for (size_t i = 0; i < num_read; i++) {
-					char t, *v = (char*)&buffer.src.f32[i];
-					t = v[0]; v[0] = v[3]; v[3] = t;
-					t = v[1]; v[1] = v[2]; v[2] = t;
-				}
-			}
-			ufbxi_nounroll for (size_t i = 0; i < num_read; i++) {
-				buffer.dst[i] = (ufbx_real)buffer.src.f32[i];
-			}
+	return true;
+}
+
+// Read and decode up to `count` values from `stream`, returns the number of values read.
+static ufbxi_noinline size_t ufbxi_read_cache_values(ufbx_stream *stream, ufbx_real *dst, size_t count, bool use_double, bool swap)
+{
+	union {
+		double f64[UFBXI_GEOMETRY_CACHE_BUFFER_SIZE];
+		float f32[UFBXI_GEOMETRY_CACHE_BUFFER_SIZE];
+	} buffer; // ufbxi_uninit
+
+	size_t elem_size = use_double ? sizeof(double) : sizeof(float);
+	size_t num_total = 0;
+	while (num_total < count) {
+		size_t to_read = ufbxi_min_sz(count - num_total, UFBXI_GEOMETRY_CACHE_BUFFER_SIZE);
+		size_t bytes_read = stream->read_fn(stream->user, &buffer, to_read * elem_size);
+		if (bytes_read == SIZE_MAX) bytes_read = 0;
+		size_t num_read = bytes_read / elem_size;
+		ufbxi_decode_cache_values(dst + num_total, &buffer, num_read, use_double, swap);
+		num_total += num_read;
+		if (num_read != to_read) break;
+	}
+	return num_total;
+}
+
+// -- Geometry cache reader
+//
+// Keeps cache files open (memory mapped if using the default IO) and decoded frames
+// in a fixed size LRU cache. Frames are keyed by the file and the data layout instead
+// of the `ufbx_cache_frame` pointer so entries stay valid across reloaded caches.
+//
+// When sampling a channel forward in time the following frames are queued for a
+// prefetch thread that decodes them straight from the mapped files. Only the user
+// thread allocates, opens files or evicts entries, the prefetch thread only reads the
+// mapping and writes the preallocated `values` of entries it has claimed. Entry states
+// are protected by `mutex` while the thread is running.
+
+typedef enum {
+	UFBXI_CACHE_ENTRY_EMPTY,
+	UFBXI_CACHE_ENTRY_PENDING, // < Queued for the prefetch thread
+	UFBXI_CACHE_ENTRY_LOADING, // < Being decoded by the prefetch thread
+	UFBXI_CACHE_ENTRY_READY
+} ufbxi_cache_entry_state;
+
+typedef struct {
+	char *filename; // < NULL-terminated copy
+	size_t filename_len;
+	uint32_t hash;
+
+	// Mapped file contents, NULL if read through `open_file_cb` instead.
+	const void *map_data;
+	size_t map_size;
+
+	uint64_t stamp;
+	size_t num_entries; // < Number of entries referring to this file, only evicted at zero
+} ufbxi_cache_file;
+
+typedef struct {
+	ufbxi_cache_entry_state state;
+
+	// Key, data in the same file at the same offset with the same layout
+	ufbxi_cache_file *file;
+	uint64_t offset;
+	size_t num_src;
+	bool use_double;
+	bool swap;
+
+	uint64_t stamp;
+
+	// Decoded values without the frame transform applied
+	ufbx_real *values;
+	size_t values_cap;
+	size_t num_values;
+} ufbxi_cache_entry;
+
+typedef struct {
+	const ufbx_cache_channel *channel;
+	double time;
+	uint64_t stamp;
+} ufbxi_cache_channel_state;
+
+struct ufbx_cache_reader {
+	uint32_t magic;
+
+	ufbx_error error;
+	ufbxi_allocator ator;
+	ufbx_cache_reader_opts opts;
+	bool use_mmap;
+
+	ufbxi_cache_file **files;
+	size_t num_files;
+	size_t files_cap;
+
+	ufbxi_cache_entry *entries;
+	size_t num_entries;
+
+	uint64_t stamp;
+
+	// Entries used during the current sample have `stamp >= sample_stamp` and
+	// are not evicted for prefetching.
+	uint64_t sample_stamp;
+
+	// Last sampled times of recently used channels to detect forward playback.
+	ufbxi_cache_channel_state channels[UFBXI_CACHE_READER_CHANNELS];
+
+	bool prefetch;
+
+#if UFBXI_HAS_PTHREADS
+	pthread_mutex_t mutex;
+	pthread_cond_t work_cond;
+	pthread_cond_t done_cond;
+	pthread_t thread;
+	bool sync_initialized;
+	bool thread_running;
+	bool stop;
+#endif
+};
+
+static ufbxi_forceinline void ufbxi_cache_reader_lock(ufbx_cache_reader *reader)
+{
+#if UFBXI_HAS_PTHREADS
+	if (reader->thread_running) pthread_mutex_lock(&reader->mutex);
+#else
+	(void)reader;
+#endif
+}
+
+static ufbxi_forceinline void ufbxi_cache_reader_unlock(ufbx_cache_reader *reader)
+{
+#if UFBXI_HAS_PTHREADS
+	if (reader->thread_running) pthread_mutex_unlock(&reader->mutex);
+#else
+	(void)reader;
+#endif
+}
+
+static ufbxi_noinline void ufbxi_cache_entry_decode_mapped(ufbxi_cache_entry *entry)
+{
+	const ufbxi_cache_file *file = entry->file;
+	size_t elem_size = entry->use_double ? sizeof(double) : sizeof(float);
+	size_t num_values = 0;
+	if (entry->offset < file->map_size) {
+		size_t offset = (size_t)entry->offset;
+		num_values = ufbxi_min_sz(entry->num_src, (file->map_size - offset) / elem_size);
+		ufbxi_decode_cache_values(entry->values, (const char*)file->map_data + offset, num_values, entry->use_double, entry->swap);
+	}
+	entry->num_values = num_values;
+}
+
+static ufbxi_noinline bool ufbxi_cache_entry_read(ufbx_cache_reader *reader, ufbxi_cache_entry *entry, const ufbx_cache_frame *frame)
+{
+	if (entry->file->map_data) {
+		ufbxi_cache_entry_decode_mapped(entry);
+		return true;
+	}
+
+	ufbx_stream stream = { 0 };
+	if (!ufbxi_open_cache_frame(&reader->opts.open_file_cb, &stream, frame)) return false;
+	entry->num_values = ufbxi_read_cache_values(&stream, entry->values, entry->num_src, entry->use_double, entry->swap);
+	if (stream.close_fn) {
+		stream.close_fn(stream.user);
+	}
+	return true;
+}
+
+#if UFBXI_HAS_PTHREADS
+
+static void *ufbxi_cache_reader_thread(void *user)
+{
+	ufbx_cache_reader *reader = (ufbx_cache_reader*)user;
+
+	pthread_mutex_lock(&reader->mutex);
+	while (!reader->stop) {
+		// Decode pending entries in the order they were queued
+		ufbxi_cache_entry *entry = NULL;
+		for (size_t i = 0; i < reader->num_entries; i++) {
+			ufbxi_cache_entry *e = &reader->entries[i];
+			if (e->state != UFBXI_CACHE_ENTRY_PENDING) continue;
+			if (!entry || e->stamp < entry->stamp) entry = e;
+		}
+		if (!entry) {
+			pthread_cond_wait(&reader->work_cond, &reader->mutex);
+			continue;
 		}
 
-		if (!opts.ignore_transform) {
-			ufbx_real scale = frame->scale_factor;
-			if (scale != 1.0f) {
-				for (size_t i = 0; i < num_read; i++) {
-					buffer.dst[i] *= scale;
-				}
-			}
-			if (frame->mirror_axis) {
-				while (mirror_ix < num_read) {
-					buffer.dst[mirror_ix] = -buffer.dst[mirror_ix];
-					mirror_ix += 3;
-				}
-				mirror_ix -= num_read;
-			}
+		entry->state = UFBXI_CACHE_ENTRY_LOADING;
+		pthread_mutex_unlock(&reader->mutex);
+
+		ufbxi_cache_entry_decode_mapped(entry);
+
+		pthread_mutex_lock(&reader->mutex);
+		entry->state = UFBXI_CACHE_ENTRY_READY;
+		pthread_cond_broadcast(&reader->done_cond);
+	}
+	pthread_mutex_unlock(&reader->mutex);
+
+	return NULL;
+}
+
+#endif
+
+static ufbxi_noinline bool ufbxi_cache_reader_start_thread(ufbx_cache_reader *reader)
+{
+#if UFBXI_HAS_PTHREADS
+	if (reader->thread_running) return true;
+	if (pthread_create(&reader->thread, NULL, &ufbxi_cache_reader_thread, reader) != 0) {
+		reader->prefetch = false;
+		return false;
+	}
+	reader->thread_running = true;
+	return true;
+#else
+	(void)reader;
+	return false;
+#endif
+}
+
+static ufbxi_noinline void ufbxi_cache_reader_close_file(ufbx_cache_reader *reader, ufbxi_cache_file *file)
+{
+#if UFBXI_HAS_MMAP
+	if (file->map_data) {
+		ufbxi_mmap_close(file->map_data, file->map_size);
+	}
+#endif
+	ufbxi_free(&reader->ator, char, file->filename, file->filename_len + 1);
+	ufbxi_free(&reader->ator, ufbxi_cache_file, file, 1);
+}
+
+static ufbxi_noinline ufbxi_cache_file *ufbxi_cache_reader_find_file(ufbx_cache_reader *reader, ufbx_string filename)
+{
+	uint32_t hash = ufbxi_hash_string(filename.data, filename.length);
+
+	size_t victim_ix = SIZE_MAX;
+	for (size_t i = 0; i < reader->num_files; i++) {
+		ufbxi_cache_file *file = reader->files[i];
+		if (file->hash == hash && file->filename_len == filename.length && !memcmp(file->filename, filename.data, filename.length)) {
+			file->stamp = ++reader->stamp;
+			return file;
+		}
+		if (file->num_entries == 0 && (victim_ix == SIZE_MAX || file->stamp < reader->files[victim_ix]->stamp)) {
+			victim_ix = i;
 		}
+	}
 
-		if (dst) {
-			ufbx_real weight = opts.use_weight ? opts.weight : 1.0f;
-			if (opts.additive) {
-				ufbxi_nounroll for (size_t i = 0; i < num_read; i++) {
-					dst[i] += buffer.dst[i] * weight;
-				}
-			} else {
-				ufbxi_nounroll for (size_t i = 0; i < num_read; i++) {
-					dst[i] = buffer.dst[i] * weight;
-				}
+	// Close the least recently used file that has no cached frames, if all files
+	// are in use we may go over `max_files`.
+	if (reader->num_files >= reader->opts.max_files && victim_ix != SIZE_MAX) {
+		ufbxi_cache_reader_close_file(reader, reader->files[victim_ix]);
+		reader->files[victim_ix] = reader->files[--reader->num_files];
+	}
+
+	if (!ufbxi_grow_array(&reader->ator, &reader->files, &reader->files_cap, reader->num_files + 1)) return NULL;
+	ufbxi_cache_file *file = ufbxi_alloc(&reader->ator, ufbxi_cache_file, 1);
+	if (!file) return NULL;
+	memset(file, 0, sizeof(ufbxi_cache_file));
+
+	file->filename = ufbxi_alloc(&reader->ator, char, filename.length + 1);
+	if (!file->filename) {
+		ufbxi_free(&reader->ator, ufbxi_cache_file, file, 1);
+		return NULL;
+	}
+	memcpy(file->filename, filename.data, filename.length);
+	file->filename[filename.length] = '\0';
+	file->filename_len = filename.length;
+	file->hash = hash;
+	file->stamp = ++reader->stamp;
+
+#if UFBXI_HAS_MMAP
+	// Fall back to reading with `open_file_cb` if the file cannot be mapped.
+	if (reader->use_mmap && !ufbxi_mmap_open(&reader->ator, file->filename, file->filename_len, true, &file->map_data, &file->map_size)) {
+		file->map_data = NULL;
+		file->map_size = 0;
+	}
+#endif
+
+	reader->files[reader->num_files++] = file;
+	return file;
+}
+
+// Find the decoded entry for `frame` or read it, returns NULL on failure.
+// With `prefetch` the frame is queued for the prefetch thread if possible.
+static ufbxi_noinline ufbxi_cache_entry *ufbxi_cache_reader_fetch(ufbx_cache_reader *reader, const ufbx_cache_frame *frame, bool prefetch)
+{
+	bool use_double = false, swap = false;
+	size_t num_src = ufbxi_cache_frame_values(frame, &use_double, &swap);
+	if (num_src == 0) return NULL;
+
+	ufbxi_cache_file *file = ufbxi_cache_reader_find_file(reader, frame->filename);
+	if (!file) return NULL;
+	if (prefetch && !file->map_data) return NULL;
+
+	ufbxi_cache_entry *entry = NULL, *victim = NULL;
+
+	ufbxi_cache_reader_lock(reader);
+	for (size_t i = 0; i < reader->num_entries; i++) {
+		ufbxi_cache_entry *e = &reader->entries[i];
+		if (e->state != UFBXI_CACHE_ENTRY_EMPTY && e->file == file && e->offset == frame->data_offset
+			&& e->num_src == num_src && e->use_double == use_double && e->swap == swap) {
+			entry = e;
+			break;
+		}
+
+		// Prefetching may only replace idle entries not used by the current sample,
+		// reading the frame directly may also cancel pending prefetches.
+		bool evictable = false;
+		switch (e->state) {
+		case UFBXI_CACHE_ENTRY_EMPTY: evictable = true; break;
+		case UFBXI_CACHE_ENTRY_PENDING: evictable = !prefetch; break;
+		case UFBXI_CACHE_ENTRY_LOADING: evictable = false; break;
+		case UFBXI_CACHE_ENTRY_READY: evictable = !prefetch || e->stamp < reader->sample_stamp; break;
+		default: ufbxi_unreachable("Bad cache entry state"); break;
+		}
+		if (evictable && (!victim || e->stamp < victim->stamp)) {
+			victim = e;
+		}
+	}
+
+	if (entry) {
+		if (!prefetch) {
+			if (entry->state == UFBXI_CACHE_ENTRY_PENDING) {
+				// Not started yet, decode it ourselves
+				entry->state = UFBXI_CACHE_ENTRY_LOADING;
+				ufbxi_cache_reader_unlock(reader);
+				ufbxi_cache_entry_decode_mapped(entry);
+				ufbxi_cache_reader_lock(reader);
+				entry->state = UFBXI_CACHE_ENTRY_READY;
+			}
+#if UFBXI_HAS_PTHREADS
+			while (entry->state == UFBXI_CACHE_ENTRY_LOADING) {
+				pthread_cond_wait(&reader->done_cond, &reader->mutex);
 			}
-			dst += num_read;
+#endif
 		}
+		entry->stamp = ++reader->stamp;
+		ufbxi_cache_reader_unlock(reader);
+		return entry;
+	}
+
+	if (victim) {
+		victim->state = UFBXI_CACHE_ENTRY_EMPTY;
+		victim->stamp = 0;
+	}
+	ufbxi_cache_reader_unlock(reader);
+	if (!victim) return NULL;
+
+	if (victim->file) {
+		victim->file->num_entries--;
+		victim->file = NULL;
+	}
+
+	if (victim->values_cap < num_src) {
+		ufbxi_free(&reader->ator, ufbx_real, victim->values, victim->values_cap);
+		victim->values_cap = 0;
+		victim->values = ufbxi_alloc(&reader->ator, ufbx_real, num_src);
+		if (!victim->values) return NULL;
+		victim->values_cap = num_src;
+	}
+
+	victim->file = file;
+	victim->offset = frame->data_offset;
+	victim->num_src = num_src;
+	victim->use_double = use_double;
+	victim->swap = swap;
+	victim->num_values = 0;
+	file->num_entries++;
+
+	if (prefetch) {
+		if (!ufbxi_cache_reader_start_thread(reader)) {
+			file->num_entries--;
+			victim->file = NULL;
+			return NULL;
+		}
+#if UFBXI_HAS_PTHREADS
+		pthread_mutex_lock(&reader->mutex);
+		victim->stamp = ++reader->stamp;
+		victim->state = UFBXI_CACHE_ENTRY_PENDING;
+		pthread_cond_signal(&reader->work_cond);
+		pthread_mutex_unlock(&reader->mutex);
+#endif
+		return victim;
+	}
+
+	if (!ufbxi_cache_entry_read(reader, victim, frame)) {
+		file->num_entries--;
+		victim->file = NULL;
+		return NULL;
+	}
+
+	ufbxi_cache_reader_lock(reader);
+	victim->stamp = ++reader->stamp;
+	victim->state = UFBXI_CACHE_ENTRY_READY;
+	ufbxi_cache_reader_unlock(reader);
+	return victim;
+}
+
+// Queue the frames following `index` for prefetching if `channel` is sampled forward in time.
+static ufbxi_noinline void ufbxi_cache_reader_prefetch(ufbx_cache_reader *reader, const ufbx_cache_channel *channel, double time, size_t index)
+{
+	if (!reader->prefetch) return;
+
+	ufbxi_cache_channel_state *state = NULL, *victim = &reader->channels[0];
+	for (size_t i = 0; i < UFBXI_CACHE_READER_CHANNELS; i++) {
+		ufbxi_cache_channel_state *s = &reader->channels[i];
+		if (s->channel == channel) {
+			state = s;
+			break;
+		}
+		if (s->stamp < victim->stamp) victim = s;
+	}
+
+	bool forward = false;
+	if (state) {
+		forward = time > state->time;
+	} else {
+		state = victim;
+		state->channel = channel;
+	}
+	state->time = time;
+	state->stamp = ++reader->stamp;
+	if (!forward) return;
+
+	for (size_t i = 1; i <= reader->opts.prefetch_frames; i++) {
+		if (index + i >= channel->frames.count) break;
+		if (!reader->prefetch) break;
+		ufbxi_cache_reader_fetch(reader, &channel->frames.data[index + i], true);
+	}
+}
+
+static ufbxi_noinline void ufbxi_free_cache_reader(ufbx_cache_reader *reader)
+{
+#if UFBXI_HAS_PTHREADS
+	if (reader->thread_running) {
+		pthread_mutex_lock(&reader->mutex);
+		reader->stop = true;
+		pthread_cond_signal(&reader->work_cond);
+		pthread_mutex_unlock(&reader->mutex);
+		pthread_join(reader->thread, NULL);
+		reader->thread_running = false;
+	}
+	if (reader->sync_initialized) {
+		pthread_cond_destroy(&reader->done_cond);
+		pthread_cond_destroy(&reader->work_cond);
+		pthread_mutex_destroy(&reader->mutex);
+	}
+#endif
+
+	for (size_t i = 0; i < reader->num_entries; i++) {
+		ufbxi_cache_entry *entry = &reader->entries[i];
+		ufbxi_free(&reader->ator, ufbx_real, entry->values, entry->values_cap);
+	}
+	for (size_t i = 0; i < reader->num_files; i++) {
+		ufbxi_cache_reader_close_file(reader, reader->files[i]);
+	}
+	ufbxi_free(&reader->ator, ufbxi_cache_file*, reader->files, reader->files_cap);
+	ufbxi_free(&reader->ator, ufbxi_cache_entry, reader->entries, reader->num_entries);
+
+	ufbxi_allocator ator = reader->ator;
+	ufbxi_free(&ator, ufbx_cache_reader, reader, 1);
+	ufbxi_free_ator(&ator);
+}
+
+#endif
+
+ufbx_abi ufbxi_noinline size_t ufbx_read_geometry_cache_real(const ufbx_cache_frame *frame, ufbx_real *data, size_t count, const ufbx_geometry_cache_data_opts *user_opts)
+{
+#if UFBXI_FEATURE_GEOMETRY_CACHE
+	ufbxi_check_opts_return_no_error(0, user_opts);
+	if (!frame || count == 0) return 0;
+	ufbx_assert(data);
+	if (!data) return 0;
 
+	ufbx_geometry_cache_data_opts opts; // ufbxi_uninit
+	if (user_opts) {
+		opts = *user_opts;
+	} else {
+		memset(&opts, 0, sizeof(opts));
+	}
+
+	if (opts.reader) {
+		ufbx_cache_reader *reader = opts.reader;
+		ufbx_assert(reader->magic == UFBXI_CACHE_READER_MAGIC);
+		if (reader->magic != UFBXI_CACHE_READER_MAGIC) return 0;
+
+		ufbxi_cache_entry *entry = ufbxi_cache_reader_fetch(reader, frame, false);
+		if (!entry) return 0;
+
+		size_t num_values = ufbxi_min_sz(entry->num_values, count);
+		ufbxi_blend_cache_values(data, entry->values, num_values, 0, frame, &opts);
+		return num_values;
+	}
+
+	if (!opts.open_file_cb.fn) {
+		opts.open_file_cb.fn = ufbx_default_open_file;
+	}
+
+	bool use_double = false, swap = false;
+	size_t src_count = ufbxi_cache_frame_values(frame, &use_double, &swap);
+	if (src_count == 0) return 0;
+	src_count = ufbxi_min_sz(src_count, count);
+
+	ufbx_stream stream = { 0 };
+	if (!ufbxi_open_cache_frame(&opts.open_file_cb, &stream, frame)) {
+		return 0;
+	}
+
+	ufbx_real buffer[UFBXI_GEOMETRY_CACHE_BUFFER_SIZE]; // ufbxi_uninit
+	size_t num_total = 0;
+	while (num_total < src_count) {
+		size_t to_read = ufbxi_min_sz(src_count - num_total, UFBXI_GEOMETRY_CACHE_BUFFER_SIZE);
+		size_t num_read = ufbxi_read_cache_values(&stream, buffer, to_read, use_double, swap);
+		ufbxi_blend_cache_values(data + num_total, buffer, num_read, num_total, frame, &opts);
+		num_total += num_read;
 		if (num_read != to_read) break;
 	}
 
@@ -32852,7 +39652,7 @@ ufbx_abi ufbxi_noinline size_t ufbx_read_geometry_cache_real(const ufbx_cache_fr
 		stream.close_fn(stream.user);
 	}
 
-	return ufbxi_to_size(dst - data);
+	return num_total;
 #else
 	return 0;
 #endif
@@ -32874,6 +39674,13 @@ ufbx_abi ufbxi_noinline size_t ufbx_sample_geometry_cache_real(const ufbx_cache_
 		memset(&opts, 0, sizeof(opts));
 	}
 
+	ufbx_cache_reader *reader = opts.reader;
+	if (reader) {
+		ufbx_assert(reader->magic == UFBXI_CACHE_READER_MAGIC);
+		if (reader->magic != UFBXI_CACHE_READER_MAGIC) return 0;
+		reader->sample_stamp = reader->stamp + 1;
+	}
+
 	size_t begin = 0;
 	size_t end = channel->frames.count;
 	const ufbx_cache_frame *frames = channel->frames.data;
@@ -32889,42 +39696,47 @@ ufbx_abi ufbxi_noinline size_t ufbx_sample_geometry_cache_real(const ufbx_cache_
 	const double eps = 0.00000001;
 
 	end = channel->frames.count;
-	for (; begin < end; begin++) {
-		const ufbx_cache_frame *next = &frames[begin];
-		if (next->time < time) continue;
+	while (begin < end && frames[begin].time < time) {
+		begin++;
+	}
 
+	size_t result = 0;
+	if (begin == end) {
+		// Last frame
+		result = ufbx_read_geometry_cache_real(&frames[end - 1], data, count, &opts);
+	} else if (begin == 0) {
 		// First keyframe
-		if (begin == 0) {
-			return ufbx_read_geometry_cache_real(next, data, count, &opts);
-		}
-
+		result = ufbx_read_geometry_cache_real(&frames[0], data, count, &opts);
+	} else {
+		const ufbx_cache_frame *next = &frames[begin];
 		const ufbx_cache_frame *prev = next - 1;
 
 		// Snap to exact frames if near
 		if (ufbx_fabs(next->time - time) < eps) {
-			return ufbx_read_geometry_cache_real(next, data, count, &opts);
-		}
-		if (ufbx_fabs(prev->time - time) < eps) {
-			return ufbx_read_geometry_cache_real(prev, data, count, &opts);
-		}
+			result = ufbx_read_geometry_cache_real(next, data, count, &opts);
+		} else if (ufbx_fabs(prev->time - time) < eps) {
+			result = ufbx_read_geometry_cache_real(prev, data, count, &opts);
+		} else {
+			double rcp_delta = 1.0 / (next->time - prev->time);
+			double t = (time - prev->time) * rcp_delta;
 
-		double rcp_delta = 1.0 / (next->time - prev->time);
-		double t = (time - prev->time) * rcp_delta;
+			ufbx_real original_weight = opts.use_weight ? opts.weight : 1.0f;
 
-		ufbx_real original_weight = opts.use_weight ? opts.weight : 1.0f;
+			opts.use_weight = true;
+			opts.weight = (ufbx_real)(original_weight * (1.0 - t));
+			size_t num_prev = ufbx_read_geometry_cache_real(prev, data, count, &opts);
 
-		opts.use_weight = true;
-		opts.weight = (ufbx_real)(original_weight * (1.0 - t));
-		size_t num_prev = ufbx_read_geometry_cache_real(prev, data, count, &opts);
+			opts.additive = true;
+			opts.weight = (ufbx_real)(original_weight * t);
+			result = ufbx_read_geometry_cache_real(next, data, num_prev, &opts);
+		}
+	}
 
-		opts.additive = true;
-		opts.weight = (ufbx_real)(original_weight * t);
-		return ufbx_read_geometry_cache_real(next, data, num_prev, &opts);
+	if (reader) {
+		ufbxi_cache_reader_prefetch(reader, channel, time, begin);
 	}
 
-	// Last frame
-	const ufbx_cache_frame *last = &frames[end - 1];
-	return ufbx_read_geometry_cache_real(last, data, count, &opts);
+	return result;
 #else
 	return 0;
 #endif
@@ -32954,6 +39766,105 @@ ufbx_abi ufbxi_noinline size_t ufbx_sample_geometry_cache_vec3(const ufbx_cache_
 #endif
 }
 
+ufbx_abi ufbx_cache_reader *ufbx_create_cache_reader(const ufbx_cache_reader_opts *user_opts, ufbx_error *error)
+{
+#if UFBXI_FEATURE_GEOMETRY_CACHE
+	ufbxi_check_opts_ptr(ufbx_cache_reader, user_opts, error);
+
+	ufbx_cache_reader_opts opts; // ufbxi_uninit
+	if (user_opts) {
+		opts = *user_opts;
+	} else {
+		memset(&opts, 0, sizeof(opts));
+	}
+
+	if (opts.max_frames == 0) opts.max_frames = 16;
+	if (opts.max_files == 0) opts.max_files = 64;
+	if (opts.prefetch_frames == 0) opts.prefetch_frames = 2;
+
+	// Reading a blended sample needs one entry besides the one being prefetched,
+	// prefetching more than `max_frames - 2` would evict frames before using them.
+	opts.max_frames = ufbxi_max_sz(opts.max_frames, 2);
+	opts.prefetch_frames = ufbxi_min_sz(opts.prefetch_frames, opts.max_frames - 2);
+
+	if (!opts.open_file_cb.fn) {
+		opts.open_file_cb.fn = &ufbx_default_open_file;
+	}
+	bool default_io = opts.open_file_cb.fn == &ufbx_default_open_file;
+
+	ufbx_error local_error = { UFBX_ERROR_NONE };
+	ufbxi_allocator ator; // ufbxi_uninit
+	memset(&ator, 0, sizeof(ator));
+	ufbxi_init_ator(&local_error, &ator, &opts.allocator, "cache_reader");
+
+	ufbx_cache_reader *reader = ufbxi_alloc(&ator, ufbx_cache_reader, 1);
+	ufbxi_cache_entry *entries = reader ? ufbxi_alloc(&ator, ufbxi_cache_entry, opts.max_frames) : NULL;
+	if (!entries) {
+		ufbxi_free(&ator, ufbx_cache_reader, reader, 1);
+		ufbxi_fix_error_type(&local_error, "Failed to create cache reader", error);
+		ufbxi_free_ator(&ator);
+		return NULL;
+	}
+
+	memset(reader, 0, sizeof(ufbx_cache_reader));
+	memset(entries, 0, sizeof(ufbxi_cache_entry) * opts.max_frames);
+	reader->magic = UFBXI_CACHE_READER_MAGIC;
+	reader->ator = ator;
+	reader->ator.error = &reader->error;
+	reader->opts = opts;
+	reader->entries = entries;
+	reader->num_entries = opts.max_frames;
+
+	#if UFBXI_HAS_MMAP
+		reader->use_mmap = default_io;
+	#else
+		(void)default_io;
+	#endif
+
+	// The prefetch thread decodes directly from mapped files
+	#if UFBXI_HAS_PTHREADS && UFBXI_HAS_MMAP
+		if (default_io && !opts.no_prefetch && opts.prefetch_frames > 0) {
+			bool has_mutex = pthread_mutex_init(&reader->mutex, NULL) == 0;
+			bool has_work_cond = pthread_cond_init(&reader->work_cond, NULL) == 0;
+			bool has_done_cond = pthread_cond_init(&reader->done_cond, NULL) == 0;
+			if (has_mutex && has_work_cond && has_done_cond) {
+				reader->sync_initialized = true;
+				reader->prefetch = true;
+			} else {
+				if (has_done_cond) pthread_cond_destroy(&reader->done_cond);
+				if (has_work_cond) pthread_cond_destroy(&reader->work_cond);
+				if (has_mutex) pthread_mutex_destroy(&reader->mutex);
+			}
+		}
+	#endif
+
+	ufbxi_clear_error(error);
+	return reader;
+#else
+	(void)user_opts;
+	if (error) {
+		memset(error, 0, sizeof(ufbx_error));
+		ufbxi_fmt_err_info(error, "UFBX_ENABLE_GEOMETRY_CACHE");
+		ufbxi_report_err_msg(error, "UFBXI_FEATURE_GEOMETRY_CACHE", "Feature disabled");
+	}
+	return NULL;
+#endif
+}
+
+ufbx_abi void ufbx_free_cache_reader(ufbx_cache_reader *reader)
+{
+#if UFBXI_FEATURE_GEOMETRY_CACHE
+	if (!reader) return;
+	ufbx_assert(reader->magic == UFBXI_CACHE_READER_MAGIC);
+	if (reader->magic != UFBXI_CACHE_READER_MAGIC) return;
+	reader->magic = 0;
+
+	ufbxi_free_cache_reader(reader);
+#else
+	(void)reader;
+#endif
+}
+
 ufbx_abi ufbx_dom_node *ufbx_dom_find_len(const ufbx_dom_node *parent, const char *name, size_t name_len)
 {
 	ufbx_string ref = ufbxi_safe_string(name, name_len);
@@ -33031,6 +39942,32 @@ ufbx_abi ufbx_real ufbx_catch_get_vertex_w_vec3(ufbx_panic *panic, const ufbx_ve
 	return v->values_w.data[(int32_t)ix];
 }
 
+static const float ufbxi_zero_float4[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+ufbx_abi ufbxi_noinline const float *ufbx_catch_get_vertex_vec2_float(ufbx_panic *panic, const ufbx_vertex_vec2 *v, size_t index)
+{
+	if (ufbxi_panicf(panic, index < v->indices.count, "index (%zu) out of range (%zu)", index, v->indices.count)) return ufbxi_zero_float4;
+	uint32_t ix = v->indices.data[index];
+	if (ufbxi_panicf(panic, (size_t)ix < v->values_float.count / 2 || ix == UFBX_NO_INDEX, "Corrupted or missing vertex attribute (%u) at %zu", ix, index)) return ufbxi_zero_float4;
+	return v->values_float.data + (ptrdiff_t)(int32_t)ix * 2;
+}
+
+ufbx_abi ufbxi_noinline const float *ufbx_catch_get_vertex_vec3_float(ufbx_panic *panic, const ufbx_vertex_vec3 *v, size_t index)
+{
+	if (ufbxi_panicf(panic, index < v->indices.count, "index (%zu) out of range (%zu)", index, v->indices.count)) return ufbxi_zero_float4;
+	uint32_t ix = v->indices.data[index];
+	if (ufbxi_panicf(panic, (size_t)ix < v->values_float.count / 3 || ix == UFBX_NO_INDEX, "Corrupted or missing vertex attribute (%u) at %zu", ix, index)) return ufbxi_zero_float4;
+	return v->values_float.data + (ptrdiff_t)(int32_t)ix * 3;
+}
+
+ufbx_abi ufbxi_noinline const float *ufbx_catch_get_vertex_vec4_float(ufbx_panic *panic, const ufbx_vertex_vec4 *v, size_t index)
+{
+	if (ufbxi_panicf(panic, index < v->indices.count, "index (%zu) out of range (%zu)", index, v->indices.count)) return ufbxi_zero_float4;
+	uint32_t ix = v->indices.data[index];
+	if (ufbxi_panicf(panic, (size_t)ix < v->values_float.count / 4 || ix == UFBX_NO_INDEX, "Corrupted or missing vertex attribute (%u) at %zu", ix, index)) return ufbxi_zero_float4;
+	return v->values_float.data + (ptrdiff_t)(int32_t)ix * 4;
+}
+
 ufbx_abi ufbx_unknown *ufbx_as_unknown(const ufbx_element *element) { return element && element->type == UFBX_ELEMENT_UNKNOWN ? (ufbx_unknown*)element : NULL; }
 ufbx_abi ufbx_node *ufbx_as_node(const ufbx_element *element) { return element && element->type == UFBX_ELEMENT_NODE ? (ufbx_node*)element : NULL; }
 ufbx_abi ufbx_mesh *ufbx_as_mesh(const ufbx_element *element) { return element && element->type == UFBX_ELEMENT_MESH ? (ufbx_mesh*)element : NULL; }
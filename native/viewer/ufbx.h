@@ -1022,6 +1022,9 @@ typedef struct ufbx_vertex_attrib {
 	//   ufbx_mesh.vertex_bitangent / ufbx_uv_set.vertex_bitangent
 	// NOTE: This is not loaded by default, set `ufbx_load_opts.retain_vertex_attrib_w`.
 	ufbx_real_list values_w;
+	// Values converted to 32-bit floats, `value_reals` floats per value.
+	// NOTE: Only set with `ufbx_load_opts.float_geometry`, `values` is empty in that case.
+	ufbx_float_list values_float;
 } ufbx_vertex_attrib;
 
 // 1D vertex attribute, see `ufbx_vertex_attrib` for information
@@ -1032,6 +1035,7 @@ typedef struct ufbx_vertex_real {
 	size_t value_reals;
 	bool unique_per_vertex;
 	ufbx_real_list values_w;
+	ufbx_float_list values_float;
 
 	UFBX_VERTEX_ATTRIB_IMPL(ufbx_real)
 } ufbx_vertex_real;
@@ -1044,6 +1048,7 @@ typedef struct ufbx_vertex_vec2 {
 	size_t value_reals;
 	bool unique_per_vertex;
 	ufbx_real_list values_w;
+	ufbx_float_list values_float;
 
 	UFBX_VERTEX_ATTRIB_IMPL(ufbx_vec2)
 } ufbx_vertex_vec2;
@@ -1056,6 +1061,7 @@ typedef struct ufbx_vertex_vec3 {
 	size_t value_reals;
 	bool unique_per_vertex;
 	ufbx_real_list values_w;
+	ufbx_float_list values_float;
 
 	UFBX_VERTEX_ATTRIB_IMPL(ufbx_vec3)
 } ufbx_vertex_vec3;
@@ -1068,6 +1074,7 @@ typedef struct ufbx_vertex_vec4 {
 	size_t value_reals;
 	bool unique_per_vertex;
 	ufbx_real_list values_w;
+	ufbx_float_list values_float;
 
 	UFBX_VERTEX_ATTRIB_IMPL(ufbx_vec4)
 } ufbx_vertex_vec4;
@@ -1375,6 +1382,10 @@ struct ufbx_mesh {
 
 	// Tessellation (result)
 	bool from_tessellated_nurbs;
+
+	// Lazy geometry, see `ufbx_load_opts.lazy_geometry`
+	bool geometry_deferred;  // < Geometry has not been loaded, use `ufbx_load_mesh_geometry()`
+	bool from_lazy_geometry; // < (result) Returned by `ufbx_load_mesh_geometry()`
 };
 
 // The kind of light source
@@ -2110,6 +2121,12 @@ struct ufbx_blend_shape {
 	ufbx_vec3_list position_offsets;  // < Always specified per-vertex offsets
 	ufbx_vec3_list normal_offsets;    // < Empty if not specified
 
+	// Offsets converted to 32-bit floats, three floats per offset.
+	// NOTE: Only set with `ufbx_load_opts.float_geometry`, `position_offsets`
+	// and `normal_offsets` are empty in that case.
+	ufbx_float_list position_offsets_float;
+	ufbx_float_list normal_offsets_float;
+
 	// Optional weights for the offsets.
 	// NOTE: These are technically not supported in FBX and are only written by Blender.
 	ufbx_real_list offset_weights;
@@ -3750,6 +3767,59 @@ typedef struct ufbx_thumbnail {
 	ufbx_blob data;
 } ufbx_thumbnail;
 
+// Phases of loading a scene, see `ufbx_load_stats`.
+typedef enum ufbx_load_phase UFBX_ENUM_REPR {
+	UFBX_LOAD_PHASE_SETUP,           // < Validating options and detecting the file format.
+	UFBX_LOAD_PHASE_IO,              // < Reading input from user callbacks or waiting for `ufbx_load_feed()`.
+	UFBX_LOAD_PHASE_INFLATE,         // < Decompressing binary FBX arrays on the loading thread.
+	UFBX_LOAD_PHASE_PARSE,           // < Tokenizing and parsing the file into nodes.
+	UFBX_LOAD_PHASE_READ_OBJECTS,    // < Converting parsed nodes into elements.
+	UFBX_LOAD_PHASE_CONNECTIONS,     // < Reading and resolving connections between elements.
+	UFBX_LOAD_PHASE_FINALIZE,        // < Building the final scene structures.
+	UFBX_LOAD_PHASE_MODIFY_GEOMETRY, // < Axis, unit and geometry transform conversions.
+	UFBX_LOAD_PHASE_EXTERNAL_FILES,  // < Loading external files, see `ufbx_load_opts.load_external_files`.
+
+	UFBX_ENUM_FORCE_WIDTH(UFBX_LOAD_PHASE)
+} ufbx_load_phase;
+
+UFBX_ENUM_TYPE(ufbx_load_phase, UFBX_LOAD_PHASE, UFBX_LOAD_PHASE_EXTERNAL_FILES);
+
+typedef struct ufbx_load_phase_stats {
+	double wall_time; // < Wall clock time spent in the phase in seconds.
+	double cpu_time;  // < CPU time in seconds of the loading thread and thread pool tasks finished during the phase.
+	size_t count;     // < Number of times the phase was entered.
+} ufbx_load_phase_stats;
+
+// Where loading time and memory went, collected if `ufbx_load_opts.collect_load_stats` is set.
+// Phases are exclusive, eg. time spent in `UFBX_LOAD_PHASE_IO` while parsing is not
+// included in `UFBX_LOAD_PHASE_PARSE`. Allocation counts are in `ufbx_metadata`.
+typedef struct ufbx_load_stats {
+
+	// Statistics were collected, `has_time` is set if a clock was available,
+	// see `ufbx_load_opts.clock_cb`.
+	bool enabled;
+	bool has_time;
+
+	ufbx_load_phase_stats phases[UFBX_LOAD_PHASE_COUNT];
+	double total_wall_time;
+	double total_cpu_time;
+
+	// Bytes read from the input.
+	uint64_t bytes_read;
+
+	// Compressed binary FBX arrays, including ones decompressed on the thread pool.
+	size_t num_inflated_arrays;
+	uint64_t bytes_inflated_input;
+	uint64_t bytes_inflated_output;
+
+	// Number of tasks run on the thread pool, see `ufbx_load_opts.thread_opts`.
+	size_t num_thread_tasks;
+
+	// Peak amount of temporary memory allocated at once.
+	size_t peak_temp_memory_used;
+
+} ufbx_load_stats;
+
 // Miscellaneous data related to the loaded file
 typedef struct ufbx_metadata {
 
@@ -3809,6 +3879,7 @@ typedef struct ufbx_metadata {
 	bool geometry_ignored;
 	bool animation_ignored;
 	bool embedded_ignored;
+	bool geometry_deferred; // < Some meshes have `ufbx_mesh.geometry_deferred` set
 
 	size_t max_face_triangles;
 
@@ -3817,6 +3888,12 @@ typedef struct ufbx_metadata {
 	size_t result_allocs;
 	size_t temp_allocs;
 
+	// See `ufbx_load_opts.collect_load_stats`.
+	ufbx_load_stats load_stats;
+
+	// Restored from `ufbx_load_opts.cache_dir` instead of loading the file.
+	bool loaded_from_cache;
+
 	size_t element_buffer_size;
 	size_t num_shader_textures;
 
@@ -4073,6 +4150,65 @@ typedef struct ufbx_vertex_stream {
 	size_t vertex_size;  // < Size of a vertex in bytes.
 } ufbx_vertex_stream;
 
+// -- Vertex packing
+
+// Storage format of an attribute in `ufbx_packed_mesh.vertex_data`.
+typedef enum ufbx_packed_format UFBX_ENUM_REPR {
+	UFBX_PACKED_FORMAT_NONE,          // < Attribute is not present
+	UFBX_PACKED_FORMAT_UNORM16X4,     // < `uint16_t[4]` normalized to `[0, 1]`
+	UFBX_PACKED_FORMAT_SNORM16X2_OCT, // < `int16_t[2]` octahedral encoded unit vector
+	UFBX_PACKED_FORMAT_HALF2,         // < `uint16_t[2]` IEEE 754 half precision floats
+	UFBX_PACKED_FORMAT_UNORM8X4,      // < `uint8_t[4]` normalized to `[0, 1]`
+	UFBX_PACKED_FORMAT_UINT8X4,       // < `uint8_t[4]` integers
+	UFBX_PACKED_FORMAT_UINT16X4,      // < `uint16_t[4]` integers
+
+	UFBX_ENUM_FORCE_WIDTH(UFBX_PACKED_FORMAT)
+} ufbx_packed_format;
+
+UFBX_ENUM_TYPE(ufbx_packed_format, UFBX_PACKED_FORMAT, UFBX_PACKED_FORMAT_UINT16X4);
+
+// Location of a single attribute within a packed vertex.
+typedef struct ufbx_packed_attrib {
+	ufbx_packed_format format; // < `UFBX_PACKED_FORMAT_NONE` if the attribute is not present
+	uint32_t offset;           // < Byte offset from the start of the vertex
+} ufbx_packed_attrib;
+
+// Triangulated mesh with quantized interleaved vertices.
+// See `ufbx_pack_mesh()`.
+typedef struct ufbx_packed_mesh {
+
+	// Interleaved vertex data of `num_vertices * vertex_stride` bytes.
+	ufbx_blob vertex_data;
+	size_t num_vertices;
+	size_t vertex_stride;
+
+	// Triangle list indices to the packed vertices.
+	ufbx_uint32_list indices;
+
+	// Quantized position relative to the bounding box of the mesh, dequantize with
+	// `position_offset + xyz * position_scale` where `xyz` is the unnormalized integer value.
+	// The `w` component stores the handedness of the tangent frame as `0` for `-1.0`
+	// and `65535` for `+1.0`, so the bitangent is `cross(normal, tangent) * (w * 2.0 - 1.0)`
+	// using normalized values.
+	ufbx_packed_attrib position; // < `UFBX_PACKED_FORMAT_UNORM16X4`
+	ufbx_packed_attrib normal;   // < `UFBX_PACKED_FORMAT_SNORM16X2_OCT`
+	ufbx_packed_attrib tangent;  // < `UFBX_PACKED_FORMAT_SNORM16X2_OCT`
+	ufbx_packed_attrib uv;       // < `UFBX_PACKED_FORMAT_HALF2`
+	ufbx_packed_attrib color;    // < `UFBX_PACKED_FORMAT_UNORM8X4`, clamped to `[0, 1]`
+
+	// Skinning influences, up to four per vertex sorted by decreasing weight.
+	// Joint indices refer to `ufbx_skin_deformer.clusters[]` and the weights sum to `255`,
+	// except for vertices with no (positive) influences which have all weights `0`.
+	// Like `ufbx_get_skin_vertex_matrix()` those should use the transform of the mesh itself.
+	ufbx_packed_attrib joints;   // < `UFBX_PACKED_FORMAT_UINT8X4` or `UFBX_PACKED_FORMAT_UINT16X4`
+	ufbx_packed_attrib weights;  // < `UFBX_PACKED_FORMAT_UNORM8X4`
+
+	// Dequantization parameters for `position`.
+	ufbx_vec3 position_offset;
+	ufbx_vec3 position_scale;
+
+} ufbx_packed_mesh;
+
 // -- Memory callbacks
 
 // You can optionally provide an allocator to ufbx, the default is to use the
@@ -4340,10 +4476,15 @@ typedef enum ufbx_error_type UFBX_ENUM_REPR {
 	// ufbx still tries to load files with unsupported versions, see `UFBX_WARNING_UNSUPPORTED_VERSION`.
 	UFBX_ERROR_UNSUPPORTED_VERSION,
 
+	// Scene snapshot was written by a different ufbx version, build configuration,
+	// or with different load options, see `ufbx_load_scene_snapshot()`.
+	// The snapshot should be discarded and the original file reloaded.
+	UFBX_ERROR_SNAPSHOT_MISMATCH,
+
 	UFBX_ENUM_FORCE_WIDTH(UFBX_ERROR_TYPE)
 } ufbx_error_type;
 
-UFBX_ENUM_TYPE(ufbx_error_type, UFBX_ERROR_TYPE, UFBX_ERROR_UNSUPPORTED_VERSION);
+UFBX_ENUM_TYPE(ufbx_error_type, UFBX_ERROR_TYPE, UFBX_ERROR_SNAPSHOT_MISMATCH);
 
 // Error description with detailed stack trace
 // HINT: You can use `ufbx_format_error()` for formatting the error
@@ -4401,6 +4542,82 @@ typedef struct ufbx_progress_cb {
 		(progress))
 } ufbx_progress_cb;
 
+// -- Element filter callbacks
+
+// Information about an FBX object passed to `ufbx_element_filter_fn()`.
+// NOTE: The strings are only valid during the callback.
+typedef struct ufbx_element_filter_info {
+	ufbx_string name;         // < Name of the object eg. "Cube"
+	ufbx_string fbx_type;     // < FBX object type eg. "Model", "Geometry", "Deformer"
+	ufbx_string fbx_sub_type; // < FBX object sub-type eg. "Mesh", "Skin", "Cluster"
+	uint64_t fbx_id;          // < FBX object ID, zero in pre-7000 files
+} ufbx_element_filter_info;
+
+// Filter result returned from `ufbx_element_filter_fn()` callback.
+// Determines how much of an object is loaded.
+typedef enum ufbx_element_filter_result UFBX_ENUM_REPR {
+
+	// Load the object normally.
+	UFBX_ELEMENT_FILTER_LOAD,
+
+	// Create the element but skip its geometry, animation and embedded data
+	// as if `ufbx_load_opts.ignore_all_content` was set for this object.
+	UFBX_ELEMENT_FILTER_STUB,
+
+	// Skip the object completely, it will not be present in the scene.
+	UFBX_ELEMENT_FILTER_SKIP,
+
+	UFBX_ENUM_FORCE_WIDTH(UFBX_ELEMENT_FILTER_RESULT)
+} ufbx_element_filter_result;
+
+UFBX_ENUM_TYPE(ufbx_element_filter_result, UFBX_ELEMENT_FILTER_RESULT, UFBX_ELEMENT_FILTER_SKIP);
+
+// Called for each object in the file before its contents are parsed.
+// Binary array data of stubbed or skipped objects is skipped without decompressing.
+typedef ufbx_element_filter_result ufbx_element_filter_fn(void *user, const ufbx_element_filter_info *info);
+
+typedef struct ufbx_element_filter_cb {
+	ufbx_element_filter_fn *fn;
+	void *user;
+
+	UFBX_CALLBACK_IMPL(ufbx_element_filter_cb, ufbx_element_filter_fn, ufbx_element_filter_result,
+		(void *user, const ufbx_element_filter_info *info),
+		(info))
+} ufbx_element_filter_cb;
+
+// -- Mesh streaming
+
+// Called for each mesh at the end of loading with its geometry loaded, see `ufbx_load_opts.mesh_stream_cb`.
+// The mesh is freed after the callback returns, use `ufbx_retain_mesh()` to keep it around.
+// Return `false` to cancel loading.
+typedef bool ufbx_mesh_stream_fn(void *user, ufbx_mesh *mesh);
+
+typedef struct ufbx_mesh_stream_cb {
+	ufbx_mesh_stream_fn *fn;
+	void *user;
+
+	UFBX_CALLBACK_IMPL(ufbx_mesh_stream_cb, ufbx_mesh_stream_fn, bool,
+		(void *user, ufbx_mesh *mesh),
+		(mesh))
+} ufbx_mesh_stream_cb;
+
+// -- Clock
+
+// Return the current time in seconds, see `ufbx_load_opts.collect_load_stats`.
+// Should be monotonic wall clock time, or CPU time used by the calling thread if `cpu_time` is set.
+// Called from thread pool threads to time tasks, see `ufbx_load_opts.thread_opts`.
+// NOTE: Thread pool tasks are only timed if ufbx is compiled with POSIX threads.
+typedef double ufbx_clock_fn(void *user, bool cpu_time);
+
+typedef struct ufbx_clock_cb {
+	ufbx_clock_fn *fn;
+	void *user;
+
+	UFBX_CALLBACK_IMPL(ufbx_clock_cb, ufbx_clock_fn, double,
+		(void *user, bool cpu_time),
+		(cpu_time))
+} ufbx_clock_cb;
+
 // -- Inflate
 
 typedef struct ufbx_inflate_input ufbx_inflate_input;
@@ -4615,6 +4832,7 @@ typedef uintptr_t ufbx_thread_pool_context;
 
 // Thread pool creation information from ufbx.
 typedef struct ufbx_thread_pool_info {
+	// Maximum number of tasks in flight at once, `ufbx_thread_opts.num_tasks`.
 	uint32_t max_concurrent_tasks;
 } ufbx_thread_pool_info;
 
@@ -4626,6 +4844,7 @@ typedef bool ufbx_thread_pool_init_fn(void *user, ufbx_thread_pool_context ctx,
 // You must call `ufbx_thread_pool_run_task()` with indices `[start_index, start_index + count)`.
 // The threads are launched in batches indicated by `group`, see `UFBX_THREAD_GROUP_COUNT` for more information.
 // Ideally, you should run all the task indices in parallel within each `ufbx_thread_pool_run_fn()` call.
+// NOTE: Task indices are 32-bit and may wrap around, use `start_index + i` with unsigned overflow.
 typedef void ufbx_thread_pool_run_fn(void *user, ufbx_thread_pool_context ctx, uint32_t group, uint32_t start_index, uint32_t count);
 
 // Wait for previous tasks spawned in `ufbx_thread_pool_run_fn()` to finish.
@@ -4663,9 +4882,20 @@ typedef struct ufbx_thread_opts {
 	ufbx_thread_pool pool;
 
 	// Maximum of tasks to have in-flight.
+	// The built-in thread pool (see `num_threads`) uses this as an initial size
+	// and grows it if necessary. User pools are passed this value unchanged in
+	// `ufbx_thread_pool_info.max_concurrent_tasks`, if the limit is reached the
+	// remaining work is done serially on the calling thread.
 	// Default: 2048
 	size_t num_tasks;
 
+	// Number of worker threads to use for the built-in thread pool if `pool` is not
+	// specified. Use `SIZE_MAX` to use all available cores.
+	// The built-in thread pool is available if ufbx is compiled with POSIX threads,
+	// see `UFBX_USE_PTHREADS` and `UFBX_NO_PTHREADS`, otherwise this is ignored.
+	// Default: 0 (no threads)
+	size_t num_threads;
+
 	// Maximum amount of memory to use for batched threaded processing.
 	// Default: 32MB
 	// NOTE: The actual used memory usage might be higher, if there are individual tasks
@@ -4700,6 +4930,12 @@ typedef struct ufbx_load_opts {
 	bool ignore_embedded;    // < Do not load embedded content
 	bool ignore_all_content; // < Do not load any content (geometry, animation, embedded)
 
+	// Defer loading mesh geometry until requested with `ufbx_load_mesh_geometry()`.
+	// Deferred meshes are loaded like with `ignore_geometry` and have `ufbx_mesh.geometry_deferred` set.
+	// NOTE: Only applies to FBX files loaded using `ufbx_load_memory()`, the memory must
+	// stay valid for as long as you want to load geometry from the scene.
+	bool lazy_geometry;
+
 	bool evaluate_skinning; // < Evaluate skinning (see ufbx_mesh.skinned_vertices)
 	bool evaluate_caches;   // < Evaluate vertex caches (see ufbx_mesh.skinned_vertices)
 
@@ -4749,6 +4985,16 @@ typedef struct ufbx_load_opts {
 	// break the API guarantees.
 	ufbx_unsafe bool allow_unsafe;
 
+	// Reference uncompressed binary arrays directly from the buffer passed to
+	// `ufbx_load_memory()` instead of copying them, if the data is already in the
+	// right type, alignment and endianness. Arrays that would be modified while
+	// loading (eg. by `UFBX_SPACE_CONVERSION_MODIFY_GEOMETRY`) are still copied.
+	// Requires `ufbx_load_opts.allow_unsafe`.
+	// UNSAFE: The buffer must stay valid and unmodified for the lifetime of the scene.
+	// Arrays borrowed from the buffer are not padded for `UFBX_NO_INDEX` access,
+	// unless using `UFBX_INDEX_ERROR_HANDLING_NO_INDEX` that disables borrowing them.
+	ufbx_unsafe bool borrow_input_arrays;
+
 	// Specify how to handle broken indices.
 	ufbx_index_error_handling index_error_handling;
 
@@ -4775,6 +5021,32 @@ typedef struct ufbx_load_opts {
 	// Ignore `open_file_cb` when loading the main file.
 	bool open_main_file_with_default;
 
+	// Memory-map the main file in `ufbx_load_file()` and parse it directly from
+	// the mapping instead of copying it through `read_buffer_size` sized chunks.
+	// Only used with the default `open_file_cb`, falls back to normal reads if
+	// mapping is not supported (see `UFBX_NO_MMAP` and `UFBX_STANDARD_C`) or fails.
+	// NOTE: The file must not be truncated while loading.
+	bool map_main_file;
+
+	// (optional) Directory to cache loaded scenes in for `ufbx_load_file()`.
+	// The main file is read to memory and hashed along with the options that affect
+	// the result. On a hit the scene is restored from a snapshot without parsing
+	// (see `ufbx_load_scene_snapshot()`), on a miss the loaded scene is written to
+	// the cache. Use `length = SIZE_MAX` for NULL-terminated strings.
+	// Entries are written to a temporary file and renamed in place, so the directory
+	// can be shared by multiple processes. Cache errors never fail the load.
+	// Ignored with `lazy_geometry`, `borrow_input_arrays`, `mesh_stream_cb` or
+	// `element_filter_cb`, or if compiled with `UFBX_NO_STDIO`.
+	// NOTE: Only the contents and name of the main file are hashed, changes to
+	// external files (.mtl files, geometry caches) are not detected.
+	// NOTE: Snapshots are trusted, don't share the directory with untrusted writers.
+	ufbx_string cache_dir;
+
+	// Maximum total size of the entries in `cache_dir` in bytes, the least recently
+	// used entries are removed after writing a new one. Zero means unbounded.
+	// NOTE: Eviction is only supported on POSIX systems, see `UFBX_NO_DIRENT`.
+	uint64_t cache_max_size;
+
 	// Path separator character, defaults to '\' on Windows and '/' otherwise.
 	char path_separator;
 
@@ -4803,9 +5075,33 @@ typedef struct ufbx_load_opts {
 	ufbx_progress_cb progress_cb;
 	uint64_t progress_interval_hint; // < Bytes between progress report calls
 
+	// Collect per-phase timing and memory statistics to `ufbx_metadata.load_stats`.
+	// Adds a couple of clock reads every time loading switches between phases.
+	// Scenes restored from snapshots (or `cache_dir`) report reading the snapshot
+	// as `UFBX_LOAD_PHASE_IO`.
+	bool collect_load_stats;
+
+	// (optional) Clock for `collect_load_stats`, defaults to `clock_gettime()` where available.
+	ufbx_clock_cb clock_cb;
+
 	// External file callbacks (defaults to stdio.h)
 	ufbx_open_file_cb open_file_cb;
 
+	// (optional) Decide per object whether to load, stub or skip it.
+	// Elements referencing skipped objects see them as missing connections.
+	// NOTE: Only applies to FBX 6000 and later, called from the loading thread.
+	ufbx_element_filter_cb element_filter_cb;
+
+	// (optional) Receive meshes one at a time instead of keeping all geometry in the scene.
+	// Implies `lazy_geometry`: consecutive meshes are loaded from the input in batches of up
+	// to 16MB of input, so peak memory is bounded by the larger of that and the largest mesh
+	// instead of the whole file. Each batch re-parses the structure of the whole file, so files
+	// with many large meshes are parsed several times. Meshes in the returned scene have
+	// `ufbx_mesh.geometry_deferred` set, with `map_main_file` the mapping is released
+	// after loading so `ufbx_load_mesh_geometry()` returns them empty.
+	// NOTE: Geometry is loaded up front when reading from a file or stream.
+	ufbx_mesh_stream_cb mesh_stream_cb;
+
 	// How to handle geometry transforms in the nodes.
 	// See `ufbx_geometry_transform_handling` for an explanation.
 	ufbx_geometry_transform_handling geometry_transform_handling;
@@ -4882,6 +5178,19 @@ typedef struct ufbx_load_opts {
 	// See `ufbx_vertex_attrib.values_w`.
 	bool retain_vertex_attrib_w;
 
+	// Store vertex attribute values and blend shape offsets as 32-bit floats in
+	// `ufbx_vertex_attrib.values_float` and `ufbx_blend_shape.position/normal_offsets_float`
+	// instead of `ufbx_real`, roughly halving the memory used by geometry if `ufbx_real`
+	// is `double`. The `ufbx_real` lists are left empty, including `ufbx_mesh.vertices`.
+	// Transforms, animation and everything else still use `ufbx_real`.
+	// Skinning in `ufbx_evaluate_scene()` stores `ufbx_mesh.skinned_position/normal` as
+	// `values_float` too, and the blend shape offset helpers such as
+	// `ufbx_add_blend_shape_vertex_offsets()` read the `float` offsets.
+	// `ufbx_subdivide_mesh()` fails on meshes loaded with this option.
+	// HINT: Use `ufbx_get_vertex_vec3_float()` etc. to read the values.
+	// NOTE: Vertex creases are not converted.
+	bool float_geometry;
+
 	// Retain the raw document structure using `ufbx_dom_node`.
 	bool retain_dom;
 
@@ -4937,6 +5246,57 @@ typedef struct ufbx_load_opts {
 	uint32_t _end_zero;
 } ufbx_load_opts;
 
+// Animation stack summary returned by `ufbx_probe_file/memory/stream()`
+typedef struct ufbx_probe_anim_stack {
+	ufbx_string name;
+	double time_begin; // < Start time in seconds
+	double time_end;   // < End time in seconds
+} ufbx_probe_anim_stack;
+
+UFBX_LIST_TYPE(ufbx_probe_anim_stack_list, ufbx_probe_anim_stack);
+
+// Summary of an FBX file returned by `ufbx_probe_file/memory/stream()`.
+// Contains only information available from the object headers, no geometry,
+// animation or embedded data is decoded and no scene graph is built.
+typedef struct ufbx_probe_info {
+
+	// Header information, see `ufbx_metadata` for details.
+	ufbx_file_format file_format;
+	bool ascii;
+	bool big_endian;
+	uint32_t version;
+	ufbx_string creator;
+	ufbx_exporter exporter;
+	uint32_t exporter_version;
+	ufbx_application original_application;
+	ufbx_application latest_application;
+
+	// Object counts, `num_nodes` does not include the implicit root node.
+	size_t num_nodes;
+	size_t num_meshes;
+	size_t num_materials;
+	size_t num_textures;
+	size_t num_lights;
+	size_t num_cameras;
+	size_t num_skin_deformers;
+	size_t num_blend_deformers;
+	size_t num_objects; // < Total number of objects in the file
+
+	// Names of objects in file order.
+	ufbx_string_list node_names;
+	ufbx_string_list mesh_names;
+	ufbx_string_list material_names;
+
+	// Animation stacks (takes) with their time ranges.
+	ufbx_probe_anim_stack_list anim_stacks;
+
+	size_t result_memory_used;
+	size_t temp_memory_used;
+} ufbx_probe_info;
+
+// Opaque reader that caches decoded geometry cache frames, see `ufbx_create_cache_reader()`.
+typedef struct ufbx_cache_reader ufbx_cache_reader;
+
 // Options for `ufbx_evaluate_scene()`
 // NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
 typedef struct ufbx_evaluate_opts {
@@ -4958,6 +5318,9 @@ typedef struct ufbx_evaluate_opts {
 	// External file callbacks (defaults to stdio.h)
 	ufbx_open_file_cb open_file_cb;
 
+	// Read geometry cache frames through a reader, see `ufbx_geometry_cache_data_opts.reader`.
+	ufbx_cache_reader *cache_reader;
+
 	uint32_t _end_zero;
 } ufbx_evaluate_opts;
 
@@ -5193,6 +5556,32 @@ typedef struct ufbx_subdivide_opts {
 	uint32_t _end_zero;
 } ufbx_subdivide_opts;
 
+// Options for `ufbx_pack_mesh()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_pack_mesh_opts {
+	uint32_t _begin_zero;
+
+	ufbx_allocator_opts temp_allocator;   // < Allocator used during packing
+	ufbx_allocator_opts result_allocator; // < Allocator used for the final packed mesh
+
+	// Do not pack the corresponding attributes even if the mesh has them.
+	bool ignore_normals;
+	bool ignore_tangents;
+	bool ignore_uvs;
+	bool ignore_colors;
+	bool ignore_skinning;
+
+	// Skin deformer to use for `ufbx_packed_mesh.joints/weights`.
+	// Defaults to the first skin deformer of the mesh, if any.
+	ufbx_nullable ufbx_skin_deformer *skin_deformer;
+
+	// Always store joint indices as `UFBX_PACKED_FORMAT_UINT16X4`.
+	// By default 8-bit indices are used if the skin has at most 256 clusters.
+	bool wide_joint_indices;
+
+	uint32_t _end_zero;
+} ufbx_pack_mesh_opts;
+
 // Options for `ufbx_load_geometry_cache()`
 // NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
 typedef struct ufbx_geometry_cache_opts {
@@ -5234,9 +5623,94 @@ typedef struct ufbx_geometry_cache_data_opts {
 	// Ignore scene transform.
 	bool ignore_transform;
 
+	// Optional reader that keeps files open and caches decoded frames between calls.
+	// `open_file_cb` is ignored if set, the reader uses `ufbx_cache_reader_opts.open_file_cb`.
+	ufbx_cache_reader *reader;
+
 	uint32_t _end_zero;
 } ufbx_geometry_cache_data_opts;
 
+// Options for `ufbx_create_cache_reader()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_cache_reader_opts {
+	uint32_t _begin_zero;
+
+	ufbx_allocator_opts allocator; // < Allocator used for the reader and decoded frames
+
+	// External file callbacks (defaults to stdio.h)
+	// With the default callbacks files are memory mapped where supported.
+	ufbx_open_file_cb open_file_cb;
+
+	// Maximum number of decoded frames to keep around (default 16).
+	size_t max_frames;
+
+	// Maximum number of files to keep open (default 64).
+	size_t max_files;
+
+	// Number of frames to decode ahead on a background thread when sampling
+	// forward in time (default 2). Only used with memory mapped files.
+	size_t prefetch_frames;
+
+	// Never start a background thread for prefetching.
+	bool no_prefetch;
+
+	uint32_t _end_zero;
+} ufbx_cache_reader_opts;
+
+// Called by `ufbx_load_files()` for each file after it has been loaded.
+// `index` is the index of the file in `filenames`. `scene` is `NULL` if the load failed,
+// in which case `error` describes the failure. The callback owns `scene` and must free
+// it with `ufbx_free_scene()` once done with it.
+// NOTE: Called from the loading threads but never concurrently.
+typedef void ufbx_load_files_fn(void *user, size_t index, ufbx_scene *scene, const ufbx_error *error);
+
+typedef struct ufbx_load_files_cb {
+	ufbx_load_files_fn *fn;
+	void *user;
+
+	UFBX_CALLBACK_IMPL(ufbx_load_files_cb, ufbx_load_files_fn, void,
+		(void *user, size_t index, ufbx_scene *scene, const ufbx_error *error),
+		(index, scene, error))
+} ufbx_load_files_cb;
+
+// Options for `ufbx_load_files()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_load_files_opts {
+	uint32_t _begin_zero;
+
+	// Options used to load each file.
+	// `load_opts.thread_opts` is ignored, the files share the threads below.
+	ufbx_load_opts load_opts;
+
+	// Receives the loaded scenes, see `ufbx_load_files_fn`.
+	// If not set the scenes are freed right away, eg. for validating files.
+	ufbx_load_files_cb result_cb;
+
+	// Number of worker threads in addition to the calling thread.
+	// Use `SIZE_MAX` to use all available cores. The threads are shared between loading
+	// files and the parallel tasks within each load.
+	// Requires ufbx to be compiled with POSIX threads, see `UFBX_USE_PTHREADS`,
+	// otherwise the files are loaded one by one on the calling thread.
+	// Default: 0 (load on the calling thread only)
+	size_t num_threads;
+
+	// Maximum number of files to load at the same time.
+	// Default: `num_threads + 1`
+	size_t max_concurrent_files;
+
+	// Memory limit shared by all the loads in progress, in addition to the limits in
+	// `load_opts`. Scenes passed to `result_cb` no longer count towards the limit.
+	// Files that run out of memory while other files are loading are retried alone.
+	// Default: 0 (no limit)
+	size_t memory_limit;
+
+	// Don't share the built-in property and type names between the loads.
+	// By default they are interned once to an immutable table instead of per file.
+	bool no_shared_strings;
+
+	uint32_t _end_zero;
+} ufbx_load_files_opts;
+
 typedef struct ufbx_panic {
 	bool did_panic;
 	size_t message_length;
@@ -5284,6 +5758,7 @@ ufbx_abi_data const uint32_t ufbx_source_version;
 //   ufbx_free_scene()
 //   ufbx_subdivide_mesh()
 //   ufbx_tessellate_nurbs_surface()
+//   ufbx_load_mesh_geometry()
 //   ufbx_free_mesh()
 ufbx_abi bool ufbx_is_thread_safe(void);
 
@@ -5324,12 +5799,109 @@ ufbx_abi ufbx_scene *ufbx_load_stream_prefix(
 	const void *prefix, size_t prefix_size,
 	const ufbx_load_opts *opts, ufbx_error *error);
 
+// Load `num_files` files concurrently, see `ufbx_load_files_opts`.
+// Each scene or load error is passed to `ufbx_load_files_opts.result_cb`.
+// Returns the number of files that were loaded successfully. `error` is only set if the
+// batch itself could not be started, in which case `result_cb` is never called.
+// NOTE: Files are loaded from the largest to the smallest if the sizes are available.
+ufbx_abi size_t ufbx_load_files(
+	const char *const *filenames, size_t num_files,
+	const ufbx_load_files_opts *opts, ufbx_error *error);
+
+// Opaque state for loading incrementally as data arrives, see `ufbx_load_begin()`.
+typedef struct ufbx_loader ufbx_loader;
+
+// Load a scene from data that is pushed piece by piece, eg. from a network download.
+// Feed data in order with `ufbx_load_feed()` and call `ufbx_load_finish()` after the last
+// piece. Binary FBX files are parsed as complete top-level nodes and objects arrive so
+// decompression and parsing overlap with the download, other formats are buffered.
+// Object and scene processing happens in `ufbx_load_finish()`.
+// Fed data is copied so the buffers can be reused after `ufbx_load_feed()` returns.
+// NOTE: Strings in `opts` must stay valid until `ufbx_load_finish()`.
+ufbx_abi ufbx_loader *ufbx_load_begin(const ufbx_load_opts *opts, ufbx_error *error);
+
+// Append `data_size` bytes to the loaded file, returns `false` if parsing fails.
+// After a failure `ufbx_load_finish()` returns the same error.
+ufbx_abi bool ufbx_load_feed(ufbx_loader *loader, const void *data, size_t data_size, ufbx_error *error);
+
+// Finish loading the file from all the data fed so far, always frees `loader`.
+ufbx_abi ufbx_scene *ufbx_load_finish(ufbx_loader *loader, ufbx_error *error);
+
+// Abort loading and free `loader`, not needed after `ufbx_load_finish()`.
+ufbx_abi void ufbx_free_loader(ufbx_loader *loader);
+
 // Free a previously loaded or evaluated scene
 ufbx_abi void ufbx_free_scene(ufbx_scene *scene);
 
 // Increment `scene` refcount
 ufbx_abi void ufbx_retain_scene(ufbx_scene *scene);
 
+// Scene snapshots: the memory of a loaded scene written out with a pointer relocation
+// table, restored by `ufbx_load_scene_snapshot()` with a single read and pointer fixups
+// without any parsing, decompression or scene processing.
+// Snapshots are specific to the ufbx version and build configuration (pointer size,
+// `ufbx_real` type, endianness) and to the load options, see `ufbx_load_scene_snapshot()`.
+// Saving fails if the scene references memory outside of itself, eg. when loaded with
+// `ufbx_load_opts.lazy_geometry` or `ufbx_load_opts.borrow_input_arrays`.
+// Memory usage and `ufbx_metadata.load_stats` are not saved, a restored scene reports
+// the cost of reading the snapshot instead, so saving it again results in identical bytes.
+
+// Save a snapshot of `scene` to a file named `filename`.
+// NOTE: Requires stdio, fails with `UFBX_ERROR_FEATURE_DISABLED` if compiled with `UFBX_NO_STDIO`.
+ufbx_abi bool ufbx_save_scene_snapshot(
+	const ufbx_scene *scene, const char *filename,
+	ufbx_error *error);
+ufbx_abi bool ufbx_save_scene_snapshot_len(
+	const ufbx_scene *scene, const char *filename, size_t filename_len,
+	ufbx_error *error);
+
+// Save a snapshot of `scene` to `void dst[dst_size]`.
+// Returns the size of the snapshot, it is written only if `dst_size` is large enough,
+// so you can query the size by passing `dst == NULL`. Returns zero on failure.
+ufbx_abi size_t ufbx_save_scene_snapshot_to_memory(
+	const ufbx_scene *scene, void *dst, size_t dst_size,
+	ufbx_error *error);
+
+// Load a scene from a snapshot written by `ufbx_save_scene_snapshot()`.
+// `opts` should be the same options that would be used to load the original file,
+// options that affect the resulting scene are compared to the ones the snapshot was
+// saved with and the load fails with `UFBX_ERROR_SNAPSHOT_MISMATCH` if they differ.
+// Callbacks in `opts` can't be compared, `element_filter_cb` is only checked for presence.
+// Only `result_allocator`, `temp_allocator` and `open_file_cb` are used for loading.
+// NOTE: The snapshot is not validated beyond its header and pointers, only load
+// snapshots written by a trusted source. Detecting changes to the original file is
+// up to the caller.
+ufbx_abi ufbx_scene *ufbx_load_scene_snapshot(
+	const char *filename,
+	const ufbx_load_opts *opts, ufbx_error *error);
+ufbx_abi ufbx_scene *ufbx_load_scene_snapshot_len(
+	const char *filename, size_t filename_len,
+	const ufbx_load_opts *opts, ufbx_error *error);
+ufbx_abi ufbx_scene *ufbx_load_scene_snapshot_memory(
+	const void *data, size_t data_size,
+	const ufbx_load_opts *opts, ufbx_error *error);
+
+// Read a summary of an FBX file without loading the scene.
+// Only the headers and object definitions are parsed, array payloads are skipped
+// without decompressing them. Useful for indexing large amounts of files.
+// Respects `opts` allocators and IO callbacks, content loading options are ignored.
+// NOTE: Only FBX files are supported.
+ufbx_abi ufbx_probe_info *ufbx_probe_memory(
+	const void *data, size_t data_size,
+	const ufbx_load_opts *opts, ufbx_error *error);
+ufbx_abi ufbx_probe_info *ufbx_probe_file(
+	const char *filename,
+	const ufbx_load_opts *opts, ufbx_error *error);
+ufbx_abi ufbx_probe_info *ufbx_probe_file_len(
+	const char *filename, size_t filename_len,
+	const ufbx_load_opts *opts, ufbx_error *error);
+ufbx_abi ufbx_probe_info *ufbx_probe_stream(
+	const ufbx_stream *stream,
+	const ufbx_load_opts *opts, ufbx_error *error);
+
+// Free a summary returned by `ufbx_probe_file/memory/stream()`
+ufbx_abi void ufbx_free_probe_info(ufbx_probe_info *info);
+
 // Format a textual description of `error`.
 // Always produces a NULL-terminated string to `char dst[dst_size]`, truncating if
 // necessary. Returns the number of characters written not including the NULL terminator.
@@ -5697,12 +6269,37 @@ ufbx_abi void ufbx_compute_normals(const ufbx_mesh *mesh, const ufbx_vertex_vec3
 // Subdivide a mesh using the Catmull-Clark subdivision `level` times.
 ufbx_abi ufbx_mesh *ufbx_subdivide_mesh(const ufbx_mesh *mesh, size_t level, const ufbx_subdivide_opts *opts, ufbx_error *error);
 
-// Free a mesh returned from `ufbx_subdivide_mesh()` or `ufbx_tessellate_nurbs_surface()`.
+// Load the geometry of a mesh deferred by `ufbx_load_opts.lazy_geometry`.
+// Reloads the scene from the memory passed to `ufbx_load_memory()` skipping the geometry
+// and animation of everything else. Every call re-parses the whole file (the contents of
+// skipped objects are still tokenized in ASCII files), so loading each mesh of a scene this
+// way costs O(meshes * file size), prefer `ufbx_load_opts.mesh_stream_cb` for that.
+// The returned mesh belongs to the reloaded scene, elements it refers to (eg. `instances`,
+// `materials`) have the same `element_id` as in the original scene.
+// Meshes that are not deferred are returned as a copy that keeps their scene alive.
+// Free the result with `ufbx_free_mesh()`.
+ufbx_abi ufbx_mesh *ufbx_load_mesh_geometry(const ufbx_mesh *mesh, ufbx_error *error);
+
+// Free a mesh returned from `ufbx_subdivide_mesh()`, `ufbx_tessellate_nurbs_surface()`
+// or `ufbx_load_mesh_geometry()`.
 ufbx_abi void ufbx_free_mesh(ufbx_mesh *mesh);
 
 // Increase the mesh reference count.
 ufbx_abi void ufbx_retain_mesh(ufbx_mesh *mesh);
 
+// Vertex packing
+
+// Triangulate and quantize `mesh` into an interleaved vertex buffer and an index buffer.
+// Packs only the faces of `part` if not `NULL`, eg. one of `ufbx_mesh.material_parts[]`.
+// Identical packed vertices are merged using `ufbx_generate_indices()`.
+ufbx_abi ufbx_packed_mesh *ufbx_pack_mesh(const ufbx_mesh *mesh, ufbx_nullable const ufbx_mesh_part *part, const ufbx_pack_mesh_opts *opts, ufbx_error *error);
+
+// Free a packed mesh returned from `ufbx_pack_mesh()`.
+ufbx_abi void ufbx_free_packed_mesh(ufbx_packed_mesh *packed);
+
+// Increase the packed mesh reference count.
+ufbx_abi void ufbx_retain_packed_mesh(ufbx_packed_mesh *packed);
+
 // Geometry caches
 
 // Load geometry cache information from a file.
@@ -5727,6 +6324,17 @@ ufbx_abi size_t ufbx_read_geometry_cache_vec3(const ufbx_cache_frame *frame, ufb
 ufbx_abi size_t ufbx_sample_geometry_cache_real(const ufbx_cache_channel *channel, double time, ufbx_real *data, size_t num_data, const ufbx_geometry_cache_data_opts *opts);
 ufbx_abi size_t ufbx_sample_geometry_cache_vec3(const ufbx_cache_channel *channel, double time, ufbx_vec3 *data, size_t num_data, const ufbx_geometry_cache_data_opts *opts);
 
+// Create a reader for repeatedly reading or sampling geometry caches, pass it in
+// `ufbx_geometry_cache_data_opts.reader` or `ufbx_evaluate_opts.cache_reader`.
+// The reader keeps recently used files memory mapped where supported and decoded frames
+// in a LRU cache, forward sampling prefetches upcoming frames in the background.
+// NOTE: A reader may only be used from one thread at a time and assumes that the
+// cache files do not change while it's alive.
+ufbx_abi ufbx_cache_reader *ufbx_create_cache_reader(const ufbx_cache_reader_opts *opts, ufbx_error *error);
+
+// Free a reader returned from `ufbx_create_cache_reader()`, cancels pending prefetches.
+ufbx_abi void ufbx_free_cache_reader(ufbx_cache_reader *reader);
+
 // DOM
 
 // Find a DOM node given a name.
@@ -5768,6 +6376,15 @@ ufbx_inline ufbx_vec4 ufbx_get_vertex_vec4(const ufbx_vertex_vec4 *v, size_t ind
 ufbx_abi ufbx_real ufbx_catch_get_vertex_w_vec3(ufbx_panic *panic, const ufbx_vertex_vec3 *v, size_t index);
 ufbx_inline ufbx_real ufbx_get_vertex_w_vec3(const ufbx_vertex_vec3 *v, size_t index) { ufbx_assert(index < v->indices.count); return v->values_w.count > 0 ? v->values_w.data[(int32_t)v->indices.data[index]] : 0.0f; }
 
+// Utility functions for reading geometry data loaded with `ufbx_load_opts.float_geometry`.
+// Returns a pointer to the 2, 3 or 4 floats of the value at `index`.
+ufbx_abi const float *ufbx_catch_get_vertex_vec2_float(ufbx_panic *panic, const ufbx_vertex_vec2 *v, size_t index);
+ufbx_abi const float *ufbx_catch_get_vertex_vec3_float(ufbx_panic *panic, const ufbx_vertex_vec3 *v, size_t index);
+ufbx_abi const float *ufbx_catch_get_vertex_vec4_float(ufbx_panic *panic, const ufbx_vertex_vec4 *v, size_t index);
+ufbx_inline const float *ufbx_get_vertex_vec2_float(const ufbx_vertex_vec2 *v, size_t index) { ufbx_assert(index < v->indices.count); return v->values_float.data + (ptrdiff_t)(int32_t)v->indices.data[index] * 2; }
+ufbx_inline const float *ufbx_get_vertex_vec3_float(const ufbx_vertex_vec3 *v, size_t index) { ufbx_assert(index < v->indices.count); return v->values_float.data + (ptrdiff_t)(int32_t)v->indices.data[index] * 3; }
+ufbx_inline const float *ufbx_get_vertex_vec4_float(const ufbx_vertex_vec4 *v, size_t index) { ufbx_assert(index < v->indices.count); return v->values_float.data + (ptrdiff_t)(int32_t)v->indices.data[index] * 4; }
+
 // Functions for converting an untyped `ufbx_element` to a concrete type.
 // Returns `NULL` if the element is not that type.
 ufbx_abi ufbx_unknown *ufbx_as_unknown(const ufbx_element *element);
@@ -5905,6 +6522,12 @@ template<> struct ufbx_type_traits<ufbx_baked_anim> {
 	static void free(ufbx_baked_anim *ptr) { ufbx_free_baked_anim(ptr); }
 };
 
+template<> struct ufbx_type_traits<ufbx_packed_mesh> {
+	enum { valid = 1 };
+	static void retain(ufbx_packed_mesh *ptr) { ufbx_retain_packed_mesh(ptr); }
+	static void free(ufbx_packed_mesh *ptr) { ufbx_free_packed_mesh(ptr); }
+};
+
 class ufbx_deleter {
 public:
 	template <typename T>